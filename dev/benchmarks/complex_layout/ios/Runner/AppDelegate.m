@@ -0,0 +1,22 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "AppDelegate.h"
+
+#import "FramePacingRecorder.h"
+
+@implementation AppDelegate {
+  FramePacingRecorder* _framePacingRecorder;
+}
+
+- (BOOL)application:(UIApplication*)application
+    didFinishLaunchingWithOptions:(NSDictionary*)launchOptions {
+  FlutterViewController* flutterViewController =
+      (FlutterViewController*)self.window.rootViewController;
+  _framePacingRecorder =
+      [[FramePacingRecorder alloc] initWithMessenger:flutterViewController];
+  return [super application:application didFinishLaunchingWithOptions:launchOptions];
+}
+
+@end
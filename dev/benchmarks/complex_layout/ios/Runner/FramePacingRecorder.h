@@ -0,0 +1,30 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <Flutter/Flutter.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Records the display's vsync timestamps with a CADisplayLink, so that the
+// engine's frame timings can be matched to the vsync each frame was shown at.
+//
+// The timestamps are in microseconds of CACurrentMediaTime, which is the same
+// mach_absolute_time based clock as the engine's FrameTiming timestamps.
+//
+// The recorder answers these calls on the "complex_layout/frame_pacing"
+// method channel:
+//
+//  * "start" clears any previous recording and starts recording.
+//  * "stop" stops recording and returns a map with "vsyncTimestampsMicros",
+//    the list of recorded vsync timestamps, and "refreshIntervalMicros", the
+//    display's nominal refresh interval.
+@interface FramePacingRecorder : NSObject
+
+- (instancetype)initWithMessenger:(NSObject<FlutterBinaryMessenger>*)messenger
+    NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,73 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "FramePacingRecorder.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+static NSString* const kChannelName = @"complex_layout/frame_pacing";
+
+@implementation FramePacingRecorder {
+  FlutterMethodChannel* _channel;
+  CADisplayLink* _displayLink;
+  NSMutableArray<NSNumber*>* _vsyncTimestamps;
+}
+
+- (instancetype)initWithMessenger:(NSObject<FlutterBinaryMessenger>*)messenger {
+  self = [super init];
+  if (self) {
+    _vsyncTimestamps = [NSMutableArray array];
+    _channel = [FlutterMethodChannel methodChannelWithName:kChannelName
+                                           binaryMessenger:messenger];
+    __weak FramePacingRecorder* weakSelf = self;
+    [_channel setMethodCallHandler:^(FlutterMethodCall* call, FlutterResult result) {
+      [weakSelf handleMethodCall:call result:result];
+    }];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [_displayLink invalidate];
+}
+
+- (void)handleMethodCall:(FlutterMethodCall*)call result:(FlutterResult)result {
+  if ([call.method isEqualToString:@"start"]) {
+    [self start];
+    result(nil);
+  } else if ([call.method isEqualToString:@"stop"]) {
+    result([self stop]);
+  } else {
+    result(FlutterMethodNotImplemented);
+  }
+}
+
+- (void)start {
+  [_displayLink invalidate];
+  [_vsyncTimestamps removeAllObjects];
+  // The display link only observes vsync; it doesn't drive any drawing.
+  _displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(onVsync:)];
+  [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+}
+
+- (NSDictionary*)stop {
+  [_displayLink invalidate];
+  _displayLink = nil;
+  NSInteger maximumFramesPerSecond = 60;
+  if (@available(iOS 10.3, *)) {
+    maximumFramesPerSecond = [UIScreen mainScreen].maximumFramesPerSecond;
+  }
+  return @{
+    @"vsyncTimestampsMicros" : [_vsyncTimestamps copy],
+    @"refreshIntervalMicros" : @(1000000 / MAX(maximumFramesPerSecond, 1)),
+  };
+}
+
+- (void)onVsync:(CADisplayLink*)displayLink {
+  // |timestamp| is the time of the vsync that fired the callback, which is
+  // unaffected by how late the main thread got to it.
+  [_vsyncTimestamps addObject:@((int64_t)(displayLink.timestamp * 1e6))];
+}
+
+@end
@@ -5,9 +5,11 @@
 #import <UIKit/UIKit.h>
 #import <Flutter/Flutter.h>
 
+#import "AppDelegate.h"
+
 int main(int argc, char * argv[]) {
     @autoreleasepool {
         return UIApplicationMain(argc, argv, nil,
-                                 NSStringFromClass([FlutterAppDelegate class]));
+                                 NSStringFromClass([AppDelegate class]));
     }
 }
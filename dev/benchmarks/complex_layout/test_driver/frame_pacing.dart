@@ -0,0 +1,153 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:async';
+import 'dart:convert' show json;
+import 'dart:math' as math;
+import 'dart:ui' show FramePhase, FrameTiming;
+
+import 'package:flutter/scheduler.dart';
+import 'package:flutter/services.dart';
+import 'package:flutter_driver/driver_extension.dart';
+import 'package:complex_layout/main.dart' as app;
+
+/// Connects to the vsync recorder in the iOS host, see
+/// `ios/Runner/FramePacingRecorder.m`.
+const MethodChannel _framePacing = MethodChannel('complex_layout/frame_pacing');
+
+/// Intervals between presented frames of more than this many vsyncs are taken
+/// to be periods where nothing was animating, rather than missed frames.
+const int _idleVsyncs = 6;
+
+final List<FrameTiming> _timings = <FrameTiming>[];
+
+void _addTimings(List<FrameTiming> timings) {
+  _timings.addAll(timings);
+}
+
+Future<String> _handleMessage(String message) async {
+  switch (message) {
+    case 'startFramePacing':
+      _timings.clear();
+      SchedulerBinding.instance.addTimingsCallback(_addTimings);
+      await _framePacing.invokeMethod<void>('start');
+      return '';
+    case 'stopFramePacing':
+      final Map<String, dynamic> vsyncs =
+          await _framePacing.invokeMapMethod<String, dynamic>('stop');
+      // Frame timings are reported in batches, so wait for the last ones.
+      await Future<void>.delayed(const Duration(seconds: 1));
+      SchedulerBinding.instance.removeTimingsCallback(_addTimings);
+      return json.encode(summarizeFramePacing(
+        _timings,
+        (vsyncs['vsyncTimestampsMicros'] as List<dynamic>).cast<int>(),
+        vsyncs['refreshIntervalMicros'] as int,
+      ));
+  }
+  throw ArgumentError('Unknown message: $message');
+}
+
+void main() {
+  enableFlutterDriverExtension(handler: _handleMessage);
+  app.main();
+}
+
+/// Summarizes how evenly frames were presented.
+///
+/// Each frame is taken to be presented at the first vsync in
+/// [vsyncTimestampsMicros] after its rasterization finished. The gaps between
+/// presented frames, measured in vsyncs, show pacing problems that average
+/// frame times hide: a frame that takes two vsyncs followed by one that takes
+/// none averages out, but is seen as a stutter.
+Map<String, dynamic> summarizeFramePacing(
+  List<FrameTiming> timings,
+  List<int> vsyncTimestampsMicros,
+  int refreshIntervalMicros,
+) {
+  final List<int> presents = <int>[];
+  for (final FrameTiming timing in timings) {
+    final int present = _firstAtOrAfter(
+      vsyncTimestampsMicros,
+      timing.timestampInMicroseconds(FramePhase.rasterFinish),
+    );
+    if (present != null && (presents.isEmpty || presents.last != present))
+      presents.add(present);
+  }
+  presents.sort();
+
+  final List<double> intervalsMillis = <double>[];
+  int missedVsyncs = 0;
+  int pacedIntervals = 0;
+  for (int i = 1; i < presents.length; i += 1) {
+    final int interval = presents[i] - presents[i - 1];
+    final int vsyncs = math.max(1, (interval / refreshIntervalMicros).round());
+    if (vsyncs > _idleVsyncs)
+      continue;
+    intervalsMillis.add(interval / 1000.0);
+    missedVsyncs += vsyncs - 1;
+    if (vsyncs == 1)
+      pacedIntervals += 1;
+  }
+
+  final List<double> vsyncIntervalsMillis = <double>[];
+  for (int i = 1; i < vsyncTimestampsMicros.length; i += 1) {
+    final int interval = vsyncTimestampsMicros[i] - vsyncTimestampsMicros[i - 1];
+    if (interval <= refreshIntervalMicros * _idleVsyncs)
+      vsyncIntervalsMillis.add(interval / 1000.0);
+  }
+
+  final double averageInterval = _average(intervalsMillis);
+  return <String, dynamic>{
+    'frame_count': timings.length,
+    'vsync_count': vsyncTimestampsMicros.length,
+    'refresh_interval_millis': refreshIntervalMicros / 1000.0,
+    'average_present_interval_millis': averageInterval,
+    'present_interval_stddev_millis': _standardDeviation(intervalsMillis),
+    '90th_percentile_present_interval_millis': _percentile(intervalsMillis, 90),
+    '99th_percentile_present_interval_millis': _percentile(intervalsMillis, 99),
+    'worst_present_interval_millis': intervalsMillis.isEmpty ? 0.0 : intervalsMillis.reduce(math.max),
+    'average_frames_per_second': averageInterval == 0.0 ? 0.0 : 1000.0 / averageInterval,
+    'missed_vsync_count': missedVsyncs,
+    'paced_frame_percentage': intervalsMillis.isEmpty ? 0.0 : 100.0 * pacedIntervals / intervalsMillis.length,
+    'vsync_interval_stddev_millis': _standardDeviation(vsyncIntervalsMillis),
+  };
+}
+
+/// Returns the first of the sorted [values] that is at least [value], or null
+/// if there isn't one.
+int _firstAtOrAfter(List<int> values, int value) {
+  int low = 0;
+  int high = values.length;
+  while (low < high) {
+    final int middle = (low + high) ~/ 2;
+    if (values[middle] < value)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  return low < values.length ? values[low] : null;
+}
+
+double _average(List<double> values) {
+  if (values.isEmpty)
+    return 0.0;
+  return values.reduce((double a, double b) => a + b) / values.length;
+}
+
+double _standardDeviation(List<double> values) {
+  if (values.length < 2)
+    return 0.0;
+  final double average = _average(values);
+  double sumOfSquares = 0.0;
+  for (final double value in values)
+    sumOfSquares += (value - average) * (value - average);
+  return math.sqrt(sumOfSquares / (values.length - 1));
+}
+
+double _percentile(List<double> values, int percentile) {
+  if (values.isEmpty)
+    return 0.0;
+  final List<double> sorted = List<double>.from(values)..sort();
+  return sorted[((sorted.length - 1) * percentile / 100).round()];
+}
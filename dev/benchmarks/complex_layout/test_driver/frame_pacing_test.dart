@@ -0,0 +1,48 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:async';
+import 'dart:io';
+
+import 'package:flutter_driver/flutter_driver.dart';
+import 'package:test/test.dart' hide TypeMatcher, isInstanceOf;
+
+void main() {
+  group('frame pacing test', () {
+    FlutterDriver driver;
+
+    setUpAll(() async {
+      driver = await FlutterDriver.connect();
+
+      await driver.waitUntilFirstFrameRasterized();
+    });
+
+    tearDownAll(() async {
+      if (driver != null)
+        driver.close();
+    });
+
+    test('complex_layout_frame_pacing', () async {
+      // The same scrolls as scroll_perf_test.dart, so the results can be
+      // compared with its timeline summary.
+      await Future<void>.delayed(const Duration(milliseconds: 250));
+
+      final SerializableFinder list = find.byValueKey('complex-scroll');
+      await driver.requestData('startFramePacing');
+      for (int i = 0; i < 5; i += 1) {
+        await driver.scroll(list, 0.0, -300.0, const Duration(milliseconds: 300));
+        await Future<void>.delayed(const Duration(milliseconds: 500));
+      }
+      for (int i = 0; i < 5; i += 1) {
+        await driver.scroll(list, 0.0, 300.0, const Duration(milliseconds: 300));
+        await Future<void>.delayed(const Duration(milliseconds: 500));
+      }
+      final String summary = await driver.requestData('stopFramePacing');
+
+      File('$testOutputsDirectory/complex_layout_frame_pacing.json')
+        ..createSync(recursive: true)
+        ..writeAsStringSync(summary);
+    });
+  });
+}
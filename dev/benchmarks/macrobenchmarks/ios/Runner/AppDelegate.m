@@ -4,14 +4,58 @@
 
 #import "AppDelegate.h"
 #import "GeneratedPluginRegistrant.h"
+#import "StartupTrace.h"
 
-@implementation AppDelegate
+static NSString *const kStartupTraceChannel = @"macrobenchmarks/startup_trace";
+
+@implementation AppDelegate {
+  FlutterMethodChannel *_startupTraceChannel;
+}
+
+- (BOOL)application:(UIApplication *)application
+    willFinishLaunchingWithOptions:(NSDictionary *)launchOptions {
+  [[StartupTrace sharedTrace] endPhase:StartupPhaseEngineInit];
+  return [super application:application willFinishLaunchingWithOptions:launchOptions];
+}
 
 - (BOOL)application:(UIApplication *)application
     didFinishLaunchingWithOptions:(NSDictionary *)launchOptions {
-  [GeneratedPluginRegistrant registerWithRegistry:self];
+  StartupTrace *trace = [StartupTrace sharedTrace];
+  [trace beginPhase:StartupPhasePluginRegistration];
+  [GeneratedPluginRegistrant registerLazilyWithRegistry:self];
+  [trace endPhase:StartupPhasePluginRegistration];
+  [self setUpStartupTrace];
   // Override point for customization after application launch.
-  return [super application:application didFinishLaunchingWithOptions:launchOptions];
+  BOOL result = [super application:application didFinishLaunchingWithOptions:launchOptions];
+  [trace beginPhase:StartupPhaseIsolateLaunch];
+  return result;
+}
+
+// The root isolate reports in over |kStartupTraceChannel| as soon as its main()
+// runs, and the driver test later collects the phase durations over it.
+- (void)setUpStartupTrace {
+  FlutterViewController *flutterViewController =
+      (FlutterViewController *)self.window.rootViewController;
+  [flutterViewController setFlutterViewDidRenderCallback:^{
+    [[StartupTrace sharedTrace] endPhase:StartupPhaseFirstFrame];
+  }];
+
+  _startupTraceChannel = [FlutterMethodChannel
+      methodChannelWithName:kStartupTraceChannel
+            binaryMessenger:flutterViewController.binaryMessenger];
+  [_startupTraceChannel setMethodCallHandler:^(FlutterMethodCall *call,
+                                               FlutterResult result) {
+    StartupTrace *trace = [StartupTrace sharedTrace];
+    if ([call.method isEqualToString:@"isolateStarted"]) {
+      [trace endPhase:StartupPhaseIsolateLaunch];
+      [trace beginPhase:StartupPhaseFirstFrame];
+      result(nil);
+    } else if ([call.method isEqualToString:@"getStartupTrace"]) {
+      result([trace durations]);
+    } else {
+      result(FlutterMethodNotImplemented);
+    }
+  }];
 }
 
 @end
@@ -0,0 +1,42 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// The native startup phases, in the order they happen.
+typedef NS_ENUM(NSInteger, StartupPhase) {
+  // From main() to application:willFinishLaunchingWithOptions:. This is where
+  // the main storyboard is loaded, so it covers the FlutterViewController
+  // creating its engine and shell.
+  StartupPhaseEngineInit,
+  // GeneratedPluginRegistrant registering plugins. Plugins that are registered
+  // lazily are only instantiated later, on their first message.
+  StartupPhasePluginRegistration,
+  // From the end of application:didFinishLaunchingWithOptions: to the root
+  // isolate's main() reporting in over the startup trace channel.
+  StartupPhaseIsolateLaunch,
+  // From the root isolate's main() to the first frame being rendered.
+  StartupPhaseFirstFrame,
+};
+
+// Records each startup phase as an os_signpost interval, so the phases show up
+// in Instruments under Points of Interest, and keeps their durations so that
+// a driver test can collect them.
+@interface StartupTrace : NSObject
+
++ (instancetype)sharedTrace;
+
+- (void)beginPhase:(StartupPhase)phase;
+- (void)endPhase:(StartupPhase)phase;
+
+// The duration of every finished phase in microseconds, keyed by
+// "<phase>Micros", plus "preMainMicros" from process creation to main() and
+// "totalMicros" from process creation to the end of the last finished phase.
+- (NSDictionary<NSString*, NSNumber*>*)durations;
+
+@end
+
+NS_ASSUME_NONNULL_END
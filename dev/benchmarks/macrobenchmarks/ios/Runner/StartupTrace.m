@@ -0,0 +1,117 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "StartupTrace.h"
+
+#import <QuartzCore/QuartzCore.h>
+#import <os/signpost.h>
+#import <sys/sysctl.h>
+
+enum { kPhaseCount = StartupPhaseFirstFrame + 1 };
+
+static NSString* PhaseName(StartupPhase phase) {
+  switch (phase) {
+    case StartupPhaseEngineInit:
+      return @"engineInit";
+    case StartupPhasePluginRegistration:
+      return @"pluginRegistration";
+    case StartupPhaseIsolateLaunch:
+      return @"isolateLaunch";
+    case StartupPhaseFirstFrame:
+      return @"firstFrame";
+  }
+}
+
+// Returns the wall clock time this process was created, in seconds since
+// 1970, or 0 if it can't be read.
+static NSTimeInterval ProcessStartTime(void) {
+  struct kinfo_proc info;
+  size_t size = sizeof(info);
+  int mib[] = {CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid()};
+  if (sysctl(mib, 4, &info, &size, NULL, 0) != 0) {
+    return 0;
+  }
+  struct timeval start = info.kp_proc.p_starttime;
+  return start.tv_sec + start.tv_usec / 1e6;
+}
+
+@implementation StartupTrace {
+  CFTimeInterval _begin[kPhaseCount];
+  CFTimeInterval _end[kPhaseCount];
+  // When the first phase began, and how long after process creation that was.
+  CFTimeInterval _firstBegin;
+  NSTimeInterval _preMain;
+  os_log_t _log;
+  os_signpost_id_t _signpostIds[kPhaseCount];
+}
+
++ (instancetype)sharedTrace {
+  static StartupTrace* sharedTrace;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    sharedTrace = [[StartupTrace alloc] init];
+  });
+  return sharedTrace;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    if (@available(iOS 12.0, *)) {
+      _log = os_log_create("io.flutter.benchmarks.macrobenchmarks",
+                           OS_LOG_CATEGORY_POINTS_OF_INTEREST);
+    }
+  }
+  return self;
+}
+
+- (void)beginPhase:(StartupPhase)phase {
+  CFTimeInterval now = CACurrentMediaTime();
+  if (_firstBegin == 0) {
+    _firstBegin = now;
+    NSTimeInterval processStart = ProcessStartTime();
+    if (processStart > 0) {
+      _preMain = [NSDate date].timeIntervalSince1970 - processStart;
+    }
+  }
+  _begin[phase] = now;
+  if (@available(iOS 12.0, *)) {
+    _signpostIds[phase] = os_signpost_id_generate(_log);
+    os_signpost_interval_begin(_log, _signpostIds[phase], "StartupPhase", "%{public}@",
+                               PhaseName(phase));
+  }
+}
+
+- (void)endPhase:(StartupPhase)phase {
+  if (_begin[phase] == 0 || _end[phase] != 0) {
+    return;
+  }
+  _end[phase] = CACurrentMediaTime();
+  if (@available(iOS 12.0, *)) {
+    os_signpost_interval_end(_log, _signpostIds[phase], "StartupPhase", "%{public}@",
+                             PhaseName(phase));
+  }
+}
+
+- (NSDictionary<NSString*, NSNumber*>*)durations {
+  NSMutableDictionary<NSString*, NSNumber*>* durations = [NSMutableDictionary dictionary];
+  CFTimeInterval lastEnd = 0;
+  for (NSInteger phase = 0; phase < kPhaseCount; phase++) {
+    if (_end[phase] == 0) {
+      continue;
+    }
+    NSString* key = [PhaseName(phase) stringByAppendingString:@"Micros"];
+    durations[key] = @((int64_t)((_end[phase] - _begin[phase]) * 1e6));
+    lastEnd = MAX(lastEnd, _end[phase]);
+  }
+  if (_preMain > 0) {
+    durations[@"preMainMicros"] = @((int64_t)(_preMain * 1e6));
+    if (lastEnd > 0) {
+      durations[@"totalMicros"] = @((int64_t)((_preMain + lastEnd - _firstBegin) * 1e6));
+    }
+  }
+  return durations;
+}
+
+@end
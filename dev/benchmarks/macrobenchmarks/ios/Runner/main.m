@@ -5,9 +5,11 @@
 #import <Flutter/Flutter.h>
 #import <UIKit/UIKit.h>
 #import "AppDelegate.h"
+#import "StartupTrace.h"
 
 int main(int argc, char* argv[]) {
   @autoreleasepool {
+    [[StartupTrace sharedTrace] beginPhase:StartupPhaseEngineInit];
     return UIApplicationMain(argc, argv, nil, NSStringFromClass([AppDelegate class]));
   }
 }
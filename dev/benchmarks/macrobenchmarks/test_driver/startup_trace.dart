@@ -0,0 +1,25 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:convert' show json;
+
+import 'package:flutter/services.dart';
+import 'package:flutter_driver/driver_extension.dart';
+import 'package:macrobenchmarks/main.dart' as app;
+
+/// Connects to the startup trace kept by the iOS host, see
+/// `ios/Runner/StartupTrace.m`.
+const MethodChannel _startupTrace = MethodChannel('macrobenchmarks/startup_trace');
+
+void main() {
+  enableFlutterDriverExtension(handler: (String message) async {
+    final Map<String, dynamic> durations =
+        await _startupTrace.invokeMapMethod<String, dynamic>('getStartupTrace');
+    return json.encode(durations);
+  });
+  // Ends the isolate launch phase. This has to happen before runApp so that
+  // the first frame phase covers building and rendering the first frame.
+  _startupTrace.invokeMethod<void>('isolateStarted');
+  app.main();
+}
@@ -0,0 +1,19 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:io';
+
+import 'package:flutter_driver/flutter_driver.dart';
+import 'package:test/test.dart' hide TypeMatcher, isInstanceOf;
+
+void main() {
+  test('startup_trace', () async {
+    final FlutterDriver driver = await FlutterDriver.connect();
+    final String durations = await driver.requestData('getStartupTrace');
+    File('$testOutputsDirectory/startup_trace.json')
+      ..createSync(recursive: true)
+      ..writeAsStringSync(durations);
+    driver.close();
+  }, timeout: const Timeout(Duration(seconds: 30)));
+}
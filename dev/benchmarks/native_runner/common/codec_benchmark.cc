@@ -0,0 +1,108 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <benchmark/benchmark.h>
+#include <flutter/encodable_value.h>
+#include <flutter/method_call.h>
+#include <flutter/standard_message_codec.h>
+#include <flutter/standard_method_codec.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+// A map shaped like the runner metrics a driver test reads: a few scalars and
+// a nested histogram per statistic.
+flutter::EncodableValue MetricsLikeValue() {
+  flutter::EncodableMap metrics;
+  for (int statistic = 0; statistic < 4; ++statistic) {
+    flutter::EncodableList buckets;
+    for (int64_t bucket = 0; bucket < 24; ++bucket) {
+      buckets.push_back(flutter::EncodableValue(bucket * 1000));
+    }
+    metrics[flutter::EncodableValue("statistic" + std::to_string(statistic))] =
+        flutter::EncodableValue(flutter::EncodableMap{
+            {flutter::EncodableValue("count"),
+             flutter::EncodableValue(static_cast<int64_t>(123456))},
+            {flutter::EncodableValue("p99Micros"),
+             flutter::EncodableValue(16.7)},
+            {flutter::EncodableValue("buckets"),
+             flutter::EncodableValue(buckets)},
+        });
+  }
+  metrics[flutter::EncodableValue("renderer")] =
+      flutter::EncodableValue("hardware");
+  return flutter::EncodableValue(metrics);
+}
+
+void BM_StandardMessageCodecEncodeMap(benchmark::State& state) {
+  const flutter::StandardMessageCodec& codec =
+      flutter::StandardMessageCodec::GetInstance();
+  flutter::EncodableValue value = MetricsLikeValue();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(codec.EncodeMessage(value));
+  }
+}
+BENCHMARK(BM_StandardMessageCodecEncodeMap);
+
+void BM_StandardMessageCodecDecodeMap(benchmark::State& state) {
+  const flutter::StandardMessageCodec& codec =
+      flutter::StandardMessageCodec::GetInstance();
+  std::unique_ptr<std::vector<uint8_t>> encoded =
+      codec.EncodeMessage(MetricsLikeValue());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        codec.DecodeMessage(encoded->data(), encoded->size()));
+  }
+  state.SetBytesProcessed(state.iterations() * encoded->size());
+}
+BENCHMARK(BM_StandardMessageCodecDecodeMap);
+
+// Byte buffers of state.range(0) bytes, as sent for images or file contents.
+void BM_StandardMessageCodecEncodeBytes(benchmark::State& state) {
+  const flutter::StandardMessageCodec& codec =
+      flutter::StandardMessageCodec::GetInstance();
+  flutter::EncodableValue value(
+      std::vector<uint8_t>(static_cast<size_t>(state.range(0)), 0x5a));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(codec.EncodeMessage(value));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StandardMessageCodecEncodeBytes)->Range(64, 1 << 20);
+
+void BM_StandardMessageCodecDecodeBytes(benchmark::State& state) {
+  const flutter::StandardMessageCodec& codec =
+      flutter::StandardMessageCodec::GetInstance();
+  std::unique_ptr<std::vector<uint8_t>> encoded =
+      codec.EncodeMessage(flutter::EncodableValue(
+          std::vector<uint8_t>(static_cast<size_t>(state.range(0)), 0x5a)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        codec.DecodeMessage(encoded->data(), encoded->size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StandardMessageCodecDecodeBytes)->Range(64, 1 << 20);
+
+// A round trip of a small method call, the common case for plugin channels.
+void BM_StandardMethodCodecMethodCall(benchmark::State& state) {
+  const flutter::StandardMethodCodec& codec =
+      flutter::StandardMethodCodec::GetInstance();
+  flutter::MethodCall<flutter::EncodableValue> call(
+      "setWindowTitle", std::make_unique<flutter::EncodableValue>(
+                            flutter::EncodableValue("Benchmark")));
+  for (auto _ : state) {
+    std::unique_ptr<std::vector<uint8_t>> encoded =
+        codec.EncodeMethodCall(call);
+    benchmark::DoNotOptimize(
+        codec.DecodeMethodCall(encoded->data(), encoded->size()));
+  }
+}
+BENCHMARK(BM_StandardMethodCodecMethodCall);
+
+}  // namespace
@@ -0,0 +1,53 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "duration_histogram.h"
+
+namespace {
+
+// Durations spread from under a microsecond to tens of milliseconds, so that
+// Record walks a realistic range of buckets.
+std::vector<std::chrono::nanoseconds> SampleDurations() {
+  std::minstd_rand random;
+  std::exponential_distribution<double> micros(1.0 / 500.0);
+  std::vector<std::chrono::nanoseconds> durations;
+  for (int i = 0; i < 1024; ++i) {
+    durations.push_back(
+        std::chrono::nanoseconds(static_cast<int64_t>(micros(random) * 1000)));
+  }
+  return durations;
+}
+
+// Record is called for every run loop iteration and dispatch, so it needs to
+// stay in the low nanoseconds.
+void BM_DurationHistogramRecord(benchmark::State& state) {
+  std::vector<std::chrono::nanoseconds> durations = SampleDurations();
+  DurationHistogram histogram;
+  size_t i = 0;
+  for (auto _ : state) {
+    histogram.Record(durations[i++ % durations.size()]);
+  }
+  benchmark::DoNotOptimize(histogram.count());
+}
+BENCHMARK(BM_DurationHistogramRecord);
+
+void BM_DurationHistogramPercentile(benchmark::State& state) {
+  DurationHistogram histogram;
+  for (std::chrono::nanoseconds duration : SampleDurations()) {
+    histogram.Record(duration);
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(histogram.Percentile(99));
+  }
+}
+BENCHMARK(BM_DurationHistogramPercentile);
+
+}  // namespace
@@ -0,0 +1,69 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "fast_path_registry.h"
+
+namespace {
+
+// A value kept up to date by another thread, as fast path queries read.
+std::atomic<int64_t> g_battery_level(42);
+
+int64_t QueryBatteryLevel(void* user_data) {
+  return static_cast<std::atomic<int64_t>*>(user_data)->load(
+      std::memory_order_relaxed);
+}
+
+// Registers the benchmark's queries once: a few others, so that lookups have
+// something to skip, and then the battery level. Returns the battery level's
+// index.
+int32_t RegisterQueries() {
+  static const int32_t index = []() {
+    for (int i = 0; i < 8; ++i) {
+      std::string name = "benchmark/other_" + std::to_string(i);
+      FlutterRunnerRegisterFastPath(name.c_str(), QueryBatteryLevel,
+                                    &g_battery_level);
+    }
+    FlutterRunnerRegisterFastPath("benchmark/battery_level", QueryBatteryLevel,
+                                  &g_battery_level);
+    return FlutterRunnerFastPathCount() - 1;
+  }();
+  return index;
+}
+
+// A query by index, which is what each read from Dart costs on the native
+// side. Compare with BM_StandardMethodCodecMethodCall, which is only the
+// encoding part of a method channel call.
+void BM_FastPathQuery(benchmark::State& state) {
+  int32_t index = RegisterQueries();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FlutterRunnerQueryFastPath(index));
+  }
+}
+BENCHMARK(BM_FastPathQuery);
+
+// Finding a query's index by name, which Dart does once per query.
+void BM_FastPathLookup(benchmark::State& state) {
+  RegisterQueries();
+  for (auto _ : state) {
+    int32_t count = FlutterRunnerFastPathCount();
+    int32_t found = -1;
+    for (int32_t i = 0; i < count && found < 0; ++i) {
+      if (strcmp(FlutterRunnerFastPathName(i), "benchmark/battery_level") ==
+          0) {
+        found = i;
+      }
+    }
+    benchmark::DoNotOptimize(found);
+  }
+}
+BENCHMARK(BM_FastPathLookup);
+
+}  // namespace
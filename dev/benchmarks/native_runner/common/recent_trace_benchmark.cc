@@ -0,0 +1,30 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+
+#include "recent_trace.h"
+
+namespace {
+
+// AddEvent is called for every run loop wakeup and dispatch while
+// diagnostics are enabled, so it needs to cost no more than recording the
+// run loop statistics does. The trace is kept full, so that every event
+// replaces an old one, as it does after the first few seconds.
+void BM_RecentTraceAddEvent(benchmark::State& state) {
+  RecentTrace trace(1024);
+  RecentTrace::TimePoint start = std::chrono::steady_clock::now();
+  RecentTrace::TimePoint end = start + std::chrono::microseconds(100);
+  for (int i = 0; i < 1024; ++i) {
+    trace.AddEvent("Event", start, end);
+  }
+  for (auto _ : state) {
+    trace.AddEvent("Event", start, end, 1);
+  }
+}
+BENCHMARK(BM_RecentTraceAddEvent);
+
+}  // namespace
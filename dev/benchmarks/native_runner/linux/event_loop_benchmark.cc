@@ -0,0 +1,314 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <benchmark/benchmark.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mount.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "event_loop.h"
+
+namespace {
+
+// Measures the cost of one event loop pass with state.range(0) ready file
+// descriptors, with an engine that always has work to do, so the pass cost
+// is all EventLoop overhead plus the (empty) callbacks.
+void BM_EventLoopDispatch(benchmark::State &state) {
+  const int fd_count = static_cast<int>(state.range(0));
+  EventLoop event_loop;
+  std::vector<int> fds;
+  for (int i = 0; i < fd_count; ++i) {
+    // An eventfd with a nonzero count stays readable until it's read, so every
+    // pass dispatches every descriptor.
+    int fd = eventfd(1, EFD_CLOEXEC | EFD_NONBLOCK);
+    fds.push_back(fd);
+    event_loop.AddFd(fd, EPOLLIN,
+                     [](uint32_t events) { benchmark::DoNotOptimize(events); });
+  }
+
+  flutter::FlutterWindowController controller;
+  controller.run_event_loop = [&state](std::chrono::milliseconds) {
+    return state.KeepRunning();
+  };
+  event_loop.Run(&controller);
+
+  state.SetItemsProcessed(state.iterations() * fd_count);
+  for (int fd : fds) {
+    event_loop.RemoveFd(fd);
+    close(fd);
+  }
+}
+BENCHMARK(BM_EventLoopDispatch)->Arg(1)->Arg(8)->Arg(32);
+
+// Measures the cost of one event loop pass servicing state.range(0) windows,
+// with engines that always have work to do, so the pass cost is all EventLoop
+// overhead, including waking each of the other engines' waits.
+void BM_EventLoopWindows(benchmark::State &state) {
+  const int window_count = static_cast<int>(state.range(0));
+  EventLoop event_loop;
+  event_loop.SetWakeFunction([]() { benchmark::ClobberMemory(); });
+  std::vector<flutter::FlutterWindowController> secondary_controllers(
+      window_count - 1);
+  for (flutter::FlutterWindowController &controller : secondary_controllers) {
+    controller.run_event_loop = [](std::chrono::milliseconds timeout) {
+      benchmark::DoNotOptimize(timeout);
+      return true;
+    };
+    event_loop.AddWindow(&controller, nullptr);
+  }
+
+  flutter::FlutterWindowController controller;
+  controller.run_event_loop = [&state](std::chrono::milliseconds) {
+    return state.KeepRunning();
+  };
+  event_loop.Run(&controller);
+
+  state.SetItemsProcessed(state.iterations() * window_count);
+}
+BENCHMARK(BM_EventLoopWindows)->Arg(1)->Arg(4);
+
+// An idle engine wait, which, like GLFW's, can be ended early from another
+// thread.
+class FakeEngineWait {
+ public:
+  // Waits for up to |timeout|, or until Wake is called. The maximum timeout
+  // means no timeout, as it does for RunEventLoopWithTimeout.
+  void Wait(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (timeout == std::chrono::milliseconds::max()) {
+      condition_.wait(lock, [this] { return woken_; });
+    } else {
+      condition_.wait_for(lock, timeout, [this] { return woken_; });
+    }
+    woken_ = false;
+  }
+
+  void Wake() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      woken_ = true;
+    }
+    condition_.notify_one();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool woken_ = false;
+};
+
+// Measures the time from a file descriptor becoming ready to its callback
+// running while the engine is idle, with a poll interval of state.range(0)
+// milliseconds and no wake function. The descriptor becomes ready at a random
+// point in each engine wait, as it would for a socket or another thread's
+// eventfd.
+void BM_EventLoopWakeLatency(benchmark::State &state) {
+  const std::chrono::milliseconds poll_interval(state.range(0));
+  EventLoop event_loop;
+  event_loop.SetPollInterval(poll_interval);
+  event_loop.SetWakeFunction(nullptr);
+  int timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+
+  std::chrono::steady_clock::time_point ready_time;
+  event_loop.AddFd(timer_fd, EPOLLIN, [&](uint32_t) {
+    uint64_t expirations;
+    if (read(timer_fd, &expirations, sizeof(expirations)) < 0) {
+      state.SkipWithError("Unable to read timerfd");
+      return;
+    }
+    state.SetIterationTime(std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - ready_time)
+                               .count());
+  });
+
+  std::minstd_rand random;
+  std::uniform_int_distribution<int64_t> offset_nanos(
+      1, std::chrono::nanoseconds(poll_interval).count() - 1);
+  flutter::FlutterWindowController controller;
+  controller.run_event_loop = [&](std::chrono::milliseconds timeout) {
+    if (!state.KeepRunning()) {
+      return false;
+    }
+    // steady_clock and CLOCK_MONOTONIC are the same clock on Linux.
+    std::chrono::nanoseconds offset(offset_nanos(random));
+    ready_time = std::chrono::steady_clock::now() + offset;
+    struct itimerspec timer = {};
+    timer.it_value.tv_sec = offset.count() / 1000000000;
+    timer.it_value.tv_nsec = offset.count() % 1000000000;
+    timerfd_settime(timer_fd, 0, &timer, nullptr);
+    // The idle engine waits out the whole timeout, since it can't see the
+    // event loop's descriptors.
+    std::this_thread::sleep_for(timeout);
+    return true;
+  };
+  event_loop.Run(&controller);
+
+  event_loop.RemoveFd(timer_fd);
+  close(timer_fd);
+}
+BENCHMARK(BM_EventLoopWakeLatency)
+    ->Arg(1)
+    ->Arg(4)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Measures the time from a file descriptor becoming ready to its callback
+// running while the engine is idle, with the watcher thread waking the engine
+// wait. Unlike with a poll interval, the idle engine waits indefinitely.
+void BM_EventLoopWatchedWakeLatency(benchmark::State &state) {
+  FakeEngineWait engine_wait;
+  EventLoop event_loop;
+  event_loop.SetWakeFunction([&engine_wait]() { engine_wait.Wake(); });
+  int event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+  std::chrono::steady_clock::time_point ready_time;
+  bool ready = false;
+  event_loop.AddFd(event_fd, EPOLLIN, [&](uint32_t) {
+    uint64_t count;
+    if (read(event_fd, &count, sizeof(count)) < 0) {
+      state.SkipWithError("Unable to read eventfd");
+      return;
+    }
+    state.SetIterationTime(std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - ready_time)
+                               .count());
+    ready = false;
+  });
+
+  // Another thread signals the descriptor while the engine is waiting.
+  std::thread signaler;
+  flutter::FlutterWindowController controller;
+  controller.run_event_loop = [&](std::chrono::milliseconds timeout) {
+    if (signaler.joinable()) {
+      signaler.join();
+    }
+    if (!ready) {
+      if (!state.KeepRunning()) {
+        return false;
+      }
+      ready = true;
+      signaler = std::thread([&]() {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        ready_time = std::chrono::steady_clock::now();
+        uint64_t count = 1;
+        if (write(event_fd, &count, sizeof(count)) < 0) {
+          state.SkipWithError("Unable to write eventfd");
+        }
+      });
+    }
+    engine_wait.Wait(timeout);
+    return true;
+  };
+  event_loop.Run(&controller);
+
+  if (signaler.joinable()) {
+    signaler.join();
+  }
+  event_loop.RemoveFd(event_fd);
+  close(event_fd);
+}
+BENCHMARK(BM_EventLoopWatchedWakeLatency)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Measures the time from a mount table change to the callback for
+// /proc/self/mounts running while the engine is idle, with the watcher thread
+// waking the engine wait. Like a PSI trigger (see MemoryPressureMonitor),
+// /proc/self/mounts reports each event to only one poll, so this fails if
+// the event is consumed before it's dispatched. The mounts are made in a
+// private mount namespace, which needs root or unprivileged user namespaces.
+void BM_EventLoopWatchedPollConsumedWakeLatency(benchmark::State &state) {
+  // How long to wait for an event before reporting it as lost.
+  constexpr std::chrono::seconds kLostEventTimeout(1);
+
+  if (unshare(CLONE_NEWNS) != 0 &&
+      unshare(CLONE_NEWUSER | CLONE_NEWNS) != 0) {
+    state.SkipWithError("Unable to create a mount namespace");
+    return;
+  }
+  char mount_point[] = "/tmp/event_loop_benchmark_XXXXXX";
+  if (mount(nullptr, "/", nullptr, MS_REC | MS_PRIVATE, nullptr) != 0 ||
+      !mkdtemp(mount_point)) {
+    state.SkipWithError("Unable to create a mount point");
+    return;
+  }
+
+  FakeEngineWait engine_wait;
+  EventLoop event_loop;
+  event_loop.SetWakeFunction([&engine_wait]() { engine_wait.Wake(); });
+  int mounts_fd = open("/proc/self/mounts", O_RDONLY | O_CLOEXEC);
+
+  std::chrono::steady_clock::time_point ready_time;
+  bool ready = false;
+  event_loop.AddFd(mounts_fd, EPOLLPRI, [&](uint32_t) {
+    state.SetIterationTime(std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - ready_time)
+                               .count());
+    ready = false;
+  });
+
+  // Another thread mounts or unmounts a tmpfs while the engine is waiting.
+  std::thread signaler;
+  bool mounted = false;
+  flutter::FlutterWindowController controller;
+  controller.run_event_loop = [&](std::chrono::milliseconds timeout) {
+    if (signaler.joinable()) {
+      signaler.join();
+    }
+    if (ready &&
+        std::chrono::steady_clock::now() - ready_time > kLostEventTimeout) {
+      state.SkipWithError("The mount event didn't reach its callback");
+      return false;
+    }
+    if (!ready) {
+      if (!state.KeepRunning()) {
+        return false;
+      }
+      ready = true;
+      signaler = std::thread([&]() {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        ready_time = std::chrono::steady_clock::now();
+        int result = mounted ? umount(mount_point)
+                             : mount("tmpfs", mount_point, "tmpfs", 0, nullptr);
+        if (result != 0) {
+          state.SkipWithError("Unable to change the mount table");
+        }
+        mounted = !mounted;
+      });
+    }
+    engine_wait.Wait(
+        std::min(timeout, std::chrono::milliseconds(kLostEventTimeout)));
+    return true;
+  };
+  event_loop.Run(&controller);
+
+  if (signaler.joinable()) {
+    signaler.join();
+  }
+  event_loop.RemoveFd(mounts_fd);
+  close(mounts_fd);
+  if (mounted) {
+    umount(mount_point);
+  }
+  rmdir(mount_point);
+}
+BENCHMARK(BM_EventLoopWatchedPollConsumedWakeLatency)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
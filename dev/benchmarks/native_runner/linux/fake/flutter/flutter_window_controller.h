@@ -0,0 +1,94 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FLUTTER_WINDOW_CONTROLLER_H_
+#define FAKE_FLUTTER_WINDOW_CONTROLLER_H_
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace flutter {
+
+struct WindowProperties {
+  std::string title;
+  int width;
+  int height;
+};
+
+struct WindowFrame {
+  int left;
+  int top;
+  int width;
+  int height;
+};
+
+class FlutterWindow {
+ public:
+  WindowFrame GetFrame() { return frame_; }
+
+  void SetFrame(const WindowFrame &frame) { frame_ = frame; }
+
+ private:
+  WindowFrame frame_ = {};
+};
+
+// Stands in for the wrapper's FlutterWindowController, so that EventLoop and
+// window creation can be benchmarked without an engine or a window. Each
+// engine event loop call is forwarded to |run_event_loop|, which returns false
+// to end EventLoop::Run.
+class FlutterWindowController {
+ public:
+  // Larger windows can't be created, as with GL's maximum surface size.
+  static constexpr int kMaxWindowSize = 16384;
+
+  FlutterWindowController() = default;
+
+  explicit FlutterWindowController(const std::string &icu_data_path) {}
+
+  // Counts destroyed controllers, since destroying the wrapper's controller
+  // terminates GLFW, which destroys every other open window.
+  ~FlutterWindowController() { ++destroyed_count(); }
+
+  // Prevent copying.
+  FlutterWindowController(FlutterWindowController const &) = delete;
+  FlutterWindowController &operator=(FlutterWindowController const &) =
+      delete;
+
+  // The number of controllers destroyed so far.
+  static int &destroyed_count() {
+    static int count = 0;
+    return count;
+  }
+
+  bool CreateWindow(const WindowProperties &window_properties,
+                    const std::string &assets_path,
+                    const std::vector<std::string> &arguments) {
+    if (window_properties.width > kMaxWindowSize ||
+        window_properties.height > kMaxWindowSize) {
+      return false;
+    }
+    window_created_ = true;
+    return true;
+  }
+
+  void DestroyWindow() { window_created_ = false; }
+
+  FlutterWindow *window() { return window_created_ ? &window_ : nullptr; }
+
+  std::function<bool(std::chrono::milliseconds timeout)> run_event_loop;
+
+  bool RunEventLoopWithTimeout(std::chrono::milliseconds timeout) {
+    return run_event_loop(timeout);
+  }
+
+ private:
+  bool window_created_ = false;
+  FlutterWindow window_;
+};
+
+}  // namespace flutter
+
+#endif  // FAKE_FLUTTER_WINDOW_CONTROLLER_H_
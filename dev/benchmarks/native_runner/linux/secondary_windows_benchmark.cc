@@ -0,0 +1,57 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "secondary_windows.h"
+
+namespace {
+
+// Measures the cost of creating state.range(0) secondary windows, one of which
+// is too large to be created, as with a bad size in a 'window' setting.
+// Fails if any controller is destroyed while the windows are created, since
+// destroying a controller would also destroy the main window.
+void BM_CreateSecondaryWindowsWithFailure(benchmark::State &state) {
+  const int window_count = static_cast<int>(state.range(0));
+  std::vector<RunnerConfiguration::Window> windows(window_count);
+  for (RunnerConfiguration::Window &window : windows) {
+    window.route = "/secondary";
+    window.has_position = true;
+  }
+  RunnerConfiguration::Window &bad_window = windows[window_count / 2];
+  bad_window.width = flutter::FlutterWindowController::kMaxWindowSize + 1;
+  bad_window.height = 1;
+
+  flutter::WindowProperties main_window_properties = {};
+  main_window_properties.width = 800;
+  main_window_properties.height = 600;
+  const std::vector<std::string> engine_arguments = {"--route=/"};
+
+  for (auto _ : state) {
+    const int destroyed_count =
+        flutter::FlutterWindowController::destroyed_count();
+    std::vector<SecondaryWindowController> controllers =
+        CreateSecondaryWindows(windows, main_window_properties, "icudtl.dat",
+                               "flutter_assets", engine_arguments);
+    if (flutter::FlutterWindowController::destroyed_count() !=
+        destroyed_count) {
+      state.SkipWithError("A controller was destroyed during creation");
+      break;
+    }
+    if (controllers.size() != windows.size() ||
+        controllers[window_count / 2].created) {
+      state.SkipWithError("The failed window's controller wasn't returned");
+      break;
+    }
+    // Destroying the controllers is part of each run's teardown, as it is
+    // when the app exits.
+  }
+
+  state.SetItemsProcessed(state.iterations() * window_count);
+}
+BENCHMARK(BM_CreateSecondaryWindowsWithFailure)->Arg(1)->Arg(4);
+
+}  // namespace
@@ -0,0 +1,53 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_FLUTTER_VIEW_CONTROLLER_H_
+#define FAKE_FLUTTER_VIEW_CONTROLLER_H_
+
+#include <windows.h>
+
+#include <chrono>
+#include <functional>
+
+namespace flutter {
+
+// Stands in for the wrapper's FlutterView, wrapping an existing window.
+class FlutterView {
+ public:
+  explicit FlutterView(HWND window) : window_(window) {}
+
+  HWND GetNativeWindow() { return window_; }
+
+ private:
+  HWND window_;
+};
+
+// Stands in for the wrapper's FlutterViewController, so that RunLoop can be
+// benchmarked without an engine. Each call to ProcessMessages is forwarded to
+// |process_messages|, which by default reports that there is no scheduled
+// work.
+class FlutterViewController {
+ public:
+  explicit FlutterViewController(HWND view_window) : view_(view_window) {}
+
+  // Prevent copying
+  FlutterViewController(FlutterViewController const&) = delete;
+  FlutterViewController& operator=(FlutterViewController const&) = delete;
+
+  FlutterView* view() { return &view_; }
+
+  std::chrono::nanoseconds ProcessMessages() { return process_messages(); }
+
+  std::function<std::chrono::nanoseconds()> process_messages = []() {
+    // Parenthesized, since windows.h may define a max macro.
+    return (std::chrono::nanoseconds::max)();
+  };
+
+ private:
+  FlutterView view_;
+};
+
+}  // namespace flutter
+
+#endif  // FAKE_FLUTTER_VIEW_CONTROLLER_H_
@@ -0,0 +1,143 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <benchmark/benchmark.h>
+#include <windows.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "run_loop.h"
+
+namespace {
+
+constexpr const wchar_t kViewWindowClassName[] = L"FLUTTER_BENCHMARK_VIEW";
+
+// Called for each WM_USER message a view window receives.
+std::function<void(HWND)>* g_view_message_handler = nullptr;
+
+LRESULT CALLBACK ViewWindowProc(HWND window,
+                                UINT message,
+                                WPARAM wparam,
+                                LPARAM lparam) {
+  if (message == WM_USER && g_view_message_handler) {
+    (*g_view_message_handler)(window);
+    return 0;
+  }
+  return ::DefWindowProc(window, message, wparam, lparam);
+}
+
+// A set of fake Flutter instances registered with a run loop, each with a
+// message-only window as its view.
+class FakeInstances {
+ public:
+  FakeInstances(RunLoop* run_loop, int count) : run_loop_(run_loop) {
+    static bool class_registered = false;
+    if (!class_registered) {
+      WNDCLASS window_class = {};
+      window_class.lpfnWndProc = ViewWindowProc;
+      window_class.hInstance = ::GetModuleHandle(nullptr);
+      window_class.lpszClassName = kViewWindowClassName;
+      ::RegisterClass(&window_class);
+      class_registered = true;
+    }
+    for (int i = 0; i < count; ++i) {
+      HWND window = ::CreateWindow(kViewWindowClassName, L"", 0, 0, 0, 0, 0,
+                                   HWND_MESSAGE, nullptr,
+                                   ::GetModuleHandle(nullptr), nullptr);
+      windows_.push_back(window);
+      controllers_.push_back(
+          std::make_unique<flutter::FlutterViewController>(window));
+      run_loop_->RegisterFlutterInstance(controllers_.back().get());
+    }
+  }
+
+  ~FakeInstances() {
+    for (size_t i = 0; i < controllers_.size(); ++i) {
+      run_loop_->UnregisterFlutterInstance(controllers_[i].get());
+      ::DestroyWindow(windows_[i]);
+    }
+  }
+
+  // Prevent copying
+  FakeInstances(FakeInstances const&) = delete;
+  FakeInstances& operator=(FakeInstances const&) = delete;
+
+  flutter::FlutterViewController* controller(size_t index) {
+    return controllers_[index].get();
+  }
+  HWND window(size_t index) { return windows_[index]; }
+  size_t size() const { return windows_.size(); }
+
+ private:
+  RunLoop* run_loop_;
+  std::vector<HWND> windows_;
+  std::vector<std::unique_ptr<flutter::FlutterViewController>> controllers_;
+};
+
+// Measures a posted task that posts the next one, which is how work reaches
+// the run loop from plugins and other threads.
+void BM_RunLoopPostTask(benchmark::State& state) {
+  RunLoop run_loop;
+  std::function<void()> task = [&]() {
+    if (state.KeepRunning()) {
+      run_loop.PostTask(task);
+    } else {
+      ::PostQuitMessage(0);
+    }
+  };
+  run_loop.PostTask(task);
+  run_loop.Run();
+}
+BENCHMARK(BM_RunLoopPostTask);
+
+// Measures a wakeup with state.range(0) registered instances. Wakeups can't be
+// attributed to an instance, so every instance is serviced in the pass that
+// follows.
+void BM_RunLoopWake(benchmark::State& state) {
+  RunLoop run_loop;
+  FakeInstances instances(&run_loop, static_cast<int>(state.range(0)));
+  bool finished = false;
+  instances.controller(0)->process_messages = [&]() {
+    // KeepRunning must not be called again once it has returned false.
+    if (!finished) {
+      if (state.KeepRunning()) {
+        run_loop.Wake();
+      } else {
+        finished = true;
+        ::PostQuitMessage(0);
+      }
+    }
+    return (std::chrono::nanoseconds::max)();
+  };
+  run_loop.Run();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RunLoopWake)->Arg(1)->Arg(4)->Arg(16);
+
+// Measures a window message sent to one of state.range(0) registered
+// instances' views, rotating through the instances. Only the instance the
+// message was for is serviced afterwards, so this is dominated by dispatch
+// and by finding the instance.
+void BM_RunLoopWindowMessage(benchmark::State& state) {
+  RunLoop run_loop;
+  FakeInstances instances(&run_loop, static_cast<int>(state.range(0)));
+  size_t next = 0;
+  std::function<void(HWND)> handler = [&](HWND) {
+    if (state.KeepRunning()) {
+      next = (next + 1) % instances.size();
+      ::PostMessage(instances.window(next), WM_USER, 0, 0);
+    } else {
+      ::PostQuitMessage(0);
+    }
+  };
+  g_view_message_handler = &handler;
+  ::PostMessage(instances.window(0), WM_USER, 0, 0);
+  run_loop.Run();
+  g_view_message_handler = nullptr;
+}
+BENCHMARK(BM_RunLoopWindowMessage)->Arg(1)->Arg(4)->Arg(16);
+
+}  // namespace
@@ -0,0 +1,67 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <benchmark/benchmark.h>
+#include <windows.h>
+
+#include "win32_window.h"
+
+namespace {
+
+// A hidden top-level window with a child standing in for the Flutter view, so
+// that messages take the same paths through Win32Window as in the runner.
+class BenchmarkWindow : public Win32Window {
+ public:
+  BenchmarkWindow() {
+    SetShowDeferred(true);
+    CreateAndShow(L"Win32Window benchmark", Point(0, 0), Size(800, 600));
+    // Destroyed along with the window.
+    HWND content = ::CreateWindow(L"STATIC", L"", WS_CHILD | WS_VISIBLE, 0, 0,
+                                  0, 0, GetHandle(), nullptr,
+                                  ::GetModuleHandle(nullptr), nullptr);
+    SetChildContent(content);
+  }
+};
+
+// A resize, which lays out the child content and re-checks occlusion.
+void BM_Win32WindowSize(benchmark::State& state) {
+  BenchmarkWindow window;
+  HWND handle = window.GetHandle();
+  int i = 0;
+  for (auto _ : state) {
+    // Alternate sizes, so that the child is really moved every time.
+    WORD width = (i++ % 2) ? 800 : 801;
+    ::SendMessage(handle, WM_SIZE, SIZE_RESTORED, MAKELPARAM(width, 600));
+  }
+}
+BENCHMARK(BM_Win32WindowSize);
+
+// A message Win32Window doesn't handle, which measures the cost of getting
+// through its window procedure to DefWindowProc.
+void BM_Win32WindowUnhandledMessage(benchmark::State& state) {
+  BenchmarkWindow window;
+  HWND handle = window.GetHandle();
+  for (auto _ : state) {
+    ::SendMessage(handle, WM_NULL, 0, 0);
+  }
+}
+BENCHMARK(BM_Win32WindowUnhandledMessage);
+
+// A posted message making a round trip through the message queue, as input
+// does.
+void BM_Win32WindowPostedMessage(benchmark::State& state) {
+  BenchmarkWindow window;
+  HWND handle = window.GetHandle();
+  MSG message;
+  for (auto _ : state) {
+    ::PostMessage(handle, WM_NULL, 0, 0);
+    while (::PeekMessage(&message, nullptr, 0, 0, PM_REMOVE)) {
+      ::TranslateMessage(&message);
+      ::DispatchMessage(&message);
+    }
+  }
+}
+BENCHMARK(BM_Win32WindowPostedMessage);
+
+}  // namespace
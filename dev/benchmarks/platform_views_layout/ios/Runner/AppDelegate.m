@@ -3,10 +3,14 @@
 // found in the LICENSE file.
 
 #include "AppDelegate.h"
+#include "CompositionMetrics.h"
 #include "DummyPlatformView.h"
 #include "GeneratedPluginRegistrant.h"
 
-@implementation AppDelegate
+@implementation AppDelegate {
+  CompositionMetrics* _compositionMetrics;
+  FlutterMethodChannel* _compositionMetricsChannel;
+}
 
 - (BOOL)application:(UIApplication *)application
     didFinishLaunchingWithOptions:(NSDictionary *)launchOptions {
@@ -15,11 +19,30 @@
    NSObject<FlutterPluginRegistrar>* registrar =
       [self registrarForPlugin:@"benchmarks/platform_views_layout/DummyPlatformViewPlugin"];
 
-  DummyPlatformViewFactory* dummyPlatformViewFactory = [[DummyPlatformViewFactory alloc] init];
+  DummyPlatformViewFactory* dummyPlatformViewFactory =
+      [[DummyPlatformViewFactory alloc] initWithMessenger:[registrar messenger]];
   [registrar registerViewFactory:dummyPlatformViewFactory
                                 withId:@"benchmarks/platform_views_layout/DummyPlatformView"
       gestureRecognizersBlockingPolicy:FlutterPlatformViewGestureRecognizersBlockingPolicyEager];
 
+  FlutterViewController* flutterController =
+      (FlutterViewController*)self.window.rootViewController;
+  _compositionMetrics = [[CompositionMetrics alloc] initWithFlutterView:flutterController.view];
+  _compositionMetricsChannel =
+      [FlutterMethodChannel methodChannelWithName:@"benchmarks/platform_views_layout/composition_metrics"
+                                  binaryMessenger:[registrar messenger]];
+  CompositionMetrics* compositionMetrics = _compositionMetrics;
+  [_compositionMetricsChannel setMethodCallHandler:^(FlutterMethodCall* call, FlutterResult result) {
+    if ([call.method isEqualToString:@"start"]) {
+      [compositionMetrics start];
+      result(nil);
+    } else if ([call.method isEqualToString:@"stop"]) {
+      result([compositionMetrics stop]);
+    } else {
+      result(FlutterMethodNotImplemented);
+    }
+  }];
+
   // Override point for customization after application launch.
   return [super application:application didFinishLaunchingWithOptions:launchOptions];
 }
@@ -0,0 +1,29 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Records the UIKit side of platform view composition while started:
+//
+//  * How many overlay views the engine has in the Flutter view at each
+//    display refresh. The engine adds one for every run of Flutter content
+//    drawn above a platform view.
+//  * How long each Core Animation transaction commit on the main run loop
+//    takes.
+//
+// Must be used from the main thread.
+@interface CompositionMetrics : NSObject
+
+- (instancetype)initWithFlutterView:(UIView*)flutterView;
+
+- (void)start;
+
+// Stops recording, and returns the results since |start|.
+- (NSDictionary*)stop;
+
+@end
+
+NS_ASSUME_NONNULL_END
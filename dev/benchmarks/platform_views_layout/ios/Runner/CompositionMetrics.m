@@ -0,0 +1,124 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "CompositionMetrics.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+// Core Animation commits its transaction from a main run loop observer of
+// this order, so observers just before and after it bracket the commit.
+static const CFIndex kCoreAnimationCommitOrder = 2000000;
+
+@implementation CompositionMetrics {
+  __weak UIView* _flutterView;
+  CADisplayLink* _displayLink;
+  CFRunLoopObserverRef _beforeCommitObserver;
+  CFRunLoopObserverRef _afterCommitObserver;
+  CFTimeInterval _commitStart;
+  NSMutableArray<NSNumber*>* _commitDurations;
+  NSUInteger _frameCount;
+  NSUInteger _overlayCountTotal;
+  NSUInteger _overlayCountMax;
+}
+
+- (instancetype)initWithFlutterView:(UIView*)flutterView {
+  self = [super init];
+  if (self) {
+    _flutterView = flutterView;
+    _commitDurations = [NSMutableArray array];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [self removeObservers];
+}
+
+- (void)start {
+  [self removeObservers];
+  _frameCount = 0;
+  _overlayCountTotal = 0;
+  _overlayCountMax = 0;
+  [_commitDurations removeAllObjects];
+
+  __weak CompositionMetrics* weakSelf = self;
+  _beforeCommitObserver = CFRunLoopObserverCreateWithHandler(
+      kCFAllocatorDefault, kCFRunLoopBeforeWaiting | kCFRunLoopExit, YES,
+      kCoreAnimationCommitOrder - 1, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+        CompositionMetrics* strongSelf = weakSelf;
+        if (strongSelf) {
+          strongSelf->_commitStart = CACurrentMediaTime();
+        }
+      });
+  _afterCommitObserver = CFRunLoopObserverCreateWithHandler(
+      kCFAllocatorDefault, kCFRunLoopBeforeWaiting | kCFRunLoopExit, YES,
+      kCoreAnimationCommitOrder + 1, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+        [weakSelf recordCommit];
+      });
+  CFRunLoopAddObserver(CFRunLoopGetMain(), _beforeCommitObserver, kCFRunLoopCommonModes);
+  CFRunLoopAddObserver(CFRunLoopGetMain(), _afterCommitObserver, kCFRunLoopCommonModes);
+
+  _displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(onDisplayLink:)];
+  [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+}
+
+- (NSDictionary*)stop {
+  [self removeObservers];
+
+  NSArray<NSNumber*>* commits =
+      [_commitDurations sortedArrayUsingSelector:@selector(compare:)];
+  double commitTotal = 0;
+  for (NSNumber* duration in commits) {
+    commitTotal += duration.doubleValue;
+  }
+  NSUInteger count = commits.count;
+  return @{
+    @"frame_count" : @(_frameCount),
+    @"average_overlay_count" : @(_frameCount ? (double)_overlayCountTotal / _frameCount : 0.0),
+    @"worst_overlay_count" : @(_overlayCountMax),
+    @"commit_count" : @(count),
+    @"average_commit_time_millis" : @(count ? commitTotal * 1e3 / count : 0.0),
+    @"90th_percentile_commit_time_millis" :
+        @(count ? commits[(count - 1) * 9 / 10].doubleValue * 1e3 : 0.0),
+    @"worst_commit_time_millis" : @(count ? commits.lastObject.doubleValue * 1e3 : 0.0),
+  };
+}
+
+- (void)removeObservers {
+  [_displayLink invalidate];
+  _displayLink = nil;
+  if (_beforeCommitObserver) {
+    CFRunLoopObserverInvalidate(_beforeCommitObserver);
+    CFRelease(_beforeCommitObserver);
+    _beforeCommitObserver = NULL;
+  }
+  if (_afterCommitObserver) {
+    CFRunLoopObserverInvalidate(_afterCommitObserver);
+    CFRelease(_afterCommitObserver);
+    _afterCommitObserver = NULL;
+  }
+}
+
+- (void)recordCommit {
+  if (_commitStart == 0) {
+    return;
+  }
+  [_commitDurations addObject:@(CACurrentMediaTime() - _commitStart)];
+  _commitStart = 0;
+}
+
+- (void)onDisplayLink:(CADisplayLink*)displayLink {
+  NSUInteger overlays = 0;
+  Class overlayClass = NSClassFromString(@"FlutterOverlayView");
+  for (UIView* subview in _flutterView.subviews) {
+    if (overlayClass && [subview isKindOfClass:overlayClass]) {
+      overlays++;
+    }
+  }
+  _frameCount++;
+  _overlayCountTotal += overlays;
+  _overlayCountMax = MAX(_overlayCountMax, overlays);
+}
+
+@end
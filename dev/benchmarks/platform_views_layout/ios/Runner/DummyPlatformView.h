@@ -4,6 +4,8 @@
 
 #import <Flutter/Flutter.h>
 
+#import "PlatformViewPool.h"
+
 NS_ASSUME_NONNULL_BEGIN
 
 @interface DummyPlatformView : NSObject <FlutterPlatformView>
@@ -13,9 +15,25 @@ NS_ASSUME_NONNULL_BEGIN
                     arguments:(id _Nullable)args
               binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger;
 
+// Takes its view from |pool| if it has one, and returns the view to |pool|
+// when deallocated.
+- (instancetype)initWithFrame:(CGRect)frame
+               viewIdentifier:(int64_t)viewId
+                    arguments:(id _Nullable)args
+              binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger
+                         pool:(PlatformViewPool* _Nullable)pool;
+
+// Whether the view was taken from a pool rather than created.
+@property(nonatomic, readonly) BOOL reused;
+
 - (UIView*)view;
 @end
 
+// Creates DummyPlatformViews. Views created with the "pooled" argument reuse
+// native views through a PlatformViewPool.
+//
+// The factory times every view creation, and reports the totals on the
+// "benchmarks/platform_views_layout/creation_stats" method channel.
 @interface DummyPlatformViewFactory : NSObject <FlutterPlatformViewFactory>
 - (instancetype)initWithMessenger:(NSObject<FlutterBinaryMessenger>*)messenger;
 @end
@@ -4,14 +4,36 @@
 
 #import "DummyPlatformView.h"
 
+#import <QuartzCore/QuartzCore.h>
+
+static NSString* const kDummyViewType = @"DummyPlatformView";
+
 @implementation DummyPlatformViewFactory {
   NSObject<FlutterBinaryMessenger>* _messenger;
+  FlutterMethodChannel* _statsChannel;
+  PlatformViewPool* _pool;
+  NSUInteger _createdCount;
+  NSUInteger _reusedCount;
+  CFTimeInterval _creationTime;
 }
 
 - (instancetype)initWithMessenger:(NSObject<FlutterBinaryMessenger>*)messenger {
   self = [super init];
   if (self) {
     _messenger = messenger;
+    // A screenful of the benchmark's views, plus some for the scroll margin.
+    _pool = [[PlatformViewPool alloc] initWithCapacity:8];
+    _statsChannel =
+        [FlutterMethodChannel methodChannelWithName:@"benchmarks/platform_views_layout/creation_stats"
+                                    binaryMessenger:messenger];
+    __weak DummyPlatformViewFactory* weakSelf = self;
+    [_statsChannel setMethodCallHandler:^(FlutterMethodCall* call, FlutterResult result) {
+      if ([call.method isEqualToString:@"getStats"]) {
+        result([weakSelf stats]);
+      } else {
+        result(FlutterMethodNotImplemented);
+      }
+    }];
   }
   return self;
 }
@@ -19,37 +41,78 @@
 - (NSObject<FlutterPlatformView>*)createWithFrame:(CGRect)frame
                                    viewIdentifier:(int64_t)viewId
                                         arguments:(id _Nullable)args {
-  return [[DummyPlatformView alloc] initWithFrame:frame
-                                   viewIdentifier:viewId
-                                        arguments:args
-                                  binaryMessenger:_messenger];
+  CFTimeInterval start = CACurrentMediaTime();
+  BOOL pooled = [args isEqual:@"pooled"];
+  DummyPlatformView* view = [[DummyPlatformView alloc] initWithFrame:frame
+                                                      viewIdentifier:viewId
+                                                           arguments:args
+                                                     binaryMessenger:_messenger
+                                                                pool:pooled ? _pool : nil];
+  _creationTime += CACurrentMediaTime() - start;
+  _createdCount++;
+  if (view.reused) {
+    _reusedCount++;
+  }
+  return view;
 }
 
 - (NSObject<FlutterMessageCodec>*)createArgsCodec {
   return [FlutterStringCodec sharedInstance];
 }
 
+- (NSDictionary*)stats {
+  return @{
+    @"platform_view_creation_count" : @(_createdCount),
+    @"platform_view_reuse_count" : @(_reusedCount),
+    @"average_platform_view_creation_micros" :
+        @(_createdCount ? _creationTime * 1e6 / _createdCount : 0.0),
+  };
+}
+
 @end
 
 @implementation DummyPlatformView {
   UITextView* _view;
   FlutterMethodChannel* _channel;
+  PlatformViewPool* _pool;
 }
 
 - (instancetype)initWithFrame:(CGRect)frame
                viewIdentifier:(int64_t)viewId
                     arguments:(id _Nullable)args
               binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger {
+  return [self initWithFrame:frame
+              viewIdentifier:viewId
+                   arguments:args
+             binaryMessenger:messenger
+                        pool:nil];
+}
+
+- (instancetype)initWithFrame:(CGRect)frame
+               viewIdentifier:(int64_t)viewId
+                    arguments:(id _Nullable)args
+              binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger
+                         pool:(PlatformViewPool*)pool {
   if ([super init]) {
-    _view = [[UITextView alloc] initWithFrame:CGRectMake(0.0, 0.0, 250.0, 100.0)];
-    _view.textColor = UIColor.blueColor;
-    _view.backgroundColor = UIColor.lightGrayColor;
-    [_view setFont:[UIFont systemFontOfSize:52]];
-    _view.text = @"DummyPlatformView";
+    _pool = pool;
+    _view = (UITextView*)[pool dequeueViewOfType:kDummyViewType];
+    _reused = _view != nil;
+    if (!_view) {
+      _view = [[UITextView alloc] initWithFrame:CGRectMake(0.0, 0.0, 250.0, 100.0)];
+      _view.textColor = UIColor.blueColor;
+      _view.backgroundColor = UIColor.lightGrayColor;
+      [_view setFont:[UIFont systemFontOfSize:52]];
+      _view.text = @"DummyPlatformView";
+    }
   }
   return self;
 }
 
+- (void)dealloc {
+  // The engine releases a platform view when it is disposed.
+  [_pool enqueueView:_view ofType:kDummyViewType];
+}
+
 - (UIView*)view {
   return _view;
 }
@@ -0,0 +1,27 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Keeps the native views of disposed platform views, keyed by type, so that
+// factories can reuse them instead of allocating new ones.
+//
+// Must be used from the main thread.
+@interface PlatformViewPool : NSObject
+
+// |capacity| is the number of views kept per type. Views returned past it
+// are released.
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+
+// Returns a pooled view of |type|, or nil if there is none.
+- (nullable UIView*)dequeueViewOfType:(NSString*)type;
+
+// Returns |view| to the pool. The view is removed from its superview.
+- (void)enqueueView:(UIView*)view ofType:(NSString*)type;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,42 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "PlatformViewPool.h"
+
+@implementation PlatformViewPool {
+  NSUInteger _capacity;
+  NSMutableDictionary<NSString*, NSMutableArray<UIView*>*>* _views;
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+  self = [super init];
+  if (self) {
+    _capacity = capacity;
+    _views = [NSMutableDictionary dictionary];
+  }
+  return self;
+}
+
+- (UIView*)dequeueViewOfType:(NSString*)type {
+  NSMutableArray<UIView*>* views = _views[type];
+  UIView* view = views.lastObject;
+  if (view) {
+    [views removeLastObject];
+  }
+  return view;
+}
+
+- (void)enqueueView:(UIView*)view ofType:(NSString*)type {
+  [view removeFromSuperview];
+  NSMutableArray<UIView*>* views = _views[type];
+  if (!views) {
+    views = [NSMutableArray array];
+    _views[type] = views;
+  }
+  if (views.count < _capacity) {
+    [views addObject:view];
+  }
+}
+
+@end
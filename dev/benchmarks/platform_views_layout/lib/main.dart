@@ -2,18 +2,64 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+import 'dart:convert';
 import 'dart:io';
 
+import 'package:flutter/foundation.dart' show ValueListenable;
 import 'package:flutter/material.dart';
 import 'package:flutter/scheduler.dart' show timeDilation;
+import 'package:flutter/services.dart';
 
 void main() {
   runApp(
-    PlatformViewApp()
+    const PlatformViewApp()
   );
 }
 
+const MethodChannel _creationStatsChannel =
+    MethodChannel('benchmarks/platform_views_layout/creation_stats');
+
+/// Returns the platform view creation counts and timings as JSON, or an
+/// empty object on platforms that don't report them.
+Future<String> platformViewCreationStats() async {
+  try {
+    return json.encode(await _creationStatsChannel.invokeMethod<dynamic>('getStats'));
+  } on MissingPluginException {
+    return '{}';
+  }
+}
+
+const MethodChannel _compositionMetricsChannel =
+    MethodChannel('benchmarks/platform_views_layout/composition_metrics');
+
+/// Starts recording overlay counts and Core Animation commit times on iOS.
+Future<void> startCompositionMetrics() async {
+  try {
+    await _compositionMetricsChannel.invokeMethod<void>('start');
+  } on MissingPluginException {
+    // Only iOS records composition metrics.
+  }
+}
+
+/// Stops recording composition metrics, and returns them as JSON.
+Future<String> stopCompositionMetrics() async {
+  try {
+    return json.encode(await _compositionMetricsChannel.invokeMethod<dynamic>('stop'));
+  } on MissingPluginException {
+    return '{}';
+  }
+}
+
 class PlatformViewApp extends StatefulWidget {
+  /// If [pooled] is true, native views are recycled through a pool on iOS.
+  ///
+  /// If [viewsOnScreen] is given, the list items are sized so that its value
+  /// of platform views fit on screen at once.
+  const PlatformViewApp({ Key key, this.pooled = false, this.viewsOnScreen }) : super(key: key);
+
+  final bool pooled;
+  final ValueListenable<int> viewsOnScreen;
+
   @override
   PlatformViewAppState createState() => PlatformViewAppState();
 
@@ -26,7 +72,14 @@ class PlatformViewAppState extends State<PlatformViewApp> {
     return MaterialApp(
       theme: ThemeData.light(),
       title: 'Advanced Layout',
-      home: const PlatformViewLayout(),
+      home: widget.viewsOnScreen == null
+          ? PlatformViewLayout(pooled: widget.pooled)
+          : ValueListenableBuilder<int>(
+              valueListenable: widget.viewsOnScreen,
+              builder: (BuildContext context, int viewsOnScreen, Widget child) {
+                return PlatformViewLayout(pooled: widget.pooled, viewsOnScreen: viewsOnScreen);
+              },
+            ),
     );
   }
 
@@ -39,28 +92,42 @@ class PlatformViewAppState extends State<PlatformViewApp> {
 
 
 class PlatformViewLayout extends StatelessWidget {
-  const PlatformViewLayout({ Key key }) : super(key: key);
+  const PlatformViewLayout({ Key key, this.pooled = false, this.viewsOnScreen }) : super(key: key);
+
+  final bool pooled;
+  final int viewsOnScreen;
 
   @override
   Widget build(BuildContext context) {
     return Scaffold(
       appBar: AppBar(title: const Text('Platform View Scrolling Layout')),
-      body: ListView.builder(
-        key: const Key('platform-views-scroll'), // This key is used by the driver test.
-        itemCount: 200,
-        itemBuilder: (BuildContext context, int index) {
-          return Padding(
-            padding: const EdgeInsets.all(5.0),
-            child: Material(
-              elevation: (index % 5 + 1).toDouble(),
-              color: Colors.white,
-              child: Stack(
-                children: const <Widget> [
-                  DummyPlatformView(),
-                  RotationContainer(),
-                ],
-              ),
-            ),
+      body: LayoutBuilder(
+        builder: (BuildContext context, BoxConstraints constraints) {
+          final double itemExtent = viewsOnScreen == null
+              ? null
+              : constraints.maxHeight / viewsOnScreen;
+          return ListView.builder(
+            key: const Key('platform-views-scroll'), // This key is used by the driver test.
+            itemCount: 200,
+            itemExtent: itemExtent,
+            itemBuilder: (BuildContext context, int index) {
+              return Padding(
+                padding: const EdgeInsets.all(5.0),
+                child: Material(
+                  elevation: (index % 5 + 1).toDouble(),
+                  color: Colors.white,
+                  child: Stack(
+                    children: <Widget> [
+                      DummyPlatformView(
+                        pooled: pooled,
+                        height: itemExtent == null ? 200.0 : itemExtent - 10.0,
+                      ),
+                      const RotationContainer(),
+                    ],
+                  ),
+                ),
+              );
+            },
           );
         },
       ),
@@ -69,26 +136,34 @@ class PlatformViewLayout extends StatelessWidget {
 }
 
 class DummyPlatformView extends StatelessWidget {
-  const DummyPlatformView({Key key}) : super(key: key);
+  const DummyPlatformView({Key key, this.pooled = false, this.height = 200.0}) : super(key: key);
+
+  final bool pooled;
+  final double height;
 
   @override
   Widget build(BuildContext context) {
     const String viewType = 'benchmarks/platform_views_layout/DummyPlatformView';
+    final String creationParams = pooled ? 'pooled' : null;
     StatefulWidget nativeView;
     if (Platform.isIOS) {
-      nativeView = const UiKitView(
+      nativeView = UiKitView(
         viewType: viewType,
+        creationParams: creationParams,
+        creationParamsCodec: const StringCodec(),
       );
     } else if (Platform.isAndroid) {
-      nativeView = const AndroidView(
+      nativeView = AndroidView(
         viewType: viewType,
+        creationParams: creationParams,
+        creationParamsCodec: const StringCodec(),
       );
     } else {
       assert(false, 'Invalid platform');
     }
     return Container(
       color: Colors.purple,
-      height: 200.0,
+      height: height,
       child: nativeView,
     );
   }
@@ -0,0 +1,30 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'package:flutter/foundation.dart';
+import 'package:flutter/material.dart';
+import 'package:flutter_driver/driver_extension.dart';
+import 'package:platform_views_layout/main.dart' as app;
+
+final ValueNotifier<int> _viewsOnScreen = ValueNotifier<int>(1);
+
+Future<String> _handleRequest(String message) async {
+  if (message.startsWith('viewsOnScreen:')) {
+    _viewsOnScreen.value = int.parse(message.substring('viewsOnScreen:'.length));
+    return '';
+  }
+  switch (message) {
+    case 'startCompositionMetrics':
+      await app.startCompositionMetrics();
+      return '';
+    case 'stopCompositionMetrics':
+      return app.stopCompositionMetrics();
+  }
+  throw ArgumentError.value(message, 'message', 'Unknown request');
+}
+
+void main() {
+  enableFlutterDriverExtension(handler: _handleRequest);
+  runApp(app.PlatformViewApp(viewsOnScreen: _viewsOnScreen));
+}
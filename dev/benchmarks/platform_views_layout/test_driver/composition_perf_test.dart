@@ -0,0 +1,77 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:io';
+
+import 'package:flutter_driver/flutter_driver.dart';
+import 'package:test/test.dart' hide TypeMatcher, isInstanceOf;
+
+import 'scroll_perf_common.dart';
+
+/// The numbers of platform views on screen to measure with.
+const List<int> viewCounts = <int>[1, 5, 20];
+
+/// The timeline summary values reported for each view count.
+const List<String> frameTimeKeys = <String>[
+  'average_frame_build_time_millis',
+  '90th_percentile_frame_build_time_millis',
+  'average_frame_rasterizer_time_millis',
+  '90th_percentile_frame_rasterizer_time_millis',
+  'worst_frame_rasterizer_time_millis',
+];
+
+const String summaryName = 'platform_views_composition_perf';
+
+void main() {
+  group('platform view composition', () {
+    FlutterDriver driver;
+
+    setUpAll(() async {
+      driver = await FlutterDriver.connect();
+
+      await driver.waitUntilFirstFrameRasterized();
+    });
+
+    tearDownAll(() async {
+      if (driver != null)
+        driver.close();
+    });
+
+    test(summaryName, () async {
+      // Disable frame sync, since there are ongoing animations.
+      await driver.runUnsynchronized(() async {
+        final Map<String, dynamic> results = <String, dynamic>{};
+        for (final int viewCount in viewCounts) {
+          await driver.requestData('viewsOnScreen:$viewCount');
+          // Let the new layout create its platform views before measuring.
+          await Future<void>.delayed(const Duration(seconds: 1));
+          await driver.forceGC();
+
+          await driver.requestData('startCompositionMetrics');
+          final Timeline timeline = await driver.traceAction(() async {
+            await scrollList(driver, 'platform-views-scroll');
+          });
+          final Map<String, dynamic> composition =
+              json.decode(await driver.requestData('stopCompositionMetrics')) as Map<String, dynamic>;
+
+          final Map<String, dynamic> summary = TimelineSummary.summarize(timeline).summaryJson;
+          // The middle view count also fills in the unprefixed values that
+          // every timeline summary has.
+          if (viewCount == viewCounts[1])
+            results.addAll(summary);
+          for (final String key in frameTimeKeys)
+            results['${viewCount}_views_$key'] = summary[key];
+          composition.forEach((String key, dynamic value) {
+            results['${viewCount}_views_$key'] = value;
+          });
+        }
+        File('$testOutputsDirectory/$summaryName.timeline_summary.json')
+          ..createSync(recursive: true)
+          ..writeAsStringSync(const JsonEncoder.withIndent('  ').convert(results));
+      });
+    });
+  });
+}
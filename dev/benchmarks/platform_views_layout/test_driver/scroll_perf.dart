@@ -6,6 +6,6 @@ import 'package:flutter_driver/driver_extension.dart';
 import 'package:platform_views_layout/main.dart' as app;
 
 void main() {
-  enableFlutterDriverExtension();
+  enableFlutterDriverExtension(handler: (String message) => app.platformViewCreationStats());
   app.main();
 }
@@ -0,0 +1,78 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:io';
+
+import 'package:flutter_driver/flutter_driver.dart';
+import 'package:test/test.dart' hide TypeMatcher, isInstanceOf;
+
+/// Scrolls the list with [listKey] down and back up.
+Future<void> scrollList(FlutterDriver driver, String listKey) async {
+  // Find the scrollable stock list
+  final SerializableFinder list = find.byValueKey(listKey);
+  expect(list, isNotNull);
+
+  // Scroll down
+  for (int i = 0; i < 5; i += 1) {
+    await driver.scroll(list, 0.0, -300.0, const Duration(milliseconds: 300));
+    await Future<void>.delayed(const Duration(milliseconds: 500));
+  }
+
+  // Scroll up
+  for (int i = 0; i < 5; i += 1) {
+    await driver.scroll(list, 0.0, 300.0, const Duration(milliseconds: 300));
+    await Future<void>.delayed(const Duration(milliseconds: 500));
+  }
+}
+
+/// Scrolls the platform view list, and writes the timeline summary to
+/// `build/$summaryName.timeline_summary.json` together with the platform
+/// view creation stats reported by the app.
+void runScrollPerfTest(String summaryName) {
+  group('scrolling performance test', () {
+    FlutterDriver driver;
+
+    setUpAll(() async {
+      driver = await FlutterDriver.connect();
+
+      await driver.waitUntilFirstFrameRasterized();
+    });
+
+    tearDownAll(() async {
+      if (driver != null)
+        driver.close();
+    });
+
+    Future<void> testScrollPerf(String listKey, String summaryName) async {
+      // The slight initial delay avoids starting the timing during a
+      // period of increased load on the device. Without this delay, the
+      // benchmark has greater noise.
+      // See: https://github.com/flutter/flutter/issues/19434
+      await Future<void>.delayed(const Duration(milliseconds: 250));
+
+      await driver.forceGC();
+
+      final Timeline timeline = await driver.traceAction(() async {
+        await scrollList(driver, listKey);
+      });
+
+      final TimelineSummary summary = TimelineSummary.summarize(timeline);
+      final Map<String, dynamic> results = summary.summaryJson
+        ..addAll(json.decode(await driver.requestData('creationStats')) as Map<String, dynamic>);
+      File('$testOutputsDirectory/$summaryName.timeline_summary.json')
+        ..createSync(recursive: true)
+        ..writeAsStringSync(const JsonEncoder.withIndent('  ').convert(results));
+      summary.writeTimelineToFile(summaryName, pretty: true);
+    }
+
+    test(summaryName, () async {
+      // Disable frame sync, since there are ongoing animations.
+      await driver.runUnsynchronized(() async {
+        await testScrollPerf('platform-views-scroll', summaryName);
+      });
+    });
+  });
+}
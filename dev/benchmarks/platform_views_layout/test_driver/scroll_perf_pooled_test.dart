@@ -0,0 +1,9 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'scroll_perf_common.dart';
+
+void main() {
+  runScrollPerfTest('platform_views_scroll_perf_pooled');
+}
@@ -0,0 +1,19 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:async';
+
+import 'package:flutter_devicelab/framework/framework.dart';
+import 'package:flutter_devicelab/framework/utils.dart';
+import 'package:flutter_devicelab/tasks/perf_tests.dart';
+
+Future<void> main() async {
+  await task(ReportedResultsTest(
+    ReportedDurationTestFlavor.profile,
+    '${flutterDirectory.path}/examples/image_list',
+    'lib/image_scroll.dart',
+    'com.example.image_list',
+    '===image_scroll=== ',
+  ).run);
+}
@@ -38,6 +38,34 @@ TaskFunction createPlatformViewsScrollPerfTest() {
   ).run;
 }
 
+TaskFunction createPlatformViewsScrollPerfPooledTest() {
+  return PerfTest(
+    '${flutterDirectory.path}/dev/benchmarks/platform_views_layout',
+    'test_driver/scroll_perf_pooled.dart',
+    'platform_views_scroll_perf_pooled',
+  ).run;
+}
+
+TaskFunction createPlatformViewsCompositionPerfTest() {
+  return PerfTest(
+    '${flutterDirectory.path}/dev/benchmarks/platform_views_layout',
+    'test_driver/composition_perf.dart',
+    'platform_views_composition_perf',
+    needsMeasureCpuGPu: true,
+    additionalScoreKeys: <String>[
+      for (final int viewCount in <int>[1, 5, 20])
+        for (final String key in <String>[
+          'average_frame_rasterizer_time_millis',
+          '90th_percentile_frame_rasterizer_time_millis',
+          'average_overlay_count',
+          'average_commit_time_millis',
+          '90th_percentile_commit_time_millis',
+        ])
+          '${viewCount}_views_$key',
+    ],
+  ).run;
+}
+
 TaskFunction createHomeScrollPerfTest() {
   return PerfTest(
     '${flutterDirectory.path}/dev/integration_tests/flutter_gallery',
@@ -189,6 +217,37 @@ TaskFunction createColorFilterAndFadePerfTest() {
   ).run;
 }
 
+TaskFunction createChannelsBenchmark() {
+  return DriverResultsBenchmark(
+    '${flutterDirectory.path}/dev/integration_tests/channels',
+    'lib/benchmark.dart',
+    'channels_benchmark.json',
+  ).run;
+}
+
+TaskFunction createMacrobenchmarksStartupTraceTest() {
+  return DriverResultsBenchmark(
+    '${flutterDirectory.path}/dev/benchmarks/macrobenchmarks',
+    'test_driver/startup_trace.dart',
+    'startup_trace.json',
+  ).run;
+}
+
+TaskFunction createComplexLayoutFramePacingTest() {
+  return DriverResultsBenchmark(
+    '${flutterDirectory.path}/dev/benchmarks/complex_layout',
+    'test_driver/frame_pacing.dart',
+    'complex_layout_frame_pacing.json',
+  ).run;
+}
+
+TaskFunction createComplexLayoutLinuxRendererPerfTest() {
+  return LinuxRendererBenchmark(
+    '${flutterDirectory.path}/dev/benchmarks/complex_layout',
+    'test_driver/scroll_perf.dart',
+    'complex_layout_scroll_perf',
+  ).run;
+}
 
 /// Measure application startup performance.
 class StartupTest {
@@ -231,7 +290,8 @@ class PerfTest {
       this.testDirectory,
       this.testTarget,
       this.timelineFileName,
-      {this.needsMeasureCpuGPu = false});
+      {this.needsMeasureCpuGPu = false,
+      this.additionalScoreKeys = const <String>[]});
 
   final String testDirectory;
   final String testTarget;
@@ -239,6 +299,10 @@ class PerfTest {
 
   final bool needsMeasureCpuGPu;
 
+  /// Keys of the timeline summary to report as benchmark scores, in addition
+  /// to the frame time keys every summary has.
+  final List<String> additionalScoreKeys;
+
   Future<TaskResult> run() {
     return inDirectory<TaskResult>(testDirectory, () async {
       final Device device = await devices.workingDevice;
@@ -283,11 +347,135 @@ class PerfTest {
         '99th_percentile_frame_rasterizer_time_millis',
         if (needsMeasureCpuGPu) 'cpu_percentage',
         if (needsMeasureCpuGPu) 'gpu_percentage',
+        ...additionalScoreKeys,
+      ]);
+    });
+  }
+}
+
+/// Runs [testTarget] with `flutter drive` and reports every value in the JSON
+/// object the driver test writes to `build/[resultsFileName]` as a benchmark
+/// score.
+class DriverResultsBenchmark {
+  const DriverResultsBenchmark(this.testDirectory, this.testTarget, this.resultsFileName);
+
+  final String testDirectory;
+  final String testTarget;
+  final String resultsFileName;
+
+  Future<TaskResult> run() {
+    return inDirectory<TaskResult>(testDirectory, () async {
+      final Device device = await devices.workingDevice;
+      await device.unlock();
+      final String deviceId = device.deviceId;
+      await flutter('packages', options: <String>['get']);
+
+      await flutter('drive', options: <String>[
+        '-v',
+        '--profile',
+        '-t',
+        testTarget,
+        '-d',
+        deviceId,
       ]);
+      final Map<String, dynamic> data = json.decode(
+        file('$testDirectory/build/$resultsFileName').readAsStringSync(),
+      ) as Map<String, dynamic>;
+
+      return TaskResult.success(data, benchmarkScoreKeys: data.keys.toList());
     });
   }
 }
 
+/// Runs a [PerfTest]-style driver test as a Linux desktop app, once rendering
+/// on the GPU and once with the runner's software renderer, and reports the
+/// frame times of each with a `gpu_` or `software_` prefix.
+///
+/// Only debug builds are implemented for Linux, so the app runs in debug mode
+/// and the frame times are only meaningful relative to each other. They are
+/// reported without benchmark score keys, so that they aren't tracked as
+/// benchmarks.
+///
+/// The app is copied to a temporary directory so that the Linux runner can be
+/// added to it with `flutter create`.
+class LinuxRendererBenchmark {
+  const LinuxRendererBenchmark(this.testDirectory, this.testTarget, this.timelineFileName);
+
+  final String testDirectory;
+  final String testTarget;
+  final String timelineFileName;
+
+  static const List<String> _renderers = <String>['gpu', 'software'];
+
+  static const List<String> _frameTimeKeys = <String>[
+    'average_frame_build_time_millis',
+    '90th_percentile_frame_build_time_millis',
+    '99th_percentile_frame_build_time_millis',
+    'average_frame_rasterizer_time_millis',
+    '90th_percentile_frame_rasterizer_time_millis',
+    '99th_percentile_frame_rasterizer_time_millis',
+    'worst_frame_rasterizer_time_millis',
+  ];
+
+  Future<TaskResult> run() async {
+    final Directory appDirectory = Directory.systemTemp.createTempSync('linux_renderer_benchmark.');
+    try {
+      recursiveCopy(Directory(testDirectory), appDirectory);
+      return await inDirectory<TaskResult>(appDirectory, () async {
+        await flutter('config', options: <String>['--enable-linux-desktop']);
+        await flutter('create', options: <String>['--no-pub', '.']);
+        await flutter('packages', options: <String>['get']);
+
+        final Map<String, dynamic> data = <String, dynamic>{};
+        for (final String renderer in _renderers) {
+          final File configuration = file(path.join(appDirectory.path, 'build', 'runner_$renderer.conf'))
+            ..createSync(recursive: true)
+            ..writeAsStringSync('renderer=$renderer\n');
+          final File metrics = file(path.join(appDirectory.path, 'build', 'runner_metrics_$renderer.json'));
+          rm(metrics);
+          // The app inherits its environment from the tool.
+          await flutter('drive', options: <String>[
+            '-v',
+            '--debug', // The only mode implemented for Linux.
+            '--trace-startup', // Enables "endless" timeline event buffering.
+            '-t',
+            testTarget,
+            '-d',
+            'linux',
+          ], environment: <String, String>{
+            'FLUTTER_RUNNER_CONFIG_FILE': configuration.path,
+            'FLUTTER_RUNNER_METRICS_FILE': metrics.path,
+          });
+
+          final Map<String, dynamic> summary = json.decode(
+            file(path.join(appDirectory.path, 'build', '$timelineFileName.timeline_summary.json')).readAsStringSync(),
+          ) as Map<String, dynamic>;
+          if (summary['frame_count'] as int < 5) {
+            return TaskResult.failure(
+              'Timeline for the $renderer renderer contains too few frames: ${summary['frame_count']}.',
+            );
+          }
+          if (metrics.existsSync()) {
+            final Map<String, dynamic> runnerMetrics = json.decode(metrics.readAsStringSync()) as Map<String, dynamic>;
+            if (runnerMetrics['renderer'] != renderer) {
+              return TaskResult.failure(
+                'Requested the $renderer renderer, but the runner used ${runnerMetrics['renderer']}.',
+              );
+            }
+          }
+          for (final String key in _frameTimeKeys) {
+            data['${renderer}_$key'] = summary[key];
+          }
+          data['${renderer}_frame_count'] = summary['frame_count'];
+        }
+        return TaskResult.success(data);
+      });
+    } finally {
+      rmTree(appDirectory);
+    }
+  }
+}
+
 /// Measures how long it takes to compile a Flutter app to JavaScript and how
 /// big the compiled code is.
 class WebCompileTest {
@@ -715,6 +903,56 @@ class ReportedDurationTest {
   }
 }
 
+/// Runs [test] in [project] and reports every value of the JSON object that it
+/// logs after [resultsPrefix] as a benchmark score.
+class ReportedResultsTest {
+  ReportedResultsTest(this.flavor, this.project, this.test, this.package, this.resultsPrefix);
+
+  final ReportedDurationTestFlavor flavor;
+  final String project;
+  final String test;
+  final String package;
+  final String resultsPrefix;
+
+  Future<TaskResult> run() {
+    return inDirectory<TaskResult>(project, () async {
+      // Like ReportedDurationTest, this only works on Android because it
+      // reads the results from logcat.
+      final Device device = await devices.workingDevice;
+      await device.unlock();
+      await flutter('packages', options: <String>['get']);
+
+      final Completer<Map<String, dynamic>> resultsCompleter = Completer<Map<String, dynamic>>();
+      final StreamSubscription<String> adb = device.logcat.listen(
+        (String data) {
+          final int start = data.indexOf(resultsPrefix);
+          if (start != -1 && !resultsCompleter.isCompleted) {
+            resultsCompleter.complete(
+              json.decode(data.substring(start + resultsPrefix.length)) as Map<String, dynamic>,
+            );
+          }
+        },
+      );
+      print('launching $project$test on device...');
+      await flutter('run', options: <String>[
+        '--verbose',
+        '--no-fast-start',
+        '--${_reportedDurationTestToString(flavor)}',
+        '--no-resident',
+        '-d', device.deviceId,
+        test,
+      ]);
+
+      final Map<String, dynamic> results = await resultsCompleter.future;
+      print('terminating...');
+      await device.stop(package);
+      await adb.cancel();
+
+      return TaskResult.success(results, benchmarkScoreKeys: results.keys.toList());
+    });
+  }
+}
+
 /// Holds simple statistics of an odd-lengthed list of integers.
 class ListStatistics {
   factory ListStatistics(Iterable<int> data) {
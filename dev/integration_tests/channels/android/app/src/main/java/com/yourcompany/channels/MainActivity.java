@@ -6,6 +6,7 @@ package com.yourcompany.channels;
 
 import java.io.ByteArrayOutputStream;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.Date;
 
 import android.os.Bundle;
@@ -29,6 +30,10 @@ public class MainActivity extends FlutterActivity {
     setupMessageHandshake(new BasicMessageChannel<>(dartExecutor, "std-msg", ExtendedStandardMessageCodec.INSTANCE));
     setupMethodHandshake(new MethodChannel(dartExecutor, "json-method", JSONMethodCodec.INSTANCE));
     setupMethodHandshake(new MethodChannel(dartExecutor, "std-method", new StandardMethodCodec(ExtendedStandardMessageCodec.INSTANCE)));
+    setupEcho(new BasicMessageChannel<>(dartExecutor, "binary-echo", BinaryCodec.INSTANCE));
+    setupEcho(new BasicMessageChannel<>(dartExecutor, "string-echo", StringCodec.INSTANCE));
+    setupEcho(new BasicMessageChannel<>(dartExecutor, "json-echo", JSONMessageCodec.INSTANCE));
+    setupEcho(new BasicMessageChannel<>(dartExecutor, "std-echo", StandardMessageCodec.INSTANCE));
   }
 
   private <T> void setupMessageHandshake(final BasicMessageChannel<T> channel) {
@@ -49,6 +54,17 @@ public class MainActivity extends FlutterActivity {
     });
   }
 
+  // Replies to each message with the message itself. Used by the benchmarks in
+  // lib/benchmark.dart.
+  private <T> void setupEcho(final BasicMessageChannel<T> channel) {
+    channel.setMessageHandler(new BasicMessageChannel.MessageHandler<T>() {
+      @Override
+      public void onMessage(final T message, final BasicMessageChannel.Reply<T> reply) {
+        reply.reply(echo(message));
+      }
+    });
+  }
+
   // Outgoing ByteBuffer messages must be direct-allocated and payload placed between
   // position 0 and current position.
   @SuppressWarnings("unchecked")
@@ -146,6 +162,7 @@ final class ExtendedStandardMessageCodec extends StandardMessageCodec {
   public static final ExtendedStandardMessageCodec INSTANCE = new ExtendedStandardMessageCodec();
   private static final byte DATE = (byte) 128;
   private static final byte PAIR = (byte) 129;
+  private static final byte SENSOR_BATCH = (byte) 130;
 
   @Override
   protected void writeValue(ByteArrayOutputStream stream, Object value) {
@@ -156,6 +173,15 @@ final class ExtendedStandardMessageCodec extends StandardMessageCodec {
       stream.write(PAIR);
       writeValue(stream, ((Pair) value).left);
       writeValue(stream, ((Pair) value).right);
+    } else if (value instanceof SensorBatch) {
+      final SensorBatch batch = (SensorBatch) value;
+      stream.write(SENSOR_BATCH);
+      writeLong(stream, batch.timestamp);
+      writeSize(stream, batch.samples.length);
+      writeAlignment(stream, 8);
+      final ByteBuffer bytes = ByteBuffer.allocate(batch.samples.length * 8).order(ByteOrder.nativeOrder());
+      bytes.asDoubleBuffer().put(batch.samples);
+      stream.write(bytes.array(), 0, bytes.capacity());
     } else {
       super.writeValue(stream, value);
     }
@@ -168,6 +194,15 @@ final class ExtendedStandardMessageCodec extends StandardMessageCodec {
         return new Date(buffer.getLong());
       case PAIR:
         return new Pair(readValue(buffer), readValue(buffer));
+      case SENSOR_BATCH: {
+        final long timestamp = buffer.getLong();
+        final int length = readSize(buffer);
+        readAlignment(buffer, 8);
+        final double[] samples = new double[length];
+        buffer.asDoubleBuffer().get(samples);
+        buffer.position(buffer.position() + length * 8);
+        return new SensorBatch(timestamp, samples);
+      }
       default: return super.readValueOfType(type, buffer);
     }
   }
@@ -187,3 +222,18 @@ final class Pair {
     return "Pair[" + left + ", " + right + "]";
   }
 }
+
+final class SensorBatch {
+  public final long timestamp;
+  public final double[] samples;
+
+  public SensorBatch(long timestamp, double[] samples) {
+    this.timestamp = timestamp;
+    this.samples = samples;
+  }
+
+  @Override
+  public String toString() {
+    return "SensorBatch[" + timestamp + ", " + samples.length + " samples]";
+  }
+}
@@ -20,8 +20,26 @@
 }
 @end
 
+// A timestamped batch of float64 samples, kept as the raw bytes of the
+// samples so that it is encoded and decoded without boxing each sample.
+@interface SensorBatch : NSObject
+@property(atomic, readonly) SInt64 timestamp;
+@property(atomic, readonly, strong, nonnull) FlutterStandardTypedData* samples;
+- (instancetype)initWithTimestamp:(SInt64)timestamp samples:(FlutterStandardTypedData*)samples;
+@end
+
+@implementation SensorBatch
+- (instancetype)initWithTimestamp:(SInt64)timestamp samples:(FlutterStandardTypedData*)samples {
+  self = [super init];
+  _timestamp = timestamp;
+  _samples = samples;
+  return self;
+}
+@end
+
 const UInt8 DATE = 128;
 const UInt8 PAIR = 129;
+const UInt8 SENSOR_BATCH = 130;
 
 @interface ExtendedWriter : FlutterStandardWriter
 - (void)writeValue:(id)value;
@@ -40,6 +58,14 @@ const UInt8 PAIR = 129;
     [self writeByte:PAIR];
     [self writeValue:pair.left];
     [self writeValue:pair.right];
+  } else if ([value isKindOfClass:[SensorBatch class]]) {
+    SensorBatch* batch = value;
+    SInt64 timestamp = batch.timestamp;
+    [self writeByte:SENSOR_BATCH];
+    [self writeBytes:&timestamp length:8];
+    [self writeSize:batch.samples.elementCount];
+    [self writeAlignment:8];
+    [self writeData:batch.samples.data];
   } else {
     [super writeValue:value];
   }
@@ -62,6 +88,15 @@ const UInt8 PAIR = 129;
     case PAIR: {
       return [[Pair alloc] initWithLeft:[self readValue] right:[self readValue]];
     }
+    case SENSOR_BATCH: {
+      SInt64 timestamp;
+      [self readBytes:&timestamp length:8];
+      UInt32 count = [self readSize];
+      [self readAlignment:8];
+      NSData* data = [self readData:count * 8];
+      return [[SensorBatch alloc] initWithTimestamp:timestamp
+                                            samples:[FlutterStandardTypedData typedDataWithFloat64:data]];
+    }
     default: return [super readValueOfType:type];
   }
 }
@@ -114,6 +149,22 @@ const UInt8 PAIR = 129;
     [FlutterMethodChannel methodChannelWithName:@"std-method"
                                 binaryMessenger:flutterController
                                           codec:[FlutterStandardMethodCodec codecWithReaderWriter:extendedReaderWriter]]];
+  [self setupEchoOnChannel:
+    [FlutterBasicMessageChannel messageChannelWithName:@"binary-echo"
+                                       binaryMessenger:flutterController
+                                                 codec:[FlutterBinaryCodec sharedInstance]]];
+  [self setupEchoOnChannel:
+    [FlutterBasicMessageChannel messageChannelWithName:@"string-echo"
+                                       binaryMessenger:flutterController
+                                                 codec:[FlutterStringCodec sharedInstance]]];
+  [self setupEchoOnChannel:
+    [FlutterBasicMessageChannel messageChannelWithName:@"json-echo"
+                                       binaryMessenger:flutterController
+                                                 codec:[FlutterJSONMessageCodec sharedInstance]]];
+  [self setupEchoOnChannel:
+    [FlutterBasicMessageChannel messageChannelWithName:@"std-echo"
+                                       binaryMessenger:flutterController
+                                                 codec:[FlutterStandardMessageCodec sharedInstance]]];
   return [super application:application didFinishLaunchingWithOptions:launchOptions];
 }
 
@@ -126,6 +177,14 @@ const UInt8 PAIR = 129;
   }];
 }
 
+// Replies to each message with the message itself. Used by the benchmarks in
+// lib/benchmark.dart.
+- (void)setupEchoOnChannel:(FlutterBasicMessageChannel*)channel {
+  [channel setMessageHandler:^(id message, FlutterReply reply) {
+    reply(message);
+  }];
+}
+
 - (void)setupMethodCallSuccessHandshakeOnChannel:(FlutterMethodChannel*)channel {
   [channel setMethodCallHandler:^(FlutterMethodCall* call, FlutterResult result) {
     if ([call.method isEqual:@"success"]) {
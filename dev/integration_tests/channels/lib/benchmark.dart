@@ -0,0 +1,28 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:convert';
+
+import 'package:flutter/material.dart';
+import 'package:flutter_driver/driver_extension.dart';
+
+import 'src/channel_benchmarks.dart';
+
+/// Runs the platform channel benchmarks when the driver asks for them, and
+/// returns the results as JSON.
+void main() {
+  enableFlutterDriverExtension(handler: (String message) async {
+    return json.encode(await runChannelBenchmarks());
+  });
+  runApp(
+    const MaterialApp(
+      title: 'Channels Benchmark',
+      home: Scaffold(
+        body: Center(
+          child: Text('Channels Benchmark'),
+        ),
+      ),
+    ),
+  );
+}
@@ -11,6 +11,7 @@ import 'package:flutter_driver/driver_extension.dart';
 import 'src/basic_messaging.dart';
 import 'src/method_calls.dart';
 import 'src/pair.dart';
+import 'src/sensor_batch.dart';
 import 'src/test_step.dart';
 
 void main() {
@@ -71,6 +72,18 @@ class _TestAppState extends State<TestApp> {
     double.maxFinite,
     double.infinity,
   ]);
+  static final SensorBatch aSensorBatch =
+      SensorBatch(1520777802314, Float64List.fromList(<double>[
+    double.nan,
+    -1.5,
+    0.0,
+    1.5,
+    double.infinity,
+  ]));
+  /// 4 MB worth of samples, sent boxed, as typed data, and as a sensor batch.
+  static final Float64List manySamples = Float64List.fromList(
+    List<double>.generate(512 * 1024, (int i) => i / 3.0),
+  );
   static final dynamic aCompoundUnknownValue = <dynamic>[
     anUnknownValue,
     Pair(anUnknownValue, aList),
@@ -148,6 +161,13 @@ class _TestAppState extends State<TestApp> {
     () => basicStandardHandshake(aMap),
     () => basicStandardHandshake(anUnknownValue),
     () => basicStandardHandshake(aCompoundUnknownValue),
+    () => basicStandardHandshake(aSensorBatch),
+    () => basicStandardHandshake(<dynamic>[aSensorBatch, aSensorBatch]),
+    () => basicStandardThroughput(
+        'List<double>', List<double>.from(manySamples)),
+    () => basicStandardThroughput('Float64List', manySamples),
+    () => basicStandardThroughput(
+        'SensorBatch', SensorBatch(1520777802314, manySamples)),
     () => basicBinaryMessageToUnknownChannel(),
     () => basicStringMessageToUnknownChannel(),
     () => basicJsonMessageToUnknownChannel(),
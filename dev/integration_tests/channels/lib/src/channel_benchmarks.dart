@@ -0,0 +1,120 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:async';
+import 'dart:typed_data';
+
+import 'package:flutter/services.dart';
+
+/// Payload sizes in bytes, from 16 B to 16 MB.
+const List<int> payloadSizes = <int>[
+  16,
+  256,
+  4 * 1024,
+  64 * 1024,
+  1024 * 1024,
+  16 * 1024 * 1024,
+];
+
+/// Bytes sent per codec and payload size, which sets the iteration count
+/// for each case between [_minIterations] and [_maxIterations].
+const int _bytesPerCase = 64 * 1024 * 1024;
+const int _minIterations = 10;
+const int _maxIterations = 1000;
+const int _warmUpIterations = 5;
+
+/// A codec under benchmark, and how to make a payload of a given size for it.
+class _BenchmarkedCodec {
+  const _BenchmarkedCodec(this.name, this.channel, this.payloadOfSize);
+
+  final String name;
+  final BasicMessageChannel<dynamic> channel;
+  final dynamic Function(int size) payloadOfSize;
+}
+
+/// The codecs to benchmark. The platform side replies to every message on
+/// these channels with the message itself.
+final List<_BenchmarkedCodec> _codecs = <_BenchmarkedCodec>[
+  _BenchmarkedCodec(
+    'binary',
+    const BasicMessageChannel<ByteData>('binary-echo', BinaryCodec()),
+    (int size) => ByteData(size),
+  ),
+  _BenchmarkedCodec(
+    'string',
+    const BasicMessageChannel<String>('string-echo', StringCodec()),
+    (int size) => 'x' * size,
+  ),
+  _BenchmarkedCodec(
+    'json',
+    const BasicMessageChannel<dynamic>('json-echo', JSONMessageCodec()),
+    (int size) => 'x' * size,
+  ),
+  _BenchmarkedCodec(
+    'standard',
+    const BasicMessageChannel<dynamic>('std-echo', StandardMessageCodec()),
+    (int size) => Uint8List(size),
+  ),
+];
+
+/// Measures round-trip latency and message rate for every codec and payload
+/// size.
+///
+/// Messages are sent one at a time, each after the previous reply arrived.
+/// The results are keyed by codec and payload size, for example
+/// `standard_4KB_p90_micros` and `standard_4KB_messages_per_second`.
+Future<Map<String, double>> runChannelBenchmarks() async {
+  final Map<String, double> results = <String, double>{};
+  for (final _BenchmarkedCodec codec in _codecs) {
+    for (final int size in payloadSizes) {
+      final dynamic payload = codec.payloadOfSize(size);
+      final int iterations =
+          (_bytesPerCase ~/ size).clamp(_minIterations, _maxIterations) as int;
+      for (int i = 0; i < _warmUpIterations; i++)
+        await _send(codec, payload);
+
+      final List<int> latencies = <int>[];
+      final Stopwatch total = Stopwatch()..start();
+      final Stopwatch watch = Stopwatch();
+      for (int i = 0; i < iterations; i++) {
+        watch
+          ..reset()
+          ..start();
+        await _send(codec, payload);
+        watch.stop();
+        latencies.add(watch.elapsedMicroseconds);
+      }
+      total.stop();
+      latencies.sort();
+
+      final String key = '${codec.name}_${_sizeName(size)}';
+      results['${key}_p50_micros'] = _percentile(latencies, 0.5);
+      results['${key}_p90_micros'] = _percentile(latencies, 0.9);
+      results['${key}_p99_micros'] = _percentile(latencies, 0.99);
+      results['${key}_messages_per_second'] =
+          iterations * 1e6 / total.elapsedMicroseconds;
+    }
+  }
+  return results;
+}
+
+Future<void> _send(_BenchmarkedCodec codec, dynamic payload) async {
+  final dynamic reply = await codec.channel.send(payload);
+  if (reply == null)
+    throw StateError('No reply on ${codec.channel.name}');
+}
+
+/// Returns the value at [fraction] of the sorted [values].
+double _percentile(List<int> values, double fraction) {
+  final int index = ((values.length - 1) * fraction).round();
+  return values[index].toDouble();
+}
+
+String _sizeName(int size) {
+  if (size >= 1024 * 1024)
+    return '${size ~/ (1024 * 1024)}MB';
+  if (size >= 1024)
+    return '${size ~/ 1024}KB';
+  return '${size}B';
+}
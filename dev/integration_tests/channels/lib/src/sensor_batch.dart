@@ -0,0 +1,21 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:typed_data';
+
+/// A timestamped batch of sensor samples. Used for testing custom codecs
+/// with large typed payloads.
+///
+/// The samples are encoded as a single block of raw bytes rather than as a
+/// list of individually encoded doubles, and decoded as a view on the
+/// incoming message.
+class SensorBatch {
+  SensorBatch(this.timestamp, this.samples);
+
+  final int timestamp;
+  final Float64List samples;
+
+  @override
+  String toString() => 'SensorBatch[$timestamp, ${samples.length} samples]';
+}
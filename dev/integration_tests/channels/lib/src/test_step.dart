@@ -8,6 +8,7 @@ import 'dart:typed_data';
 import 'package:flutter/material.dart';
 
 import 'pair.dart';
+import 'sensor_batch.dart';
 
 enum TestStatus { ok, pending, failed, complete }
 
@@ -151,6 +152,8 @@ bool _deepEquals(dynamic a, dynamic b) {
     return b is Map && _deepEqualsMap(a, b);
   if (a is Pair)
     return b is Pair && _deepEqualsPair(a, b);
+  if (a is SensorBatch)
+    return b is SensorBatch && _deepEqualsSensorBatch(a, b);
   return false;
 }
 
@@ -184,3 +187,7 @@ bool _deepEqualsMap(Map<dynamic, dynamic> a, Map<dynamic, dynamic> b) {
 bool _deepEqualsPair(Pair a, Pair b) {
   return _deepEquals(a.left, b.left) && _deepEquals(a.right, b.right);
 }
+
+bool _deepEqualsSensorBatch(SensorBatch a, SensorBatch b) {
+  return a.timestamp == b.timestamp && _deepEqualsList(a.samples, b.samples);
+}
@@ -0,0 +1,32 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:io';
+
+import 'package:flutter_driver/flutter_driver.dart';
+import 'package:test/test.dart' hide TypeMatcher, isInstanceOf;
+
+void main() {
+  group('channel benchmarks', () {
+    FlutterDriver driver;
+
+    setUpAll(() async {
+      driver = await FlutterDriver.connect();
+    });
+
+    test('measure', () async {
+      final String results = await driver.requestData(
+        'run',
+        timeout: const Duration(minutes: 10),
+      );
+      File('$testOutputsDirectory/channels_benchmark.json')
+        ..createSync(recursive: true)
+        ..writeAsStringSync(results);
+    }, timeout: const Timeout(Duration(minutes: 10)));
+
+    tearDownAll(() async {
+      driver?.close();
+    });
+  });
+}
@@ -4,23 +4,79 @@
 
 #import "AppDelegate.h"
 
+#import <CoreVideo/CoreVideo.h>
+#import <QuartzCore/QuartzCore.h>
+
+#import "TexturePool.h"
+
+// Default texture size, used when 'start' is only given a frame rate.
+static const size_t kDefaultTextureWidth = 1280;
+static const size_t kDefaultTextureHeight = 720;
+
+// How frames get from the producer to the engine.
+typedef NS_ENUM(NSInteger, ProducerMode) {
+  // Frames are drawn directly into a triple-buffered TexturePool.
+  ProducerModePool,
+  // Frames are drawn into a private staging buffer, then copied into a newly
+  // allocated pixel buffer, as producers without a reusable buffer do.
+  ProducerModeCopy,
+};
+
+// What paces frame production.
+typedef NS_ENUM(NSInteger, ProducerPacing) {
+  // An NSTimer at the requested frame rate, which drifts against the display
+  // refresh.
+  ProducerPacingTimer,
+  // A CADisplayLink, so that frames are produced in phase with vsync (at up to
+  // 120 Hz on ProMotion displays), optionally delayed by a phase offset.
+  ProducerPacingDisplayLink,
+};
+
 @interface AppDelegate ()
   @property (atomic) uint64_t textureId;
-  @property (atomic) int framesProduced;
-  @property (atomic) int framesConsumed;
-  @property (atomic) int lastFrameConsumed;
   @property (atomic) double startTime;
   @property (atomic) double endTime;
-  @property (atomic) double frameRate;
-  @property (atomic) double frameStartTime;
+  @property (atomic) double frameInterval;
   @property (atomic) NSTimer* timer;
+  @property (atomic) CADisplayLink* displayLink;
+  @property (atomic) double phaseOffset;
 
   - (void)tick:(NSTimer*)timer;
+  - (void)onDisplayLink:(CADisplayLink*)displayLink;
 @end
 
-@implementation AppDelegate
+@implementation AppDelegate {
+  // Guards everything below, which is shared between the producer (main
+  // thread) and copyPixelBuffer (raster thread).
+  NSObject* _lock;
+  ProducerMode _mode;
+  ProducerPacing _pacing;
+  size_t _width;
+  size_t _height;
+  TexturePool* _texturePool;
+  // In copy mode, the staging buffer frames are drawn into, and the most
+  // recently produced frame if it hasn't been consumed yet.
+  NSMutableData* _stagingBuffer;
+  CVPixelBufferRef _pendingFrame;
+  // When the pending frame (in either mode) was produced.
+  double _pendingFrameTime;
+  // Frame statistics since the last 'start'.
+  int64_t _framesProduced;
+  int64_t _framesConsumed;
+  int64_t _framesDropped;
+  int64_t _framesDuplicated;
+  int64_t _framesLate;
+  int64_t _framesSkipped;
+  double _producerTime;
+  // In display link mode, the total time from vsync to each frame being
+  // produced.
+  double _vsyncToProducedTime;
+  NSMutableArray<NSNumber*>* _latencies;
+}
 
 - (BOOL)application:(UIApplication *)application didFinishLaunchingWithOptions:(NSDictionary *)launchOptions {
+  _lock = [[NSObject alloc] init];
+  _latencies = [[NSMutableArray alloc] init];
   FlutterViewController* flutterController =
       (FlutterViewController*)self.window.rootViewController;
   FlutterMethodChannel* channel =
@@ -28,24 +84,48 @@
                                   binaryMessenger:flutterController];
   [channel setMethodCallHandler:^(FlutterMethodCall* call, FlutterResult result) {
       if ([@"start" isEqualToString:call.method]) {
-        _framesProduced = 0;
-        _framesConsumed = 0;
-        _frameRate = 1.0 / [(NSNumber*) call.arguments intValue];
-        _timer = [NSTimer scheduledTimerWithTimeInterval:_frameRate
-                                                  target:self
-                                                selector:@selector(tick:)
-                                                userInfo:nil
-                                                 repeats:YES];
-        _startTime = [[NSDate date] timeIntervalSince1970];
+        // Either a frame rate, or a map with a 'frameRate' and optionally the
+        // texture 'width' and 'height' in pixels, the producer 'mode' ('pool'
+        // or 'copy'), the 'pacing' ('timer' or 'displayLink'), and for display
+        // link pacing, the 'phaseOffsetMs' after vsync to produce frames at.
+        NSDictionary* arguments = call.arguments;
+        if (![arguments isKindOfClass:[NSDictionary class]]) {
+          arguments = @{@"frameRate" : call.arguments};
+        }
+        NSNumber* width = arguments[@"width"] ?: @(kDefaultTextureWidth);
+        NSNumber* height = arguments[@"height"] ?: @(kDefaultTextureHeight);
+        ProducerMode mode =
+            [@"copy" isEqual:arguments[@"mode"]] ? ProducerModeCopy : ProducerModePool;
+        ProducerPacing pacing = [@"displayLink" isEqual:arguments[@"pacing"]]
+            ? ProducerPacingDisplayLink
+            : ProducerPacingTimer;
+        _phaseOffset = [arguments[@"phaseOffsetMs"] doubleValue] / 1000.0;
+        if (![self startProducingWithFrameRate:[arguments[@"frameRate"] intValue]
+                                         width:width.unsignedLongValue
+                                        height:height.unsignedLongValue
+                                          mode:mode
+                                        pacing:pacing]) {
+          result([FlutterError errorWithCode:@"buffer_error"
+                                     message:@"Unable to allocate texture buffers"
+                                     details:nil]);
+          return;
+        }
         result(nil);
       } else if ([@"stop" isEqualToString:call.method]) {
         [_timer invalidate];
-        _endTime = [[NSDate date] timeIntervalSince1970];
+        [_displayLink invalidate];
+        _endTime = CACurrentMediaTime();
         result(nil);
       } else if ([@"getProducedFrameRate" isEqualToString:call.method]) {
-        result(@(_framesProduced / (_endTime - _startTime)));
+        @synchronized(_lock) {
+          result(@(_framesProduced / (_endTime - _startTime)));
+        }
       } else if ([@"getConsumedFrameRate" isEqualToString:call.method]) {
-        result(@(_framesConsumed / (_endTime - _startTime)));
+        @synchronized(_lock) {
+          result(@(_framesConsumed / (_endTime - _startTime)));
+        }
+      } else if ([@"getStats" isEqualToString:call.method]) {
+        result([self stats]);
       } else {
         result(FlutterMethodNotImplemented);
       }
@@ -54,23 +134,257 @@
   return [super application:application didFinishLaunchingWithOptions:launchOptions];
 }
 
+- (BOOL)startProducingWithFrameRate:(int)frameRate
+                              width:(size_t)width
+                             height:(size_t)height
+                               mode:(ProducerMode)mode
+                             pacing:(ProducerPacing)pacing {
+  [_timer invalidate];
+  _timer = nil;
+  [_displayLink invalidate];
+  _displayLink = nil;
+  @synchronized(_lock) {
+    CVPixelBufferRelease(_pendingFrame);
+    _pendingFrame = NULL;
+    _texturePool = nil;
+    _stagingBuffer = nil;
+    if (mode == ProducerModePool) {
+      _texturePool = [[TexturePool alloc] initWithWidth:width height:height];
+      if (!_texturePool) {
+        return NO;
+      }
+    } else {
+      _stagingBuffer = [NSMutableData dataWithLength:width * height * 4];
+    }
+    _mode = mode;
+    _pacing = pacing;
+    _width = width;
+    _height = height;
+    _framesProduced = 0;
+    _framesConsumed = 0;
+    _framesDropped = 0;
+    _framesDuplicated = 0;
+    _framesLate = 0;
+    _framesSkipped = 0;
+    _producerTime = 0;
+    _vsyncToProducedTime = 0;
+    [_latencies removeAllObjects];
+  }
+  _frameInterval = 1.0 / frameRate;
+  if (pacing == ProducerPacingDisplayLink) {
+    _displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(onDisplayLink:)];
+    if ([_displayLink respondsToSelector:@selector(setPreferredFramesPerSecond:)]) {
+      // Clamped to the display's maximum refresh rate.
+      _displayLink.preferredFramesPerSecond = frameRate;
+    } else {
+      _displayLink.frameInterval = MAX(1, (NSInteger)round(60.0 / frameRate));
+    }
+    [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+  } else {
+    _timer = [NSTimer scheduledTimerWithTimeInterval:_frameInterval
+                                              target:self
+                                            selector:@selector(tick:)
+                                            userInfo:nil
+                                             repeats:YES];
+  }
+  _startTime = CACurrentMediaTime();
+  return YES;
+}
+
 - (void)tick:(NSTimer*)timer {
+  [self produceFrame];
+}
+
+- (void)onDisplayLink:(CADisplayLink*)displayLink {
+  // The time of the vsync this callback is for.
+  double vsyncTime = displayLink.timestamp;
+  if (_phaseOffset <= 0) {
+    if ([self produceFrame]) {
+      [self recordVsyncPhase:vsyncTime];
+    }
+    return;
+  }
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(_phaseOffset * NSEC_PER_SEC)),
+                 dispatch_get_main_queue(), ^{
+                   if (displayLink == _displayLink && [self produceFrame]) {
+                     [self recordVsyncPhase:vsyncTime];
+                   }
+                 });
+}
+
+// Records the time from |vsyncTime| to the frame that was just produced.
+- (void)recordVsyncPhase:(double)vsyncTime {
+  @synchronized(_lock) {
+    _vsyncToProducedTime += _pendingFrameTime - vsyncTime;
+  }
+}
+
+// Produces a frame and notifies the engine, returning NO if no frame could
+// be produced.
+- (BOOL)produceFrame {
+  double producerStart = CACurrentMediaTime();
+  BOOL produced = _mode == ProducerModePool ? [self produceIntoPool] : [self produceByCopying];
+  if (!produced) {
+    return NO;
+  }
+  @synchronized(_lock) {
+    _producerTime += CACurrentMediaTime() - producerStart;
+  }
   FlutterViewController* flutterController =
       (FlutterViewController*)self.window.rootViewController;
   [flutterController textureFrameAvailable:_textureId];
-  _frameStartTime = [[NSDate date] timeIntervalSince1970];
-  // We just pretend to be producing a frame.
-  _framesProduced++;
+  return YES;
+}
+
+// Draws the next frame directly into a free pool buffer.
+- (BOOL)produceIntoPool {
+  TexturePool* pool;
+  int64_t frameIndex;
+  @synchronized(_lock) {
+    pool = _texturePool;
+    frameIndex = _framesProduced + 1;
+  }
+  CVPixelBufferRef buffer = [pool dequeueBuffer];
+  if (!buffer) {
+    @synchronized(_lock) {
+      _framesSkipped++;
+    }
+    return NO;
+  }
+  CVPixelBufferLockBaseAddress(buffer, 0);
+  [self drawFrame:frameIndex
+             into:CVPixelBufferGetBaseAddress(buffer)
+      bytesPerRow:CVPixelBufferGetBytesPerRow(buffer)];
+  CVPixelBufferUnlockBaseAddress(buffer, 0);
+  @synchronized(_lock) {
+    // A frame that is replaced before the engine takes it is never shown.
+    if ([pool enqueueBuffer:buffer]) {
+      _framesDropped++;
+    }
+    _pendingFrameTime = CACurrentMediaTime();
+    _framesProduced = frameIndex;
+  }
+  return YES;
+}
+
+// Draws the next frame into the staging buffer, and copies it into a newly
+// allocated pixel buffer.
+- (BOOL)produceByCopying {
+  NSMutableData* staging;
+  int64_t frameIndex;
+  @synchronized(_lock) {
+    staging = _stagingBuffer;
+    frameIndex = _framesProduced + 1;
+  }
+  size_t stagingBytesPerRow = _width * 4;
+  [self drawFrame:frameIndex into:staging.mutableBytes bytesPerRow:stagingBytesPerRow];
+
+  NSDictionary* attributes = @{
+    (id)kCVPixelBufferIOSurfacePropertiesKey : @{},
+    (id)kCVPixelBufferOpenGLESCompatibilityKey : @YES,
+  };
+  CVPixelBufferRef frame = NULL;
+  if (CVPixelBufferCreate(kCFAllocatorDefault, _width, _height, kCVPixelFormatType_32BGRA,
+                          (__bridge CFDictionaryRef)attributes, &frame) != kCVReturnSuccess) {
+    @synchronized(_lock) {
+      _framesSkipped++;
+    }
+    return NO;
+  }
+  CVPixelBufferLockBaseAddress(frame, 0);
+  uint8_t* destination = CVPixelBufferGetBaseAddress(frame);
+  size_t destinationBytesPerRow = CVPixelBufferGetBytesPerRow(frame);
+  const uint8_t* source = staging.bytes;
+  for (size_t y = 0; y < _height; y++) {
+    memcpy(destination + y * destinationBytesPerRow, source + y * stagingBytesPerRow,
+           stagingBytesPerRow);
+  }
+  CVPixelBufferUnlockBaseAddress(frame, 0);
+
+  @synchronized(_lock) {
+    if (_pendingFrame) {
+      _framesDropped++;
+      CVPixelBufferRelease(_pendingFrame);
+    }
+    _pendingFrame = frame;
+    _pendingFrameTime = CACurrentMediaTime();
+    _framesProduced = frameIndex;
+  }
+  return YES;
+}
+
+// Fills a BGRA frame with a solid color that changes every frame, so that
+// every byte of every frame is actually written, as a real producer would.
+- (void)drawFrame:(int64_t)frameIndex into:(uint8_t*)base bytesPerRow:(size_t)bytesPerRow {
+  uint32_t blue = (uint32_t)(frameIndex * 7 % 256);
+  uint32_t green = (uint32_t)(frameIndex * 3 % 256);
+  uint32_t pixel = 0xFF000000 | (0x80 << 16) | (green << 8) | blue;
+  for (size_t y = 0; y < _height; y++) {
+    uint32_t* row = (uint32_t*)(base + y * bytesPerRow);
+    for (size_t x = 0; x < _width; x++) {
+      row[x] = pixel;
+    }
+  }
 }
 
 - (CVPixelBufferRef)copyPixelBuffer {
-  double now = [[NSDate date] timeIntervalSince1970];
-  if (now < _frameStartTime
-      || _frameStartTime + _frameRate < now
-      || _framesProduced == _lastFrameConsumed) return nil;
-  _framesConsumed++;
-  _lastFrameConsumed = _framesProduced;
-  // We just pretend to be handing over the produced frame to the consumer.
-  return nil;
+  double now = CACurrentMediaTime();
+  @synchronized(_lock) {
+    CVPixelBufferRef frame = NULL;
+    if (_mode == ProducerModePool) {
+      frame = [_texturePool copyPendingBuffer];
+    } else {
+      // Ownership passes to the engine.
+      frame = _pendingFrame;
+      _pendingFrame = NULL;
+    }
+    if (!frame) {
+      // The engine asked for a frame without a new one being available, so
+      // it keeps showing the previous one.
+      _framesDuplicated++;
+      return NULL;
+    }
+    double latency = now - _pendingFrameTime;
+    [_latencies addObject:@(latency)];
+    if (latency > _frameInterval) {
+      _framesLate++;
+    }
+    _framesConsumed++;
+    return frame;
+  }
+}
+
+// Returns a summary of the frames produced and consumed since the last 'start',
+// with latencies (from production to the engine copying the frame for
+// compositing) and the average time to produce a frame in milliseconds.
+- (NSDictionary*)stats {
+  @synchronized(_lock) {
+    NSArray<NSNumber*>* sorted = [_latencies sortedArrayUsingSelector:@selector(compare:)];
+    double (^percentile)(double) = ^double(double p) {
+      if (sorted.count == 0) {
+        return 0.0;
+      }
+      NSUInteger index = MIN(sorted.count - 1, (NSUInteger)(p / 100.0 * sorted.count));
+      return sorted[index].doubleValue * 1000.0;
+    };
+    return @{
+      @"mode" : _mode == ProducerModePool ? @"pool" : @"copy",
+      @"produced" : @(_framesProduced),
+      @"consumed" : @(_framesConsumed),
+      @"dropped" : @(_framesDropped),
+      @"duplicated" : @(_framesDuplicated),
+      @"late" : @(_framesLate),
+      @"skipped" : @(_framesSkipped),
+      @"producerTimeMs" : @(_framesProduced > 0 ? _producerTime * 1000.0 / _framesProduced : 0.0),
+      @"pacing" : _pacing == ProducerPacingDisplayLink ? @"displayLink" : @"timer",
+      @"vsyncToProducedMs" :
+          @(_framesProduced > 0 ? _vsyncToProducedTime * 1000.0 / _framesProduced : 0.0),
+      @"latencyP50Ms" : @(percentile(50)),
+      @"latencyP90Ms" : @(percentile(90)),
+      @"latencyP99Ms" : @(percentile(99)),
+      @"latencyMaxMs" : @(sorted.count > 0 ? sorted.lastObject.doubleValue * 1000.0 : 0.0),
+      @"durationSeconds" : @(_endTime - _startTime),
+    };
+  }
 }
 @end
@@ -0,0 +1,37 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <CoreVideo/CoreVideo.h>
+#import <Foundation/Foundation.h>
+
+// A fixed set of three IOSurface-backed pixel buffers, which a producer draws
+// into directly and a FlutterTexture hands to the engine without copying.
+//
+// At any time one buffer may be displayed by the engine, one may be pending
+// (produced but not yet taken by the engine), and the third is free for the
+// producer, so producing never allocates and never waits for the engine.
+//
+// All methods are thread-safe; the producer and the engine's copyPixelBuffer
+// calls are typically on different threads.
+@interface TexturePool : NSObject
+
+// Returns nil if the buffers can't be allocated.
+- (instancetype)initWithWidth:(size_t)width height:(size_t)height;
+
+// Returns a buffer that is neither pending nor displayed, for the producer to
+// draw into, or NULL if one is already being drawn into. The pool retains
+// ownership; the buffer must be returned with enqueueBuffer:.
+- (CVPixelBufferRef)dequeueBuffer;
+
+// Makes |buffer|, from dequeueBuffer, the pending frame. Returns YES if this
+// replaced a pending frame that the engine never took, which is then free
+// again.
+- (BOOL)enqueueBuffer:(CVPixelBufferRef)buffer;
+
+// Returns the pending frame with a +1 reference for the engine, as required
+// by -[FlutterTexture copyPixelBuffer], or NULL if there is none. It becomes
+// the displayed buffer, and the previously displayed buffer is freed.
+- (CVPixelBufferRef)copyPendingBuffer;
+
+@end
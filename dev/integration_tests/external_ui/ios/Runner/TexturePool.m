@@ -0,0 +1,88 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "TexturePool.h"
+
+enum { kBufferCount = 3 };
+
+@implementation TexturePool {
+  CVPixelBufferRef _buffers[kBufferCount];
+  // Indices into _buffers, or -1.
+  int _writing;
+  int _pending;
+  int _displayed;
+}
+
+- (instancetype)initWithWidth:(size_t)width height:(size_t)height {
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+  NSDictionary* attributes = @{
+    // IOSurface backing lets the engine create a GL texture from the buffer
+    // without copying it.
+    (id)kCVPixelBufferIOSurfacePropertiesKey : @{},
+    (id)kCVPixelBufferOpenGLESCompatibilityKey : @YES,
+  };
+  for (int i = 0; i < kBufferCount; i++) {
+    if (CVPixelBufferCreate(kCFAllocatorDefault, width, height, kCVPixelFormatType_32BGRA,
+                            (__bridge CFDictionaryRef)attributes,
+                            &_buffers[i]) != kCVReturnSuccess) {
+      _buffers[i] = NULL;
+      return nil;
+    }
+  }
+  _writing = -1;
+  _pending = -1;
+  _displayed = -1;
+  return self;
+}
+
+- (void)dealloc {
+  for (int i = 0; i < kBufferCount; i++) {
+    CVPixelBufferRelease(_buffers[i]);
+  }
+}
+
+- (CVPixelBufferRef)dequeueBuffer {
+  @synchronized(self) {
+    if (_writing != -1) {
+      return NULL;
+    }
+    for (int i = 0; i < kBufferCount; i++) {
+      if (i != _pending && i != _displayed) {
+        _writing = i;
+        return _buffers[i];
+      }
+    }
+    return NULL;
+  }
+}
+
+- (BOOL)enqueueBuffer:(CVPixelBufferRef)buffer {
+  @synchronized(self) {
+    NSAssert(_writing != -1 && _buffers[_writing] == buffer,
+             @"enqueueBuffer: must be passed the buffer from dequeueBuffer");
+    BOOL replaced = _pending != -1;
+    _pending = _writing;
+    _writing = -1;
+    return replaced;
+  }
+}
+
+- (CVPixelBufferRef)copyPendingBuffer {
+  @synchronized(self) {
+    if (_pending == -1) {
+      return NULL;
+    }
+    // The engine releases the previously displayed buffer when it receives
+    // this one. Locking a buffer for writing synchronizes with any GPU reads
+    // of it that are still in flight, so it can be reused immediately.
+    _displayed = _pending;
+    _pending = -1;
+    return CVPixelBufferRetain(_buffers[_displayed]);
+  }
+}
+
+@end
@@ -21,6 +21,24 @@ class MyApp extends StatefulWidget {
 
 const MethodChannel channel = MethodChannel('texture');
 
+/// The size of the texture frames produced by the platform side, in pixels.
+const int textureWidth = 1280;
+const int textureHeight = 720;
+
+/// How the iOS side hands frames to the engine: 'pool' draws into a reusable
+/// triple-buffered set of IOSurfaces, and 'copy' copies each frame into a
+/// newly allocated pixel buffer. Pass `--dart-define=producerMode=copy` to
+/// compare the two.
+const String producerMode = String.fromEnvironment('producerMode', defaultValue: 'pool');
+
+/// What paces production on the iOS side: 'timer' or 'displayLink'. Display
+/// link pacing can't exceed the display refresh rate, so the 2x speed phase
+/// is capped at the refresh rate. Pass e.g.
+/// `--dart-define=producerPacing=displayLink --dart-define=phaseOffsetMs=4`
+/// to produce frames 4ms after each vsync.
+const String producerPacing = String.fromEnvironment('producerPacing', defaultValue: 'timer');
+const int phaseOffsetMs = int.fromEnvironment('phaseOffsetMs', defaultValue: 0);
+
 enum FrameState { initial, slow, afterSlow, fast, afterFast }
 
 class MyAppState extends State<MyApp> with SingleTickerProviderStateMixin {
@@ -33,10 +51,27 @@ class MyAppState extends State<MyApp> with SingleTickerProviderStateMixin {
   Future<void> _summarizeStats() async {
     final double framesProduced = await channel.invokeMethod('getProducedFrameRate');
     final double framesConsumed = await channel.invokeMethod('getConsumedFrameRate');
+    final Map<dynamic, dynamic> stats = await channel.invokeMethod('getStats');
     _summary = '''
 Produced: ${framesProduced.toStringAsFixed(1)}fps
 Consumed: ${framesConsumed.toStringAsFixed(1)}fps
-Widget builds: $_widgetBuilds''';
+Widget builds: $_widgetBuilds
+Dropped: ${stats['dropped']} Duplicated: ${stats['duplicated']} Late: ${stats['late']}
+Latency p50/p90/p99: ${_formatMilliseconds(stats['latencyP50Ms'])}/${_formatMilliseconds(stats['latencyP90Ms'])}/${_formatMilliseconds(stats['latencyP99Ms'])}ms''';
+    debugPrint('Texture stats: $stats');
+  }
+
+  static String _formatMilliseconds(dynamic value) => (value as double).toStringAsFixed(1);
+
+  Future<void> _startProducing(int frameRate) {
+    return channel.invokeMethod<void>('start', <String, dynamic>{
+      'frameRate': frameRate,
+      'width': textureWidth,
+      'height': textureHeight,
+      'mode': producerMode,
+      'pacing': producerPacing,
+      'phaseOffsetMs': phaseOffsetMs,
+    });
   }
 
   Future<void> _nextState() async {
@@ -47,7 +82,7 @@ Widget builds: $_widgetBuilds''';
         _summary = 'Producing texture frames at .5x speed...';
         _state = FrameState.slow;
         _icon = Icons.stop;
-        channel.invokeMethod<void>('start', _flutterFrameRate ~/ 2);
+        _startProducing(_flutterFrameRate ~/ 2);
         break;
       case FrameState.slow:
         debugPrint('Stopping .5x speed test...');
@@ -62,7 +97,7 @@ Widget builds: $_widgetBuilds''';
         _summary = 'Producing texture frames at 2x speed...';
         _state = FrameState.fast;
         _icon = Icons.stop;
-        channel.invokeMethod<void>('start', (_flutterFrameRate * 2).toInt());
+        _startProducing((_flutterFrameRate * 2).toInt());
         break;
       case FrameState.fast:
         debugPrint('Stopping 2x speed test...');
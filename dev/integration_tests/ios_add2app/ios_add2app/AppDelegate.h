@@ -5,9 +5,14 @@
 #import <UIKit/UIKit.h>
 #import <Flutter/Flutter.h>
 
+#import "MemoryPressureBridge.h"
+#import "SnapshotPlaceholderCache.h"
+
 @interface AppDelegate : FlutterAppDelegate
 
 @property(nonatomic, strong) FlutterEngine* engine;
 @property(nonatomic, strong) FlutterBasicMessageChannel* reloadMessageChannel;
+@property(nonatomic, readonly) MemoryPressureBridge* memoryPressureBridge;
+@property(nonatomic, readonly) SnapshotPlaceholderCache* snapshotPlaceholderCache;
 
 @end
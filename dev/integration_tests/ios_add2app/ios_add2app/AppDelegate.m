@@ -16,6 +16,8 @@ static NSString *_kReloadChannelName = @"reload";
   UINavigationController *_navigationController;
   FlutterEngine *_engine;
   FlutterBasicMessageChannel *_reloadMessageChannel;
+  MemoryPressureBridge *_memoryPressureBridge;
+  SnapshotPlaceholderCache *_snapshotPlaceholderCache;
 }
 
 - (FlutterEngine *)engine {
@@ -26,6 +28,14 @@ static NSString *_kReloadChannelName = @"reload";
   return _reloadMessageChannel;
 }
 
+- (MemoryPressureBridge *)memoryPressureBridge {
+  return _memoryPressureBridge;
+}
+
+- (SnapshotPlaceholderCache *)snapshotPlaceholderCache {
+  return _snapshotPlaceholderCache;
+}
+
 - (BOOL)application:(UIApplication *)application
     didFinishLaunchingWithOptions:(NSDictionary *)launchOptions {
   self.window = [[UIWindow alloc] initWithFrame:[[UIScreen mainScreen] bounds]];
@@ -38,6 +48,8 @@ static NSString *_kReloadChannelName = @"reload";
 
   _engine = [[FlutterEngine alloc] initWithName:@"test" project:nil];
   [_engine runWithEntrypoint:nil];
+  _memoryPressureBridge = [[MemoryPressureBridge alloc] initWithEngine:_engine];
+  _snapshotPlaceholderCache = [[SnapshotPlaceholderCache alloc] init];
 
   _reloadMessageChannel = [[FlutterBasicMessageChannel alloc]
          initWithName:_kReloadChannelName
@@ -9,7 +9,15 @@ NS_ASSUME_NONNULL_BEGIN
 @interface DualFlutterViewController : UIViewController
 
 @property (readonly, strong, nonatomic) FlutterViewController* topFlutterViewController;
-@property (readonly, strong, nonatomic) FlutterViewController* bottomFlutterViewController;
+@property (readonly, strong, nonatomic, nullable) FlutterViewController* bottomFlutterViewController;
+
+// The cost of each Flutter view, in the order they were spun up. Each entry
+// has the "timeToFirstFrameMillis" from creating the view controller to its
+// first rendered frame, and the "memoryFootprintDeltaBytes" over that time.
+//
+// The bottom view is only created once the top one has rendered, so that the
+// cost of the extra engine can be told apart from the first.
+@property (readonly, strong, nonatomic) NSArray<NSDictionary*>* spinUpMetrics;
 
 @end
 
@@ -3,14 +3,23 @@
 // found in the LICENSE file.
 
 #import <Flutter/Flutter.h>
+#import <QuartzCore/QuartzCore.h>
 
 #import "DualFlutterViewController.h"
+#import "MemoryFootprint.h"
 
 @interface DualFlutterViewController ()
 
 @end
 
-@implementation DualFlutterViewController
+@implementation DualFlutterViewController {
+  UIStackView* _stackView;
+  NSMutableArray<NSDictionary*>* _spinUpMetrics;
+}
+
+- (NSArray<NSDictionary*>*)spinUpMetrics {
+  return [_spinUpMetrics copy];
+}
 
 - (void)viewDidLoad {
   [super viewDidLoad];
@@ -21,25 +30,58 @@
                                                      target:nil
                                                      action:nil];
 
-  UIStackView* stackView = [[UIStackView alloc] initWithFrame:self.view.frame];
-  stackView.axis = UILayoutConstraintAxisVertical;
-  stackView.distribution = UIStackViewDistributionFillEqually;
-  stackView.layoutMargins = UIEdgeInsetsMake(0, 0, 50, 0);
-  stackView.layoutMarginsRelativeArrangement = YES;
-  [self.view addSubview:stackView];
-
-  _topFlutterViewController = [[FlutterViewController alloc] init];
-  _bottomFlutterViewController= [[FlutterViewController alloc] init];
-
-  [_topFlutterViewController setInitialRoute:@"marquee_green"];
-  [self addChildViewController:_topFlutterViewController];
-  [stackView addArrangedSubview:_topFlutterViewController.view];
-  [_topFlutterViewController didMoveToParentViewController:self];
-
-  [_bottomFlutterViewController setInitialRoute:@"marquee_purple"];
-  [self addChildViewController:_bottomFlutterViewController];
-  [stackView addArrangedSubview:_bottomFlutterViewController.view];
-  [_bottomFlutterViewController didMoveToParentViewController:self];
+  _stackView = [[UIStackView alloc] initWithFrame:self.view.frame];
+  _stackView.axis = UILayoutConstraintAxisVertical;
+  _stackView.distribution = UIStackViewDistributionFillEqually;
+  _stackView.layoutMargins = UIEdgeInsetsMake(0, 0, 50, 0);
+  _stackView.layoutMarginsRelativeArrangement = YES;
+  [self.view addSubview:_stackView];
+
+  _spinUpMetrics = [NSMutableArray array];
+  __weak DualFlutterViewController* weakSelf = self;
+  _topFlutterViewController = [self spinUpFlutterViewWithRoute:@"marquee_green"
+                                                  onFirstFrame:^{
+                                                    [weakSelf spinUpBottomFlutterView];
+                                                  }];
+}
+
+- (void)spinUpBottomFlutterView {
+  _bottomFlutterViewController = [self spinUpFlutterViewWithRoute:@"marquee_purple"
+                                                     onFirstFrame:nil];
+}
+
+// Creates a FlutterViewController with its own engine showing |route|, and
+// records its spin-up cost once it has rendered.
+- (FlutterViewController*)spinUpFlutterViewWithRoute:(NSString*)route
+                                        onFirstFrame:(void (^_Nullable)(void))onFirstFrame {
+  uint64_t footprintBefore = CurrentMemoryFootprint();
+  CFTimeInterval start = CACurrentMediaTime();
+
+  FlutterViewController* flutterViewController = [[FlutterViewController alloc] init];
+  [flutterViewController setInitialRoute:route];
+  __weak DualFlutterViewController* weakSelf = self;
+  [flutterViewController setFlutterViewDidRenderCallback:^{
+    DualFlutterViewController* strongSelf = weakSelf;
+    if (!strongSelf) {
+      return;
+    }
+    NSDictionary* metrics = @{
+      @"route" : route,
+      @"timeToFirstFrameMillis" : @((CACurrentMediaTime() - start) * 1000.0),
+      @"memoryFootprintDeltaBytes" :
+          @((int64_t)CurrentMemoryFootprint() - (int64_t)footprintBefore),
+    };
+    NSLog(@"Flutter view spin-up: %@", metrics);
+    [strongSelf->_spinUpMetrics addObject:metrics];
+    if (onFirstFrame) {
+      onFirstFrame();
+    }
+  }];
+
+  [self addChildViewController:flutterViewController];
+  [_stackView addArrangedSubview:flutterViewController.view];
+  [flutterViewController didMoveToParentViewController:self];
+  return flutterViewController;
 }
 
 @end
@@ -8,6 +8,16 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface FullScreenViewController : FlutterViewController
 
+// Whether popping this view controller leaves it set as the engine's view
+// controller, so that pushing it again does not have to reattach. Defaults to
+// NO.
+@property(nonatomic) BOOL keepsEngineAttachedOnPop;
+
+// The route this view controller shows. If set, the app's
+// SnapshotPlaceholderCache takes a snapshot for it when this view controller
+// is popped.
+@property(nonatomic, copy, nullable) NSString* snapshotRoute;
+
 @end
 
 NS_ASSUME_NONNULL_END
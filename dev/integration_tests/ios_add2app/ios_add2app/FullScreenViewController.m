@@ -4,6 +4,8 @@
 
 #import "FullScreenViewController.h"
 
+#import "AppDelegate.h"
+
 @interface FullScreenViewController ()
 
 @end
@@ -18,10 +20,15 @@
 }
 
 -(void)viewWillDisappear:(BOOL)animated {
+  if (self.isMovingFromParentViewController && self.snapshotRoute) {
+    [[(AppDelegate *)[[UIApplication sharedApplication] delegate] snapshotPlaceholderCache]
+        captureViewController:self
+                        route:self.snapshotRoute];
+  }
   [super viewWillDisappear:animated];
   self.navigationController.navigationBarHidden = NO;
   self.navigationController.hidesBarsOnSwipe = NO;
-  if (self.isMovingFromParentViewController) {
+  if (self.isMovingFromParentViewController && !self.keepsEngineAttachedOnPop) {
     // Note that if we were doing things that might cause the VC
     // to disappear (like using the image_picker plugin)
     // we shouldn't do this.  But in this case we know we're
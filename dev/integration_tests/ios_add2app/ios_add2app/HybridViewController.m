@@ -13,6 +13,7 @@
 
 static NSString *_kChannel = @"increment";
 static NSString *_kPing = @"ping";
+static NSString *_kRoute = @"hybrid";
 
 @implementation HybridViewController {
   FlutterBasicMessageChannel *_messageChannel;
@@ -27,6 +28,11 @@ static NSString *_kPing = @"ping";
       reloadMessageChannel];
 }
 
+- (SnapshotPlaceholderCache *)snapshotPlaceholderCache {
+  return [(AppDelegate *)[[UIApplication sharedApplication] delegate]
+      snapshotPlaceholderCache];
+}
+
 - (void)viewDidLoad {
   [super viewDidLoad];
   self.title = @"Hybrid Flutter/Native";
@@ -52,7 +58,10 @@ static NSString *_kPing = @"ping";
       [[FlutterViewController alloc] initWithEngine:[self engine]
                                             nibName:nil
                                              bundle:nil];
-  [[self reloadMessageChannel] sendMessage:@"hybrid"];
+  [[self snapshotPlaceholderCache]
+      installPlaceholderForViewController:_flutterViewController
+                                    route:_kRoute];
+  [[self reloadMessageChannel] sendMessage:_kRoute];
 
   _messageChannel = [[FlutterBasicMessageChannel alloc]
          initWithName:_kChannel
@@ -69,6 +78,14 @@ static NSString *_kPing = @"ping";
   }];
 }
 
+- (void)viewWillDisappear:(BOOL)animated {
+  if (self.isMovingFromParentViewController) {
+    [[self snapshotPlaceholderCache] captureViewController:_flutterViewController
+                                                     route:_kRoute];
+  }
+  [super viewWillDisappear:animated];
+}
+
 - (void)didTapIncrementButton {
   [_messageChannel sendMessage:_kPing];
 }
@@ -9,6 +9,7 @@
 #import "FullScreenViewController.h"
 #import "HybridViewController.h"
 #import "NativeViewController.h"
+#import "ReattachBenchmark.h"
 
 @interface MainViewController ()
 
@@ -42,12 +43,31 @@
   [self addButton:@"Flutter View (Warm)" action:@selector(showFlutterViewWarm)];
   [self addButton:@"Hybrid View (Warm)" action:@selector(showHybridView)];
   [self addButton:@"Dual Flutter View (Cold)" action:@selector(showDualView)];
+  [self addButton:@"Reattach Benchmark" action:@selector(runReattachBenchmark)];
+  [self addButton:[self snapshotPlaceholdersButtonTitle]
+           action:@selector(toggleSnapshotPlaceholders:)];
+}
+
+- (NSString *)snapshotPlaceholdersButtonTitle {
+  return [self snapshotPlaceholderCache].enabled ? @"Snapshot Placeholders: On"
+                                                 : @"Snapshot Placeholders: Off";
+}
+
+- (void)toggleSnapshotPlaceholders:(UIButton *)button {
+  SnapshotPlaceholderCache *cache = [self snapshotPlaceholderCache];
+  cache.enabled = !cache.enabled;
+  [button setTitle:[self snapshotPlaceholdersButtonTitle]
+          forState:UIControlStateNormal];
 }
 
 - (FlutterEngine *)engine {
   return [(AppDelegate *)[[UIApplication sharedApplication] delegate] engine];
 }
 
+- (SnapshotPlaceholderCache *)snapshotPlaceholderCache {
+  return [(AppDelegate *)[[UIApplication sharedApplication] delegate] snapshotPlaceholderCache];
+}
+
 - (FlutterBasicMessageChannel*)reloadMessageChannel {
   return [(AppDelegate *)[[UIApplication sharedApplication] delegate] reloadMessageChannel];
 }
@@ -93,6 +113,10 @@
       [[FullScreenViewController alloc] initWithEngine:[self engine]
                                                nibName:nil
                                                 bundle:nil];
+  flutterViewController.snapshotRoute = @"full";
+  [[self snapshotPlaceholderCache]
+      installPlaceholderForViewController:flutterViewController
+                                    route:@"full"];
   [self.navigationController
       pushViewController:flutterViewController
                 animated:NO]; // Animating this is problematic.
@@ -112,6 +136,35 @@
                                        animated:YES];
 }
 
+// Runs the reattach benchmark for both view controllers, first recreating
+// them for every push and then keeping one alive, and logs the results.
+- (void)runReattachBenchmark {
+  NSMutableArray<ReattachBenchmark *> *benchmarks = [NSMutableArray array];
+  for (NSNumber *target in @[ @(ReattachBenchmarkTargetFullScreen),
+                              @(ReattachBenchmarkTargetHybrid) ]) {
+    for (NSNumber *keepAlive in @[ @NO, @YES ]) {
+      ReattachBenchmark *benchmark = [[ReattachBenchmark alloc]
+          initWithNavigationController:self.navigationController
+                                target:target.integerValue
+                            iterations:10];
+      benchmark.keepViewControllerAlive = keepAlive.boolValue;
+      [benchmarks addObject:benchmark];
+    }
+  }
+  [self runBenchmarks:benchmarks];
+}
+
+- (void)runBenchmarks:(NSMutableArray<ReattachBenchmark *> *)benchmarks {
+  ReattachBenchmark *benchmark = benchmarks.firstObject;
+  if (!benchmark) {
+    return;
+  }
+  [benchmarks removeObjectAtIndex:0];
+  [benchmark runWithCompletion:^(NSArray<NSDictionary *> *results) {
+    [self runBenchmarks:benchmarks];
+  }];
+}
+
 - (void)addButton:(NSString *)title action:(SEL)action {
   UIButton *button = [UIButton buttonWithType:UIButtonTypeSystem];
   [button setTitle:title forState:UIControlStateNormal];
@@ -0,0 +1,14 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Returns the physical memory footprint of this process in bytes, the figure
+// iOS uses to decide when to terminate an app for memory use. Returns 0 if it
+// can't be read.
+uint64_t CurrentMemoryFootprint(void);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,18 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "MemoryFootprint.h"
+
+#import <mach/mach.h>
+
+uint64_t CurrentMemoryFootprint(void) {
+  task_vm_info_data_t info;
+  mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+  kern_return_t result =
+      task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&info, &count);
+  if (result != KERN_SUCCESS) {
+    return 0;
+  }
+  return info.phys_footprint;
+}
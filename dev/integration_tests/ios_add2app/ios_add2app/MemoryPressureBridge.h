@@ -0,0 +1,40 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <Flutter/Flutter.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Forwards memory pressure to an engine that may not have a view controller.
+//
+// A FlutterViewController tells its engine about memory warnings, but an
+// engine that is running without one, as the app-wide engine here is between
+// pushes, hears nothing. The bridge handles two stages:
+//
+// 1. When the app enters the background, the engine is sent a memoryPressure
+//    message so the framework drops its image cache, which is the memory iOS
+//    is most likely to count against a backgrounded app. The cache's size
+//    limits are left alone, so it refills normally once the app is back.
+// 2. On a memory warning, the same message is sent if no view controller is
+//    attached to pass it on.
+//
+// Each trim is logged with the memory footprint it freed, measured after
+// |settleTime| so the framework has had a chance to release images.
+@interface MemoryPressureBridge : NSObject
+
+- (instancetype)initWithEngine:(FlutterEngine*)engine NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// How long after a trim the footprint is measured again. Defaults to 1
+// second.
+@property(nonatomic) NSTimeInterval settleTime;
+
+// One entry per trim, with the keys "trigger" ("background" or
+// "memoryWarning"), "footprintBeforeBytes" and "freedBytes". Entries are
+// added once the trim has settled.
+@property(nonatomic, readonly) NSArray<NSDictionary*>* trims;
+
+@end
+
+NS_ASSUME_NONNULL_END
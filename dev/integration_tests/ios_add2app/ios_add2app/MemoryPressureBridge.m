@@ -0,0 +1,79 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "MemoryPressureBridge.h"
+
+#import "MemoryFootprint.h"
+
+@implementation MemoryPressureBridge {
+  __weak FlutterEngine* _engine;
+  NSMutableArray<NSDictionary*>* _trims;
+}
+
+- (instancetype)initWithEngine:(FlutterEngine*)engine {
+  self = [super init];
+  if (self) {
+    _engine = engine;
+    _trims = [NSMutableArray array];
+    _settleTime = 1.0;
+    NSNotificationCenter* center = [NSNotificationCenter defaultCenter];
+    [center addObserver:self
+               selector:@selector(applicationDidEnterBackground:)
+                   name:UIApplicationDidEnterBackgroundNotification
+                 object:nil];
+    [center addObserver:self
+               selector:@selector(applicationDidReceiveMemoryWarning:)
+                   name:UIApplicationDidReceiveMemoryWarningNotification
+                 object:nil];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (NSArray<NSDictionary*>*)trims {
+  return [_trims copy];
+}
+
+- (void)applicationDidEnterBackground:(NSNotification*)notification {
+  [self trimWithTrigger:@"background"];
+}
+
+- (void)applicationDidReceiveMemoryWarning:(NSNotification*)notification {
+  // An attached view controller already forwards memory warnings, and a
+  // second message would only repeat the work.
+  if (_engine.viewController) {
+    return;
+  }
+  [self trimWithTrigger:@"memoryWarning"];
+}
+
+- (void)trimWithTrigger:(NSString*)trigger {
+  FlutterEngine* engine = _engine;
+  if (!engine) {
+    return;
+  }
+  uint64_t footprintBefore = CurrentMemoryFootprint();
+  [engine.systemChannel sendMessage:@{@"type" : @"memoryPressure"}];
+
+  __weak MemoryPressureBridge* weakSelf = self;
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(_settleTime * NSEC_PER_SEC)),
+                 dispatch_get_main_queue(), ^{
+                   [weakSelf recordTrimWithTrigger:trigger footprintBefore:footprintBefore];
+                 });
+}
+
+- (void)recordTrimWithTrigger:(NSString*)trigger footprintBefore:(uint64_t)footprintBefore {
+  NSDictionary* trim = @{
+    @"trigger" : trigger,
+    @"footprintBeforeBytes" : @(footprintBefore),
+    @"freedBytes" : @((int64_t)footprintBefore - (int64_t)CurrentMemoryFootprint()),
+  };
+  NSLog(@"Memory pressure trim: %@", trim);
+  [_trims addObject:trim];
+}
+
+@end
@@ -0,0 +1,47 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, ReattachBenchmarkTarget) {
+  ReattachBenchmarkTargetFullScreen,
+  ReattachBenchmarkTargetHybrid,
+};
+
+// Repeatedly pushes and pops a view controller that shows the app-wide engine,
+// and records for each push the time to the first frame after reattaching and
+// the change in memory footprint once the view controller has been popped.
+@interface ReattachBenchmark : NSObject
+
+- (instancetype)initWithNavigationController:(UINavigationController*)navigationController
+                                      target:(ReattachBenchmarkTarget)target
+                                  iterations:(NSUInteger)iterations NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// When YES, a single view controller is pushed every iteration and stays
+// attached to the engine while popped, so its FlutterView and layer survive
+// short detaches. When NO, a new view controller is created for every push, as
+// MainViewController does. Defaults to NO.
+@property(nonatomic) BOOL keepViewControllerAlive;
+
+// How long each view controller stays on screen after its first frame, and
+// how long the benchmark waits after popping it. Default to 0.5 and 0.25
+// seconds.
+@property(nonatomic) NSTimeInterval dwellTime;
+@property(nonatomic) NSTimeInterval detachTime;
+
+// One entry per iteration, with the keys "target", "keepViewControllerAlive",
+// "timeToFirstFrameMillis" and "memoryFootprintDeltaBytes". The memory delta
+// is relative to the footprint before the first push.
+@property(nonatomic, readonly) NSArray<NSDictionary*>* results;
+
+// Runs the benchmark on the main thread and calls |completion| when all
+// iterations have finished.
+- (void)runWithCompletion:(void (^)(NSArray<NSDictionary*>* results))completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
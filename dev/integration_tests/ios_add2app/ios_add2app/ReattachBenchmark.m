@@ -0,0 +1,136 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <Flutter/Flutter.h>
+#import <QuartzCore/QuartzCore.h>
+
+#import "AppDelegate.h"
+#import "FullScreenViewController.h"
+#import "HybridViewController.h"
+#import "MemoryFootprint.h"
+#import "ReattachBenchmark.h"
+
+@implementation ReattachBenchmark {
+  UINavigationController* _navigationController;
+  ReattachBenchmarkTarget _target;
+  NSUInteger _iterations;
+  NSMutableArray<NSDictionary*>* _results;
+  UIViewController* _keptViewController;
+  uint64_t _baselineFootprint;
+  void (^_completion)(NSArray<NSDictionary*>*);
+}
+
+- (instancetype)initWithNavigationController:(UINavigationController*)navigationController
+                                      target:(ReattachBenchmarkTarget)target
+                                  iterations:(NSUInteger)iterations {
+  self = [super init];
+  if (self) {
+    _navigationController = navigationController;
+    _target = target;
+    _iterations = iterations;
+    _results = [NSMutableArray array];
+    _dwellTime = 0.5;
+    _detachTime = 0.25;
+  }
+  return self;
+}
+
+- (NSArray<NSDictionary*>*)results {
+  return [_results copy];
+}
+
+- (void)runWithCompletion:(void (^)(NSArray<NSDictionary*>*))completion {
+  _completion = [completion copy];
+  [_results removeAllObjects];
+  _keptViewController = nil;
+  _baselineFootprint = CurrentMemoryFootprint();
+  [self runNextIteration];
+}
+
+- (void)runNextIteration {
+  if (_results.count == _iterations) {
+    NSLog(@"Reattach benchmark results: %@", _results);
+    _keptViewController = nil;
+    void (^completion)(NSArray<NSDictionary*>*) = _completion;
+    _completion = nil;
+    completion([_results copy]);
+    return;
+  }
+
+  CFTimeInterval start = CACurrentMediaTime();
+  FlutterViewController* flutterViewController;
+  UIViewController* viewController = [self viewControllerToPush:&flutterViewController];
+  __weak ReattachBenchmark* weakSelf = self;
+  // The engine installs its first frame callback every time the surface is
+  // recreated, so this also fires for a view controller that is pushed again.
+  [flutterViewController setFlutterViewDidRenderCallback:^{
+    [weakSelf didRenderFirstFrameAfter:CACurrentMediaTime() - start];
+  }];
+  [_navigationController pushViewController:viewController animated:NO];
+}
+
+// Returns the view controller for the next push, and the FlutterViewController
+// it shows in |flutterViewController|.
+- (UIViewController*)viewControllerToPush:(FlutterViewController**)flutterViewController {
+  if (_keepViewControllerAlive && _keptViewController) {
+    *flutterViewController = [self flutterViewControllerOf:_keptViewController];
+    return _keptViewController;
+  }
+
+  UIViewController* viewController;
+  if (_target == ReattachBenchmarkTargetFullScreen) {
+    AppDelegate* appDelegate = (AppDelegate*)[[UIApplication sharedApplication] delegate];
+    [appDelegate.engine.navigationChannel invokeMethod:@"setInitialRoute" arguments:@"full"];
+    [appDelegate.reloadMessageChannel sendMessage:@"full"];
+    FullScreenViewController* fullScreenViewController =
+        [[FullScreenViewController alloc] initWithEngine:appDelegate.engine
+                                                 nibName:nil
+                                                  bundle:nil];
+    fullScreenViewController.keepsEngineAttachedOnPop = _keepViewControllerAlive;
+    viewController = fullScreenViewController;
+  } else {
+    HybridViewController* hybridViewController = [[HybridViewController alloc] init];
+    // The hybrid view creates its FlutterViewController when its view loads.
+    [hybridViewController loadViewIfNeeded];
+    viewController = hybridViewController;
+  }
+  if (_keepViewControllerAlive) {
+    _keptViewController = viewController;
+  }
+  *flutterViewController = [self flutterViewControllerOf:viewController];
+  return viewController;
+}
+
+- (FlutterViewController*)flutterViewControllerOf:(UIViewController*)viewController {
+  if (_target == ReattachBenchmarkTargetFullScreen) {
+    return (FlutterViewController*)viewController;
+  }
+  return ((HybridViewController*)viewController).flutterViewController;
+}
+
+- (void)didRenderFirstFrameAfter:(CFTimeInterval)elapsed {
+  double timeToFirstFrameMillis = elapsed * 1000.0;
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(_dwellTime * NSEC_PER_SEC)),
+                 dispatch_get_main_queue(), ^{
+                   [self->_navigationController popViewControllerAnimated:NO];
+                   dispatch_after(
+                       dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self->_detachTime * NSEC_PER_SEC)),
+                       dispatch_get_main_queue(), ^{
+                         [self recordIterationWithTimeToFirstFrame:timeToFirstFrameMillis];
+                         [self runNextIteration];
+                       });
+                 });
+}
+
+- (void)recordIterationWithTimeToFirstFrame:(double)timeToFirstFrameMillis {
+  [_results addObject:@{
+    @"target" : _target == ReattachBenchmarkTargetFullScreen ? @"full_screen" : @"hybrid",
+    @"keepViewControllerAlive" : @(_keepViewControllerAlive),
+    @"timeToFirstFrameMillis" : @(timeToFirstFrameMillis),
+    @"memoryFootprintDeltaBytes" :
+        @((int64_t)CurrentMemoryFootprint() - (int64_t)_baselineFootprint),
+  }];
+}
+
+@end
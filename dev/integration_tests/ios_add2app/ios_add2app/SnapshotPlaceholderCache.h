@@ -0,0 +1,42 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <Flutter/Flutter.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Keeps a snapshot of the last frame each engine showed for a route, and
+// shows it as the placeholder of the next view controller that attaches to
+// the engine for that route, until the engine renders its first frame into the
+// new surface. This hides the blank frames between pushing a view controller
+// and the engine catching up.
+//
+// Only attaches need a placeholder: while a view is resized, its layer keeps
+// showing the last frame, stretched, until the next one arrives.
+//
+// Snapshots are full-size bitmaps, so they are dropped when the application
+// receives a memory warning.
+@interface SnapshotPlaceholderCache : NSObject
+
+// Whether snapshots are taken and placeholders installed. Defaults to YES.
+// Turning it off drops the snapshots.
+@property(nonatomic, getter=isEnabled) BOOL enabled;
+
+// Takes a snapshot of |viewController|'s current frame for its engine and
+// |route|. Must be called while the view controller is still on screen, e.g.
+// from viewWillDisappear:, and before it is detached from the engine.
+- (void)captureViewController:(FlutterViewController*)viewController route:(NSString*)route;
+
+// Makes the snapshot for |viewController|'s engine and |route|, if there is
+// one, its splash screen view. Must be called before the view controller's
+// view is loaded.
+- (void)installPlaceholderForViewController:(FlutterViewController*)viewController
+                                      route:(NSString*)route;
+
+// Drops all snapshots.
+- (void)removeAllSnapshots;
+
+@end
+
+NS_ASSUME_NONNULL_END
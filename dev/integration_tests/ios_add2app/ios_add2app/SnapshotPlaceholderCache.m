@@ -0,0 +1,84 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "SnapshotPlaceholderCache.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+@implementation SnapshotPlaceholderCache {
+  // Per engine, the last snapshot for each route.
+  NSMapTable<FlutterEngine*, NSMutableDictionary<NSString*, UIImage*>*>* _snapshots;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _enabled = YES;
+    _snapshots = [NSMapTable weakToStrongObjectsMapTable];
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(removeAllSnapshots)
+                                                 name:UIApplicationDidReceiveMemoryWarningNotification
+                                               object:nil];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (void)setEnabled:(BOOL)enabled {
+  _enabled = enabled;
+  if (!enabled) {
+    [self removeAllSnapshots];
+  }
+}
+
+- (void)captureViewController:(FlutterViewController*)viewController route:(NSString*)route {
+  FlutterEngine* engine = viewController.engine;
+  UIView* view = viewController.viewIfLoaded;
+  // Before the first frame there is nothing worth keeping, only the
+  // placeholder itself.
+  if (!_enabled || !engine || !view.window || !viewController.displayingFlutterUI ||
+      CGRectIsEmpty(view.bounds)) {
+    return;
+  }
+  CFTimeInterval start = CACurrentMediaTime();
+  UIGraphicsImageRenderer* renderer =
+      [[UIGraphicsImageRenderer alloc] initWithBounds:view.bounds];
+  // Drawing the view hierarchy, rather than rendering the layer, includes the
+  // content of the Flutter view's GPU-backed layer.
+  UIImage* snapshot = [renderer imageWithActions:^(UIGraphicsImageRendererContext* context) {
+    [view drawViewHierarchyInRect:view.bounds afterScreenUpdates:NO];
+  }];
+  NSMutableDictionary<NSString*, UIImage*>* routes = [_snapshots objectForKey:engine];
+  if (!routes) {
+    routes = [NSMutableDictionary dictionary];
+    [_snapshots setObject:routes forKey:engine];
+  }
+  routes[route] = snapshot;
+  NSLog(@"SnapshotPlaceholderCache: captured %@ in %.1f ms", route,
+        (CACurrentMediaTime() - start) * 1000.0);
+}
+
+- (void)installPlaceholderForViewController:(FlutterViewController*)viewController
+                                      route:(NSString*)route {
+  UIImage* snapshot = [[_snapshots objectForKey:viewController.engine] objectForKey:route];
+  if (!_enabled || !snapshot) {
+    return;
+  }
+  UIImageView* placeholder = [[UIImageView alloc] initWithImage:snapshot];
+  // Pinned to the top, as Flutter content is laid out, in case the new view
+  // is a different size.
+  placeholder.contentMode = UIViewContentModeTop;
+  placeholder.clipsToBounds = YES;
+  // Removed by the view controller once the engine renders its first frame.
+  viewController.splashScreenView = placeholder;
+}
+
+- (void)removeAllSnapshots {
+  [_snapshots removeAllObjects];
+}
+
+@end
@@ -10,6 +10,8 @@
 #import "../ios_add2app/FullScreenViewController.h"
 #import "../ios_add2app/MainViewController.h"
 #import "../ios_add2app/HybridViewController.h"
+#import "../ios_add2app/ReattachBenchmark.h"
+#import "../ios_add2app/SnapshotPlaceholderCache.h"
 
 @interface FlutterTests : XCTestCase
 @end
@@ -88,6 +90,15 @@
         (DualFlutterViewController *)navController.visibleViewController;
     GREYAssertNotNil(viewController,
                      @"Expected non-nil DualFlutterViewController.");
+    // The bottom view spins up once the top one has rendered.
+    int tries = 30;
+    while (viewController.spinUpMetrics.count < 2 && tries != 0) {
+      CFRunLoopRunInMode(kCFRunLoopDefaultMode, 1.0, false);
+      tries--;
+    }
+    GREYAssertEqual(@(viewController.spinUpMetrics.count), @(2),
+                    @"Expected both Flutter views to have rendered.");
+    NSLog(@"Dual Flutter view spin-up metrics: %@", viewController.spinUpMetrics);
     [self expectSemanticsNotification:viewController.topFlutterViewController];
     [self expectSemanticsNotification:viewController.bottomFlutterViewController];
   }
@@ -158,6 +169,70 @@
       assertWithMatcher:grey_sufficientlyVisible()];
 }
 
+- (void)testHybridViewLeavesSnapshotPlaceholder {
+  [[EarlGrey selectElementWithMatcher:grey_keyWindow()]
+      assertWithMatcher:grey_sufficientlyVisible()];
+
+  AppDelegate *appDelegate =
+      (AppDelegate *)[[UIApplication sharedApplication] delegate];
+  [[EarlGrey selectElementWithMatcher:grey_buttonTitle(@"Hybrid View (Warm)")]
+      performAction:grey_tap()];
+  @autoreleasepool {
+    UINavigationController *navController =
+        (UINavigationController *)appDelegate.window.rootViewController;
+    HybridViewController *viewController =
+        (HybridViewController *)navController.visibleViewController;
+    [self expectSemanticsNotification:viewController.flutterViewController];
+  }
+  [[EarlGrey selectElementWithMatcher:grey_buttonTitle(@"Back")]
+      performAction:grey_tap()];
+
+  // The next view controller for the route gets the snapshot taken on pop.
+  FlutterViewController *viewController =
+      [[FlutterViewController alloc] initWithEngine:appDelegate.engine
+                                            nibName:nil
+                                             bundle:nil];
+  [appDelegate.snapshotPlaceholderCache
+      installPlaceholderForViewController:viewController
+                                    route:@"hybrid"];
+  GREYAssertTrue([viewController.splashScreenView isKindOfClass:[UIImageView class]],
+                 @"Expected the hybrid view's snapshot as the placeholder.");
+  [appDelegate.snapshotPlaceholderCache removeAllSnapshots];
+
+  [[EarlGrey selectElementWithMatcher:grey_buttonTitle(@"Native iOS View")]
+      assertWithMatcher:grey_sufficientlyVisible()];
+}
+
+- (void)testReattachBenchmark {
+  [[EarlGrey selectElementWithMatcher:grey_keyWindow()]
+      assertWithMatcher:grey_sufficientlyVisible()];
+
+  UINavigationController *navController =
+      (UINavigationController *)((AppDelegate *)
+                                     [[UIApplication sharedApplication]
+                                         delegate])
+          .window.rootViewController;
+  static const NSUInteger iterations = 3;
+  for (NSNumber *keepAlive in @[ @NO, @YES ]) {
+    ReattachBenchmark *benchmark = [[ReattachBenchmark alloc]
+        initWithNavigationController:navController
+                              target:ReattachBenchmarkTargetFullScreen
+                          iterations:iterations];
+    benchmark.keepViewControllerAlive = keepAlive.boolValue;
+    XCTestExpectation *finished =
+        [self expectationWithDescription:@"Reattach benchmark finished"];
+    [benchmark runWithCompletion:^(NSArray<NSDictionary *> *results) {
+      [finished fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:60.0 handler:nil];
+    GREYAssertEqual(@(benchmark.results.count), @(iterations),
+                    @"Expected one result per iteration.");
+  }
+
+  [[EarlGrey selectElementWithMatcher:grey_buttonTitle(@"Native iOS View")]
+      assertWithMatcher:grey_sufficientlyVisible()];
+}
+
 /** Validates that the text labels showing the number of button taps match the
  * expected counts. */
 - (void)validateCountsFlutter:(NSString *)labelPrefix count:(int)flutterCount {
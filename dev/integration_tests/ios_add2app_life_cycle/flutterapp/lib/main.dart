@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+import 'dart:typed_data';
 import 'dart:ui' as ui;
 import 'package:flutter/material.dart';
 import 'package:flutter/rendering.dart';
@@ -21,6 +22,48 @@ void main() {
   runApp(const LifeCycleSpy());
 }
 
+const MethodCodec _backgroundCodec = StandardMethodCodec();
+const String _backgroundChannel = 'background_engine';
+
+/// The entrypoint of the host's BackgroundEngine, which runs without a view.
+///
+/// It answers tasks on the background_engine channel using `dart:ui` directly,
+/// rather than through a [MethodChannel], so that none of the framework's
+/// bindings are initialized and the isolate stays as small as it can be.
+@pragma('vm:entry-point')
+void backgroundMain() {
+  ui.window.onPlatformMessage = (String name, ByteData data, ui.PlatformMessageResponseCallback callback) {
+    if (name != _backgroundChannel) {
+      callback(null);
+      return;
+    }
+    final MethodCall call = _backgroundCodec.decodeMethodCall(data);
+    switch (call.method) {
+      case 'checksum':
+        callback(_backgroundCodec.encodeSuccessEnvelope(_checksum(call.arguments as String)));
+        break;
+      default:
+        callback(null);
+    }
+  };
+  // Tells the host that tasks can be sent.
+  ui.window.sendPlatformMessage(
+    _backgroundChannel,
+    _backgroundCodec.encodeMethodCall(const MethodCall('ready')),
+    null,
+  );
+}
+
+/// A 32-bit FNV-1a hash of [value]'s UTF-16 code units, standing in for the
+/// work a background task would do.
+int _checksum(String value) {
+  int hash = 0x811c9dc5;
+  for (final int unit in value.codeUnits) {
+    hash = ((hash ^ unit) * 0x01000193) & 0xffffffff;
+  }
+  return hash;
+}
+
 /// A Test widget that spies on app life cycle changes.
 ///
 /// It will collect the AppLifecycleState sequence during its lifetime, and it
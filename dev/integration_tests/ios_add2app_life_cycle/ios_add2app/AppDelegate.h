@@ -5,8 +5,18 @@
 #import <UIKit/UIKit.h>
 #import <Flutter/Flutter.h>
 
+#import "BackgroundEngine.h"
+#import "EngineCache.h"
+
 @interface AppDelegate : FlutterAppDelegate
 
+@property(nonatomic, strong, readonly) EngineCache* engineCache;
+
+// The engine shared by the full screen demo. It is taken from |engineCache| the
+// first time it is requested, so it is warm unless the cache was evicted.
 @property(nonatomic, strong, readonly) FlutterEngine* engine;
 
+// Runs Dart tasks without a view. Its engine is only started by the first task.
+@property(nonatomic, strong, readonly) BackgroundEngine* backgroundEngine;
+
 @end
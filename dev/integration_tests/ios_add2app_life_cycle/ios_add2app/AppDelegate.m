@@ -7,7 +7,9 @@
 
 @interface AppDelegate ()
 
+@property(nonatomic, strong, readwrite) EngineCache* engineCache;
 @property(nonatomic, strong, readwrite) FlutterEngine* engine;
+@property(nonatomic, strong, readwrite) BackgroundEngine* backgroundEngine;
 
 @end
 
@@ -23,8 +25,9 @@
 
   navigationController.navigationBar.translucent = NO;
 
-  self.engine = [[FlutterEngine alloc] initWithName:@"test" project:nil];
-  [self.engine runWithEntrypoint:nil];
+  self.engineCache = [[EngineCache alloc] initWithCapacity:1];
+  [self.engineCache prewarmEngineWithEntrypoint:nil];
+  self.backgroundEngine = [[BackgroundEngine alloc] initWithIdleTimeout:5.0];
 
   self.window.rootViewController = navigationController;
   [self.window makeKeyAndVisible];
@@ -32,4 +35,11 @@
   return YES;
 }
 
+- (FlutterEngine *)engine {
+  if (!_engine) {
+    _engine = [self.engineCache dequeueEngineWithEntrypoint:nil initialRoute:nil];
+  }
+  return _engine;
+}
+
 @end
@@ -0,0 +1,51 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <Flutter/Flutter.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Runs Dart work, such as syncing or handling a push notification, on a
+/// FlutterEngine that never gets a view.
+///
+/// The engine runs the `backgroundMain` entrypoint, which handles tasks on the
+/// "background_engine" method channel without initializing the widgets or
+/// rendering bindings, so no frames are ever produced. The engine is started
+/// by the first task and shut down once no task has been pending for
+/// |idleTimeout|, releasing its isolate; the next task starts it again. While
+/// the engine runs, it holds a UIApplication background task so that work is
+/// allowed to finish after the app is backgrounded.
+///
+/// There is no per-engine setting for the Dart heap size, so the footprint is
+/// bounded by keeping the isolate free of framework state and by shutting it
+/// down when idle instead.
+@interface BackgroundEngine : NSObject
+
+- (instancetype)initWithIdleTimeout:(NSTimeInterval)idleTimeout NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Whether the engine is currently running.
+@property(nonatomic, readonly, getter=isRunning) BOOL running;
+
+/// Calls |method| on the Dart side with |arguments|, starting the engine if
+/// needed. |completion| is called on the main thread with the result, or with
+/// a FlutterError if the engine was shut down before the task finished.
+- (void)performTask:(NSString*)method
+          arguments:(nullable id)arguments
+         completion:(void (^)(id _Nullable result))completion;
+
+/// Shuts the engine down now, failing any pending tasks.
+- (void)shutDown;
+
+/// One entry per engine launch, with the keys "launchMillis" (from starting
+/// the engine to its isolate being ready for tasks) and "footprintBytes"
+/// (the growth of the process' memory footprint over that time).
+@property(nonatomic, readonly) NSArray<NSDictionary<NSString*, id>*>* launchMetrics;
+
+/// The process' physical memory footprint, as reported by task_info.
++ (uint64_t)currentMemoryFootprint;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,210 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "BackgroundEngine.h"
+
+#import <QuartzCore/QuartzCore.h>
+#import <mach/mach.h>
+
+// Must match backgroundMain in flutterapp/lib/main.dart.
+static NSString* const kEntrypoint = @"backgroundMain";
+static NSString* const kChannelName = @"background_engine";
+static NSString* const kReadyMethod = @"ready";
+
+@implementation BackgroundEngine {
+  NSTimeInterval _idleTimeout;
+  FlutterEngine* _engine;
+  FlutterMethodChannel* _channel;
+  BOOL _ready;
+  // Invocations of tasks that were requested before the isolate was ready.
+  NSMutableArray<dispatch_block_t>* _queuedInvocations;
+  // Completions of tasks that have not finished, by task ID.
+  NSMutableDictionary<NSNumber*, void (^)(id)>* _pendingCompletions;
+  NSUInteger _nextTaskID;
+  NSTimer* _idleTimer;
+  UIBackgroundTaskIdentifier _backgroundTask;
+  CFTimeInterval _launchStart;
+  uint64_t _launchFootprint;
+  NSMutableArray<NSDictionary<NSString*, id>*>* _launchMetrics;
+  NSUInteger _engineCount;
+}
+
+- (instancetype)initWithIdleTimeout:(NSTimeInterval)idleTimeout {
+  self = [super init];
+  if (self) {
+    _idleTimeout = idleTimeout;
+    _queuedInvocations = [[NSMutableArray alloc] init];
+    _pendingCompletions = [[NSMutableDictionary alloc] init];
+    _backgroundTask = UIBackgroundTaskInvalid;
+    _launchMetrics = [[NSMutableArray alloc] init];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [self shutDown];
+}
+
+- (BOOL)isRunning {
+  return _engine != nil;
+}
+
+- (NSArray<NSDictionary<NSString*, id>*>*)launchMetrics {
+  return [_launchMetrics copy];
+}
+
++ (uint64_t)currentMemoryFootprint {
+  task_vm_info_data_t info;
+  mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+  if (task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+    return 0;
+  }
+  return info.phys_footprint;
+}
+
+- (void)performTask:(NSString*)method
+          arguments:(id)arguments
+         completion:(void (^)(id))completion {
+  [_idleTimer invalidate];
+  _idleTimer = nil;
+  [self beginBackgroundTask];
+  if (!_engine) {
+    [self startEngine];
+  }
+
+  NSNumber* taskID = @(_nextTaskID++);
+  _pendingCompletions[taskID] = [completion copy];
+  __weak BackgroundEngine* weakSelf = self;
+  FlutterMethodChannel* channel = _channel;
+  dispatch_block_t invocation = ^{
+    [channel invokeMethod:method
+                arguments:arguments
+                   result:^(id result) {
+                     [weakSelf finishTask:taskID result:result];
+                   }];
+  };
+  if (_ready) {
+    invocation();
+  } else {
+    [_queuedInvocations addObject:invocation];
+  }
+}
+
+- (void)shutDown {
+  [_idleTimer invalidate];
+  _idleTimer = nil;
+  if (_engine) {
+    [_channel setMethodCallHandler:nil];
+    [_engine destroyContext];
+    _engine = nil;
+    _channel = nil;
+    _ready = NO;
+    NSLog(@"BackgroundEngine: shut down");
+  }
+  [_queuedInvocations removeAllObjects];
+  NSDictionary<NSNumber*, void (^)(id)>* completions = [_pendingCompletions copy];
+  [_pendingCompletions removeAllObjects];
+  for (NSNumber* taskID in completions) {
+    completions[taskID]([FlutterError errorWithCode:@"shut_down"
+                                            message:@"The background engine was shut down"
+                                            details:nil]);
+  }
+  [self endBackgroundTask];
+}
+
+#pragma mark - Private
+
+- (void)startEngine {
+  _launchStart = CACurrentMediaTime();
+  _launchFootprint = [BackgroundEngine currentMemoryFootprint];
+
+  NSString* name =
+      [NSString stringWithFormat:@"background_engine_%lu", (unsigned long)_engineCount++];
+  _engine = [[FlutterEngine alloc] initWithName:name project:nil allowHeadlessExecution:YES];
+  _channel = [FlutterMethodChannel methodChannelWithName:kChannelName binaryMessenger:_engine];
+  // The isolate calls "ready" once its handler is set, since messages sent
+  // before that would be dropped.
+  __weak BackgroundEngine* weakSelf = self;
+  [_channel setMethodCallHandler:^(FlutterMethodCall* call, FlutterResult result) {
+    if ([call.method isEqualToString:kReadyMethod]) {
+      [weakSelf isolateDidBecomeReady];
+      result(nil);
+    } else {
+      result(FlutterMethodNotImplemented);
+    }
+  }];
+  [_engine runWithEntrypoint:kEntrypoint];
+}
+
+- (void)isolateDidBecomeReady {
+  if (_ready) {
+    return;
+  }
+  _ready = YES;
+  double millis = (CACurrentMediaTime() - _launchStart) * 1000.0;
+  uint64_t footprint = [BackgroundEngine currentMemoryFootprint];
+  // The footprint can shrink meanwhile, e.g. if other memory was released.
+  uint64_t growth = footprint > _launchFootprint ? footprint - _launchFootprint : 0;
+  [_launchMetrics addObject:@{
+    @"launchMillis" : @(millis),
+    @"footprintBytes" : @(growth),
+  }];
+  NSLog(@"BackgroundEngine: ready in %.1f ms, footprint grew by %.1f MB", millis,
+        growth / (1024.0 * 1024.0));
+
+  NSArray<dispatch_block_t>* invocations = [_queuedInvocations copy];
+  [_queuedInvocations removeAllObjects];
+  for (dispatch_block_t invocation in invocations) {
+    invocation();
+  }
+}
+
+- (void)finishTask:(NSNumber*)taskID result:(id)result {
+  void (^completion)(id) = _pendingCompletions[taskID];
+  if (!completion) {
+    // Already failed by shutDown.
+    return;
+  }
+  [_pendingCompletions removeObjectForKey:taskID];
+  completion(result);
+  if (_pendingCompletions.count == 0) {
+    [self scheduleIdleShutDown];
+  }
+}
+
+- (void)scheduleIdleShutDown {
+  [_idleTimer invalidate];
+  __weak BackgroundEngine* weakSelf = self;
+  _idleTimer = [NSTimer scheduledTimerWithTimeInterval:_idleTimeout
+                                               repeats:NO
+                                                 block:^(NSTimer* timer) {
+                                                   [weakSelf shutDown];
+                                                 }];
+}
+
+// The background task lasts until the engine is shut down, so that the idle
+// timeout can still fire if the app has been backgrounded. Background
+// execution time is limited, so when it runs out the engine is shut down
+// rather than letting the system terminate the app.
+- (void)beginBackgroundTask {
+  if (_backgroundTask != UIBackgroundTaskInvalid) {
+    return;
+  }
+  __weak BackgroundEngine* weakSelf = self;
+  _backgroundTask = [[UIApplication sharedApplication]
+      beginBackgroundTaskWithName:@"BackgroundEngine"
+                expirationHandler:^{
+                  [weakSelf shutDown];
+                }];
+}
+
+- (void)endBackgroundTask {
+  if (_backgroundTask == UIBackgroundTaskInvalid) {
+    return;
+  }
+  [[UIApplication sharedApplication] endBackgroundTask:_backgroundTask];
+  _backgroundTask = UIBackgroundTaskInvalid;
+}
+
+@end
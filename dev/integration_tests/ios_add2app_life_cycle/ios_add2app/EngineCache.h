@@ -0,0 +1,54 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <Flutter/Flutter.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Keeps a bounded pool of prewarmed FlutterEngines for add-to-app hosts.
+///
+/// Engines are started one at a time while the main run loop is idle, so
+/// prewarming does not compete with touch handling or native animations.
+/// Prewarmed engines that have not been handed out are dropped when the
+/// application receives a memory warning.
+@interface EngineCache : NSObject
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The maximum number of prewarmed engines kept, including pending ones.
+@property(nonatomic, readonly) NSUInteger capacity;
+
+/// The number of prewarmed engines that are running and not handed out yet.
+@property(nonatomic, readonly) NSUInteger prewarmedCount;
+
+/// Schedules an engine running |entrypoint| to be started the next time the
+/// main run loop is idle. Ignored if the cache is already at capacity.
+- (void)prewarmEngineWithEntrypoint:(nullable NSString*)entrypoint;
+
+/// Returns a running engine for |entrypoint|, taking a prewarmed one if
+/// available and starting a cold one otherwise. A prewarmed engine has
+/// |initialRoute| pushed onto its navigator.
+- (FlutterEngine*)dequeueEngineWithEntrypoint:(nullable NSString*)entrypoint
+                                 initialRoute:(nullable NSString*)initialRoute;
+
+/// Starts a cold engine without looking at the cache, for comparison.
+- (FlutterEngine*)startColdEngineWithEntrypoint:(nullable NSString*)entrypoint
+                                   initialRoute:(nullable NSString*)initialRoute;
+
+/// Records the time from handing out |viewController|'s engine to its first
+/// rendered frame. Must be called before the view controller is shown, and
+/// only measures the first view controller shown with a handed out engine.
+- (void)measureFirstFrameOfViewController:(FlutterViewController*)viewController;
+
+/// Drops all pending and prewarmed engines that have not been handed out.
+- (void)evictPrewarmedEngines;
+
+/// One entry per measured view controller, with the keys "entrypoint",
+/// "route", "cached" and "timeToFirstFrameMillis".
+@property(nonatomic, readonly) NSArray<NSDictionary<NSString*, id>*>* firstFrameMetrics;
+
+@end
+
+NS_ASSUME_NONNULL_END
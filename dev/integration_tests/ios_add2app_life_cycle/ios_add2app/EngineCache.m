@@ -0,0 +1,204 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "EngineCache.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+// Cache key used for the default Dart entrypoint.
+static NSString* const kDefaultEntrypointKey = @"main";
+
+@implementation EngineCache {
+  NSMutableArray<NSString*>* _pendingEntrypoints;
+  NSMutableDictionary<NSString*, NSMutableArray<FlutterEngine*>*>* _prewarmedEngines;
+  // Per handed out engine: when it was handed out and whether it was cached.
+  NSMapTable<FlutterEngine*, NSDictionary<NSString*, id>*>* _handouts;
+  NSMutableArray<NSDictionary<NSString*, id>*>* _firstFrameMetrics;
+  CFRunLoopObserverRef _idleObserver;
+  NSUInteger _engineCount;
+  id _memoryWarningObserver;
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+  self = [super init];
+  if (self) {
+    _capacity = capacity;
+    _pendingEntrypoints = [[NSMutableArray alloc] init];
+    _prewarmedEngines = [[NSMutableDictionary alloc] init];
+    _handouts = [NSMapTable weakToStrongObjectsMapTable];
+    _firstFrameMetrics = [[NSMutableArray alloc] init];
+
+    __weak EngineCache* weakSelf = self;
+    _memoryWarningObserver = [[NSNotificationCenter defaultCenter]
+        addObserverForName:UIApplicationDidReceiveMemoryWarningNotification
+                    object:nil
+                     queue:[NSOperationQueue mainQueue]
+                usingBlock:^(NSNotification* note) {
+                  [weakSelf evictPrewarmedEngines];
+                }];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [[NSNotificationCenter defaultCenter] removeObserver:_memoryWarningObserver];
+  [self stopIdleObserver];
+}
+
+- (NSUInteger)prewarmedCount {
+  NSUInteger count = 0;
+  for (NSArray<FlutterEngine*>* engines in _prewarmedEngines.allValues) {
+    count += engines.count;
+  }
+  return count;
+}
+
+- (NSArray<NSDictionary<NSString*, id>*>*)firstFrameMetrics {
+  return [_firstFrameMetrics copy];
+}
+
+- (void)prewarmEngineWithEntrypoint:(NSString*)entrypoint {
+  if (_pendingEntrypoints.count + self.prewarmedCount >= _capacity) {
+    return;
+  }
+  [_pendingEntrypoints addObject:entrypoint ?: kDefaultEntrypointKey];
+  [self startIdleObserver];
+}
+
+- (FlutterEngine*)dequeueEngineWithEntrypoint:(NSString*)entrypoint
+                                 initialRoute:(NSString*)initialRoute {
+  NSMutableArray<FlutterEngine*>* engines =
+      _prewarmedEngines[entrypoint ?: kDefaultEntrypointKey];
+  FlutterEngine* engine = engines.firstObject;
+  if (!engine) {
+    return [self startColdEngineWithEntrypoint:entrypoint initialRoute:initialRoute];
+  }
+  [engines removeObjectAtIndex:0];
+  if (initialRoute) {
+    [engine.navigationChannel invokeMethod:@"pushRoute" arguments:initialRoute];
+  }
+  [self recordHandoutOfEngine:engine entrypoint:entrypoint route:initialRoute cached:YES];
+  return engine;
+}
+
+- (FlutterEngine*)startColdEngineWithEntrypoint:(NSString*)entrypoint
+                                   initialRoute:(NSString*)initialRoute {
+  CFTimeInterval start = CACurrentMediaTime();
+  FlutterEngine* engine = [self newEngine];
+  if (initialRoute) {
+    [engine.navigationChannel invokeMethod:@"setInitialRoute" arguments:initialRoute];
+  }
+  [engine runWithEntrypoint:entrypoint];
+  [self recordHandoutOfEngine:engine entrypoint:entrypoint route:initialRoute cached:NO];
+  NSLog(@"EngineCache: started cold engine in %.1f ms",
+        (CACurrentMediaTime() - start) * 1000.0);
+  return engine;
+}
+
+- (void)measureFirstFrameOfViewController:(FlutterViewController*)viewController {
+  NSDictionary<NSString*, id>* handout = [_handouts objectForKey:viewController.engine];
+  if (!handout) {
+    return;
+  }
+  // Only the first view controller shown after a handout is measured.
+  [_handouts removeObjectForKey:viewController.engine];
+  __weak EngineCache* weakSelf = self;
+  [viewController setFlutterViewDidRenderCallback:^{
+    [weakSelf recordFirstFrameForHandout:handout];
+  }];
+}
+
+- (void)evictPrewarmedEngines {
+  NSLog(@"EngineCache: evicting %lu prewarmed and %lu pending engines",
+        (unsigned long)self.prewarmedCount, (unsigned long)_pendingEntrypoints.count);
+  [_pendingEntrypoints removeAllObjects];
+  [_prewarmedEngines removeAllObjects];
+  [self stopIdleObserver];
+}
+
+#pragma mark - Private
+
+- (FlutterEngine*)newEngine {
+  NSString* name = [NSString stringWithFormat:@"cached_engine_%lu", (unsigned long)_engineCount++];
+  return [[FlutterEngine alloc] initWithName:name project:nil];
+}
+
+- (void)recordHandoutOfEngine:(FlutterEngine*)engine
+                   entrypoint:(NSString*)entrypoint
+                        route:(NSString*)route
+                       cached:(BOOL)cached {
+  [_handouts setObject:@{
+    @"entrypoint" : entrypoint ?: kDefaultEntrypointKey,
+    @"route" : route ?: @"/",
+    @"cached" : @(cached),
+    @"start" : @(CACurrentMediaTime()),
+  }
+                forKey:engine];
+}
+
+- (void)recordFirstFrameForHandout:(NSDictionary<NSString*, id>*)handout {
+  double millis = (CACurrentMediaTime() - [handout[@"start"] doubleValue]) * 1000.0;
+  NSDictionary<NSString*, id>* metric = @{
+    @"entrypoint" : handout[@"entrypoint"],
+    @"route" : handout[@"route"],
+    @"cached" : handout[@"cached"],
+    @"timeToFirstFrameMillis" : @(millis),
+  };
+  [_firstFrameMetrics addObject:metric];
+  NSLog(@"EngineCache: %@ engine for %@ rendered its first frame in %.1f ms",
+        [handout[@"cached"] boolValue] ? @"cached" : @"cold", handout[@"route"], millis);
+}
+
+// Engines must be created on the platform thread, so "background" prewarming
+// means starting at most one engine each time the main run loop is about to
+// sleep. The observer is only registered in the default mode, so nothing is
+// started while the user is scrolling or tracking a touch.
+- (void)startIdleObserver {
+  if (_idleObserver) {
+    return;
+  }
+  __weak EngineCache* weakSelf = self;
+  _idleObserver = CFRunLoopObserverCreateWithHandler(
+      kCFAllocatorDefault, kCFRunLoopBeforeWaiting, YES, INT_MAX,
+      ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+        [weakSelf prewarmNextEngine];
+      });
+  CFRunLoopAddObserver(CFRunLoopGetMain(), _idleObserver, kCFRunLoopDefaultMode);
+}
+
+- (void)stopIdleObserver {
+  if (!_idleObserver) {
+    return;
+  }
+  CFRunLoopObserverInvalidate(_idleObserver);
+  CFRelease(_idleObserver);
+  _idleObserver = NULL;
+}
+
+- (void)prewarmNextEngine {
+  NSString* key = _pendingEntrypoints.firstObject;
+  if (!key) {
+    [self stopIdleObserver];
+    return;
+  }
+  [_pendingEntrypoints removeObjectAtIndex:0];
+
+  CFTimeInterval start = CACurrentMediaTime();
+  FlutterEngine* engine = [self newEngine];
+  [engine runWithEntrypoint:[key isEqualToString:kDefaultEntrypointKey] ? nil : key];
+  NSMutableArray<FlutterEngine*>* engines = _prewarmedEngines[key];
+  if (!engines) {
+    engines = [[NSMutableArray alloc] init];
+    _prewarmedEngines[key] = engines;
+  }
+  [engines addObject:engine];
+  NSLog(@"EngineCache: prewarmed %@ engine in %.1f ms", key,
+        (CACurrentMediaTime() - start) * 1000.0);
+
+  if (_pendingEntrypoints.count == 0) {
+    [self stopIdleObserver];
+  }
+}
+
+@end
@@ -34,16 +34,43 @@
   [self.view addSubview:_stackView];
 
   [self addButton:@"Full Screen (Cold)" action:@selector(showFullScreenCold)];
+  [self addButton:@"Full Screen (Uncached)"
+           action:@selector(showFullScreenUncached)];
+  [self addButton:@"Background Task" action:@selector(runBackgroundTask)];
+}
+
+- (void)runBackgroundTask {
+  BackgroundEngine *backgroundEngine =
+      [(AppDelegate *)[[UIApplication sharedApplication] delegate] backgroundEngine];
+  [backgroundEngine performTask:@"checksum"
+                      arguments:@"background task"
+                     completion:^(id result) {
+                       NSLog(@"Background task finished with %@", result);
+                     }];
 }
 
 - (void)showFullScreenCold {
-  FlutterEngine *engine =
-      [(AppDelegate *)[[UIApplication sharedApplication] delegate] engine];
+  AppDelegate *appDelegate =
+      (AppDelegate *)[[UIApplication sharedApplication] delegate];
+  [self showFullScreenWithEngine:appDelegate.engine];
+}
+
+- (void)showFullScreenUncached {
+  // Bypasses the cache to show the cost of starting an engine on demand. The
+  // engine is released together with the view controller when it is popped.
+  EngineCache *engineCache =
+      [(AppDelegate *)[[UIApplication sharedApplication] delegate] engineCache];
+  [self showFullScreenWithEngine:[engineCache startColdEngineWithEntrypoint:nil
+                                                               initialRoute:nil]];
+}
 
+- (void)showFullScreenWithEngine:(FlutterEngine *)engine {
   FullScreenViewController *flutterViewController =
       [[FullScreenViewController alloc] initWithEngine:engine
                                                nibName:nil
                                                 bundle:nil];
+  [[(AppDelegate *)[[UIApplication sharedApplication] delegate] engineCache]
+      measureFirstFrameOfViewController:flutterViewController];
   [self.navigationController
       pushViewController:flutterViewController
                 animated:NO]; // Animating this is janky because of
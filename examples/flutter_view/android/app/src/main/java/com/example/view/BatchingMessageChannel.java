@@ -0,0 +1,148 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+package com.example.view;
+
+import android.os.Handler;
+import android.os.Looper;
+import android.util.Log;
+import android.view.Choreographer;
+import io.flutter.plugin.common.BinaryMessenger;
+import java.io.ByteArrayOutputStream;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.Charset;
+
+/**
+ * A string message channel that coalesces the messages sent within a frame
+ * into a single binary message.
+ *
+ * A batch is encoded as a sequence of messages, each a little-endian uint32
+ * byte length followed by that many bytes of UTF-8. Flutter's side of the
+ * channel is {@code BatchingMessageChannel} in lib/batching_message_channel.dart.
+ *
+ * Must be used from the main thread.
+ */
+public final class BatchingMessageChannel {
+    private static final String TAG = "BatchingMessageChannel";
+    private static final Charset UTF8 = Charset.forName("UTF8");
+
+    /** Receives the messages of incoming batches, in order. */
+    public interface MessageHandler {
+        void onMessage(String message);
+    }
+
+    private final BinaryMessenger messenger;
+    private final String name;
+    private final ByteArrayOutputStream pending = new ByteArrayOutputStream();
+    private boolean flushesOnVsync = true;
+    private int maxBatchSize = 64 * 1024;
+    private boolean flushScheduled;
+
+    private final Choreographer.FrameCallback frameCallback = new Choreographer.FrameCallback() {
+        @Override
+        public void doFrame(long frameTimeNanos) {
+            flush();
+        }
+    };
+    private final Runnable flushRunnable = new Runnable() {
+        @Override
+        public void run() {
+            flush();
+        }
+    };
+    private final Handler handler = new Handler(Looper.getMainLooper());
+
+    public BatchingMessageChannel(BinaryMessenger messenger, String name) {
+        this.messenger = messenger;
+        this.name = name;
+    }
+
+    /**
+     * Sets whether pending messages are flushed at the next vsync. If false,
+     * they are flushed once the main looper is idle. Defaults to true.
+     */
+    public void setFlushesOnVsync(boolean flushesOnVsync) {
+        this.flushesOnVsync = flushesOnVsync;
+    }
+
+    /**
+     * Sets the size in bytes at which a pending batch is flushed right away.
+     * Defaults to 64KB.
+     */
+    public void setMaxBatchSize(int maxBatchSize) {
+        this.maxBatchSize = maxBatchSize;
+    }
+
+    /** Queues {@code message} to be sent with the next batch. */
+    public void send(String message) {
+        final byte[] bytes = message.getBytes(UTF8);
+        final ByteBuffer length = ByteBuffer.allocate(4).order(ByteOrder.LITTLE_ENDIAN);
+        length.putInt(bytes.length);
+        pending.write(length.array(), 0, 4);
+        pending.write(bytes, 0, bytes.length);
+        if (pending.size() >= maxBatchSize) {
+            flush();
+        } else {
+            scheduleFlush();
+        }
+    }
+
+    private void scheduleFlush() {
+        if (flushScheduled) {
+            return;
+        }
+        flushScheduled = true;
+        if (flushesOnVsync) {
+            Choreographer.getInstance().postFrameCallback(frameCallback);
+        } else {
+            handler.post(flushRunnable);
+        }
+    }
+
+    /** Sends the pending batch now, if there is one. */
+    public void flush() {
+        if (flushScheduled) {
+            Choreographer.getInstance().removeFrameCallback(frameCallback);
+            handler.removeCallbacks(flushRunnable);
+            flushScheduled = false;
+        }
+        if (pending.size() == 0) {
+            return;
+        }
+        // Outgoing messages must be direct-allocated.
+        final ByteBuffer batch = ByteBuffer.allocateDirect(pending.size());
+        batch.put(pending.toByteArray());
+        pending.reset();
+        messenger.send(name, batch);
+    }
+
+    /**
+     * Sets the handler of incoming batches, or unregisters the existing one
+     * if {@code messageHandler} is null.
+     */
+    public void setMessageHandler(final MessageHandler messageHandler) {
+        if (messageHandler == null) {
+            messenger.setMessageHandler(name, null);
+            return;
+        }
+        messenger.setMessageHandler(name, new BinaryMessenger.BinaryMessageHandler() {
+            @Override
+            public void onMessage(ByteBuffer batch, BinaryMessenger.BinaryReply reply) {
+                batch.order(ByteOrder.LITTLE_ENDIAN);
+                while (batch.remaining() >= 4) {
+                    final int length = batch.getInt();
+                    if (length < 0 || length > batch.remaining()) {
+                        Log.e(TAG, "Truncated batch on channel " + name);
+                        break;
+                    }
+                    final byte[] bytes = new byte[length];
+                    batch.get(bytes);
+                    messageHandler.onMessage(new String(bytes, UTF8));
+                }
+                reply.reply(null);
+            }
+        });
+    }
+}
@@ -15,10 +15,6 @@ import io.flutter.embedding.android.FlutterView;
 import io.flutter.embedding.engine.FlutterEngine;
 import io.flutter.embedding.engine.dart.DartExecutor;
 import io.flutter.embedding.engine.dart.DartExecutor.DartEntrypoint;
-import io.flutter.plugin.common.BasicMessageChannel;
-import io.flutter.plugin.common.BasicMessageChannel.MessageHandler;
-import io.flutter.plugin.common.BasicMessageChannel.Reply;
-import io.flutter.plugin.common.StringCodec;
 import java.util.ArrayList;
 
 public class MainActivity extends AppCompatActivity {
@@ -27,9 +23,8 @@ public class MainActivity extends AppCompatActivity {
     private FlutterView flutterView;
     private int counter;
     private static final String CHANNEL = "increment";
-    private static final String EMPTY_MESSAGE = "";
     private static final String PING = "ping";
-    private BasicMessageChannel<String> messageChannel;
+    private BatchingMessageChannel messageChannel;
 
     private String[] getArgsFromIntent(Intent intent) {
         // Before adding more entries to this list, consider that arbitrary
@@ -72,13 +67,14 @@ public class MainActivity extends AppCompatActivity {
         flutterView = findViewById(R.id.flutter_view);
         flutterView.attachToFlutterEngine(flutterEngine);
 
-        messageChannel = new BasicMessageChannel<>(flutterEngine.getDartExecutor(), CHANNEL, StringCodec.INSTANCE);
+        // Increments are batched, so that taps arriving within a frame are
+        // delivered as one platform message.
+        messageChannel = new BatchingMessageChannel(flutterEngine.getDartExecutor(), CHANNEL);
         messageChannel.
-            setMessageHandler(new MessageHandler<String>() {
+            setMessageHandler(new BatchingMessageChannel.MessageHandler() {
                 @Override
-                public void onMessage(String s, Reply<String> reply) {
+                public void onMessage(String s) {
                     onFlutterIncrement();
-                    reply.reply(EMPTY_MESSAGE);
                 }
             });
 
@@ -0,0 +1,53 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <Foundation/Foundation.h>
+#import <Flutter/Flutter.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A string message channel that coalesces the messages sent within a frame
+ * into a single binary message.
+ *
+ * A batch is encoded as a sequence of messages, each a little-endian uint32
+ * byte length followed by that many bytes of UTF-8. Flutter's side of the
+ * channel is `BatchingMessageChannel` in lib/batching_message_channel.dart.
+ */
+@interface BatchingMessageChannel : NSObject
+
+/**
+ * Whether pending messages are flushed at the next display refresh. If NO,
+ * they are flushed at the end of the current main run loop iteration.
+ * Defaults to YES.
+ */
+@property(nonatomic) BOOL flushesOnVsync;
+
+/**
+ * The size in bytes at which a pending batch is flushed right away, without
+ * waiting for the next flush. Defaults to 64KB.
+ */
+@property(nonatomic) NSUInteger maxBatchSize;
+
+- (instancetype)initWithName:(NSString*)name
+             binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger;
+
+/**
+ * Queues |message| to be sent with the next batch.
+ */
+- (void)sendMessage:(NSString*)message;
+
+/**
+ * Sends the pending batch now, if there is one.
+ */
+- (void)flush;
+
+/**
+ * Sets the handler called, in order, with each message of an incoming batch.
+ */
+- (void)setMessageHandler:(void (^_Nullable)(NSString* message))handler;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,105 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "BatchingMessageChannel.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+@implementation BatchingMessageChannel {
+  NSString* _name;
+  NSObject<FlutterBinaryMessenger>* _messenger;
+  NSMutableData* _pending;
+  // Set while a flush at the next vsync is scheduled. The display link
+  // retains the channel until it fires, so it is only kept while there are
+  // pending messages.
+  CADisplayLink* _displayLink;
+  BOOL _flushScheduled;
+}
+
+- (instancetype)initWithName:(NSString*)name
+             binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger {
+  self = [super init];
+  if (self) {
+    _name = [name copy];
+    _messenger = messenger;
+    _pending = [NSMutableData data];
+    _flushesOnVsync = YES;
+    _maxBatchSize = 64 * 1024;
+  }
+  return self;
+}
+
+- (void)sendMessage:(NSString*)message {
+  NSData* bytes = [message dataUsingEncoding:NSUTF8StringEncoding];
+  uint32_t length = CFSwapInt32HostToLittle((uint32_t)bytes.length);
+  [_pending appendBytes:&length length:sizeof(length)];
+  [_pending appendData:bytes];
+  if (_pending.length >= _maxBatchSize) {
+    [self flush];
+  } else {
+    [self scheduleFlush];
+  }
+}
+
+- (void)scheduleFlush {
+  if (_flushScheduled) {
+    return;
+  }
+  _flushScheduled = YES;
+  if (_flushesOnVsync) {
+    _displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(onDisplayLink:)];
+    [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+  } else {
+    __weak BatchingMessageChannel* weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+      [weakSelf flush];
+    });
+  }
+}
+
+- (void)onDisplayLink:(CADisplayLink*)displayLink {
+  [self flush];
+}
+
+- (void)flush {
+  [_displayLink invalidate];
+  _displayLink = nil;
+  _flushScheduled = NO;
+  if (_pending.length == 0) {
+    return;
+  }
+  NSData* batch = _pending;
+  _pending = [NSMutableData data];
+  [_messenger sendOnChannel:_name message:batch];
+}
+
+- (void)setMessageHandler:(void (^)(NSString* message))handler {
+  if (!handler) {
+    [_messenger setMessageHandlerOnChannel:_name binaryMessageHandler:nil];
+    return;
+  }
+  NSString* name = _name;
+  [_messenger setMessageHandlerOnChannel:_name
+                    binaryMessageHandler:^(NSData* batch, FlutterBinaryReply reply) {
+                      const uint8_t* bytes = batch.bytes;
+                      NSUInteger offset = 0;
+                      while (offset + sizeof(uint32_t) <= batch.length) {
+                        uint32_t length;
+                        memcpy(&length, bytes + offset, sizeof(length));
+                        length = CFSwapInt32LittleToHost(length);
+                        offset += sizeof(length);
+                        if (length > batch.length - offset) {
+                          NSLog(@"Truncated batch on channel %@", name);
+                          break;
+                        }
+                        handler([[NSString alloc] initWithBytes:bytes + offset
+                                                         length:length
+                                                       encoding:NSUTF8StringEncoding]);
+                        offset += length;
+                      }
+                      reply(nil);
+                    }];
+}
+
+@end
@@ -4,6 +4,7 @@
 
 #import <Foundation/Foundation.h>
 
+#import "BatchingMessageChannel.h"
 #import "MainViewController.h"
 #import "NativeViewController.h"
 
@@ -11,10 +12,9 @@
 
 @property (nonatomic) NativeViewController* nativeViewController;
 @property (nonatomic) FlutterViewController* flutterViewController;
-@property (nonatomic) FlutterBasicMessageChannel* messageChannel;
+@property (nonatomic) BatchingMessageChannel* messageChannel;
 @end
 
-static NSString* const emptyString = @"";
 static NSString* const ping = @"ping";
 static NSString* const channel = @"increment";
 
@@ -34,14 +34,14 @@ static NSString* const channel = @"increment";
   if ([segue.identifier isEqualToString:@"FlutterViewControllerSegue"]) {
     self.flutterViewController = segue.destinationViewController;
 
-    self.messageChannel = [FlutterBasicMessageChannel messageChannelWithName:channel
-                                                             binaryMessenger:self.flutterViewController
-                                                                       codec:[FlutterStringCodec sharedInstance]];
+    // Increments are batched, so that taps arriving within a frame are
+    // delivered as one platform message.
+    self.messageChannel = [[BatchingMessageChannel alloc] initWithName:channel
+                                                       binaryMessenger:self.flutterViewController];
 
     MainViewController*  __weak weakSelf = self;
-    [self.messageChannel setMessageHandler:^(id message, FlutterReply reply) {
+    [self.messageChannel setMessageHandler:^(NSString* message) {
       [weakSelf.nativeViewController didReceiveIncrement];
-      reply(emptyString);
     }];
   }
 }
@@ -0,0 +1,107 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:flutter/scheduler.dart';
+import 'package:flutter/services.dart';
+
+/// A string message channel that coalesces the messages sent within a frame
+/// into a single platform message.
+///
+/// A batch is encoded as a sequence of messages, each a little-endian uint32
+/// byte length followed by that many bytes of UTF-8. The platform side of the
+/// channel is `BatchingMessageChannel` in the iOS and Android runners.
+class BatchingMessageChannel {
+  BatchingMessageChannel(
+    this.name, {
+    this.flushesOnFrame = true,
+    this.maxBatchSize = 64 * 1024,
+    BinaryMessenger binaryMessenger,
+  }) : _binaryMessenger = binaryMessenger;
+
+  /// The logical channel on which communication happens.
+  final String name;
+
+  /// Whether pending messages are flushed after the next frame. If false,
+  /// they are flushed in a microtask.
+  final bool flushesOnFrame;
+
+  /// The size in bytes at which a pending batch is flushed right away.
+  final int maxBatchSize;
+
+  /// The messenger which sends the batches.
+  BinaryMessenger get binaryMessenger => _binaryMessenger ?? defaultBinaryMessenger;
+  final BinaryMessenger _binaryMessenger;
+
+  final List<Uint8List> _pending = <Uint8List>[];
+  int _pendingSize = 0;
+  bool _flushScheduled = false;
+
+  /// Queues [message] to be sent with the next batch.
+  void send(String message) {
+    final Uint8List bytes = utf8.encoder.convert(message);
+    _pending.add(bytes);
+    _pendingSize += 4 + bytes.length;
+    if (_pendingSize >= maxBatchSize)
+      flush();
+    else
+      _scheduleFlush();
+  }
+
+  void _scheduleFlush() {
+    if (_flushScheduled)
+      return;
+    _flushScheduled = true;
+    if (flushesOnFrame) {
+      SchedulerBinding.instance.addPostFrameCallback((Duration timeStamp) => flush());
+      SchedulerBinding.instance.ensureVisualUpdate();
+    } else {
+      scheduleMicrotask(flush);
+    }
+  }
+
+  /// Sends the pending batch now, if there is one.
+  void flush() {
+    _flushScheduled = false;
+    if (_pending.isEmpty)
+      return;
+    final ByteData batch = ByteData(_pendingSize);
+    int offset = 0;
+    for (final Uint8List bytes in _pending) {
+      batch.setUint32(offset, bytes.length, Endian.little);
+      offset += 4;
+      batch.buffer.asUint8List(offset, bytes.length).setAll(0, bytes);
+      offset += bytes.length;
+    }
+    _pending.clear();
+    _pendingSize = 0;
+    binaryMessenger.send(name, batch);
+  }
+
+  /// Sets a callback for receiving the messages of incoming batches, in
+  /// order.
+  ///
+  /// If [handler] is null, unregisters the existing handler.
+  void setMessageHandler(void handler(String message)) {
+    if (handler == null) {
+      binaryMessenger.setMessageHandler(name, null);
+      return;
+    }
+    binaryMessenger.setMessageHandler(name, (ByteData batch) async {
+      int offset = 0;
+      while (offset + 4 <= batch.lengthInBytes) {
+        final int length = batch.getUint32(offset, Endian.little);
+        offset += 4;
+        if (length > batch.lengthInBytes - offset)
+          throw FormatException('Truncated batch on channel $name');
+        handler(utf8.decode(batch.buffer.asUint8List(batch.offsetInBytes + offset, length)));
+        offset += length;
+      }
+      return null;
+    });
+  }
+}
@@ -2,9 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-import 'dart:async';
 import 'package:flutter/material.dart';
-import 'package:flutter/services.dart';
+
+import 'batching_message_channel.dart';
 
 void main() {
   runApp(FlutterView());
@@ -32,9 +32,9 @@ class MyHomePage extends StatefulWidget {
 class _MyHomePageState extends State<MyHomePage> {
   static const String _channel = 'increment';
   static const String _pong = 'pong';
-  static const String _emptyMessage = '';
-  static const BasicMessageChannel<String> platform =
-      BasicMessageChannel<String>(_channel, StringCodec());
+  // Increments are batched, so that taps arriving within a frame are
+  // delivered as one platform message.
+  final BatchingMessageChannel platform = BatchingMessageChannel(_channel);
 
   int _counter = 0;
 
@@ -44,11 +44,10 @@ class _MyHomePageState extends State<MyHomePage> {
     platform.setMessageHandler(_handlePlatformIncrement);
   }
 
-  Future<String> _handlePlatformIncrement(String message) async {
+  void _handlePlatformIncrement(String message) {
     setState(() {
       _counter++;
     });
-    return _emptyMessage;
   }
 
   void _sendFlutterIncrement() {
@@ -11,6 +11,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface GeneratedPluginRegistrant : NSObject
 + (void)registerWithRegistry:(NSObject<FlutterPluginRegistry>*)registry;
+// Like registerWithRegistry:, but plugins that list their channels in their
+// pubspec.yaml are only instantiated when the first message arrives on one of
+// those channels.
++ (void)registerLazilyWithRegistry:(NSObject<FlutterPluginRegistry>*)registry;
 @end
 
 NS_ASSUME_NONNULL_END
@@ -9,4 +9,7 @@
 + (void)registerWithRegistry:(NSObject<FlutterPluginRegistry>*)registry {
 }
 
++ (void)registerLazilyWithRegistry:(NSObject<FlutterPluginRegistry>*)registry {
+}
+
 @end
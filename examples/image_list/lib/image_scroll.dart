@@ -0,0 +1,301 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:async';
+import 'dart:convert' show json;
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:typed_data';
+import 'dart:ui' show FrameTiming;
+
+import 'package:flutter/material.dart';
+import 'package:flutter/scheduler.dart';
+
+import 'main.dart' show startImageServer;
+
+/// A benchmark that scrolls a long list of network and asset images, once
+/// decoding every image at its full size and once decoding it to the size it
+/// is shown at (using [ResizeImage]).
+///
+/// For each pass it prints, as part of a single line of JSON that starts with
+/// `===image_scroll===`:
+///
+///  * how long images took to fetch and to decode,
+///  * build and raster frame times,
+///  * the peak size of the image cache and the peak resident set size,
+///  * the image cache hit rate.
+///
+/// This is used in [$FH/flutter/devicelab/bin/tasks/image_list_scroll_perf.dart] test.
+Future<void> main() async {
+  final int port = await startImageServer();
+  final Map<String, dynamic> results = <String, dynamic>{};
+  for (final DecodeMode mode in DecodeMode.values) {
+    final Map<String, dynamic> passResults = await _runPass(port, mode);
+    passResults.forEach((String key, dynamic value) {
+      results['${_modeName(mode)}_$key'] = value;
+    });
+  }
+  print('===image_scroll=== ${json.encode(results)}');
+}
+
+/// How the benchmark decodes images.
+enum DecodeMode {
+  /// Decode images at their intrinsic size.
+  full,
+
+  /// Decode images at the size they are laid out at.
+  resized,
+}
+
+String _modeName(DecodeMode mode) {
+  switch (mode) {
+    case DecodeMode.full:
+      return 'full';
+    case DecodeMode.resized:
+      return 'resized';
+  }
+  throw ArgumentError('Unexpected value for enum $mode');
+}
+
+const int _rowCount = 300;
+const double _rowExtent = 120.0;
+const Duration _scrollDuration = Duration(seconds: 15);
+
+Future<Map<String, dynamic>> _runPass(int port, DecodeMode mode) async {
+  // Start every pass from an empty cache so the passes are comparable.
+  PaintingBinding.instance.imageCache
+    ..clear()
+    ..clearLiveImages();
+
+  final ImageLoadStats imageStats = ImageLoadStats();
+  final FrameStats frameStats = FrameStats();
+  final Completer<void> scrolled = Completer<void>();
+  void onTimings(List<FrameTiming> timings) {
+    frameStats.addTimings(timings);
+    imageStats.updatePeakMemory();
+  }
+  SchedulerBinding.instance.addTimingsCallback(onTimings);
+  runApp(ImageScrollApp(
+    key: ValueKey<DecodeMode>(mode),
+    port: port,
+    mode: mode,
+    stats: imageStats,
+    onScrolled: scrolled.complete,
+  ));
+  await scrolled.future;
+  SchedulerBinding.instance.removeTimingsCallback(onTimings);
+
+  final Map<String, dynamic> results = <String, dynamic>{};
+  results.addAll(imageStats.toJson());
+  results.addAll(frameStats.toJson());
+  return results;
+}
+
+/// Scrolls a list of rows of images down to the end and back up, then calls
+/// [onScrolled].
+class ImageScrollApp extends StatefulWidget {
+  const ImageScrollApp({
+    Key key,
+    @required this.port,
+    @required this.mode,
+    @required this.stats,
+    @required this.onScrolled,
+  }) : super(key: key);
+
+  final int port;
+  final DecodeMode mode;
+  final ImageLoadStats stats;
+  final VoidCallback onScrolled;
+
+  @override
+  _ImageScrollAppState createState() => _ImageScrollAppState();
+}
+
+class _ImageScrollAppState extends State<ImageScrollApp> {
+  final ScrollController _controller = ScrollController();
+
+  @override
+  void initState() {
+    super.initState();
+    WidgetsBinding.instance.addPostFrameCallback((_) => _scroll());
+  }
+
+  @override
+  void dispose() {
+    _controller.dispose();
+    super.dispose();
+  }
+
+  Future<void> _scroll() async {
+    // Scrolling back up shows images that may still be in the cache.
+    await _controller.animateTo(
+      _controller.position.maxScrollExtent,
+      duration: _scrollDuration,
+      curve: Curves.linear,
+    );
+    await _controller.animateTo(0.0, duration: _scrollDuration, curve: Curves.linear);
+    widget.onScrolled();
+  }
+
+  ImageProvider<dynamic> _image(ImageProvider<dynamic> image, int cacheWidth) {
+    if (widget.mode == DecodeMode.resized)
+      image = ResizeImage(image, width: cacheWidth);
+    return MeteredImageProvider<dynamic>(image, widget.stats);
+  }
+
+  Widget _buildRow(BuildContext context, int index) {
+    final double devicePixelRatio = MediaQuery.of(context).devicePixelRatio;
+    final int cacheWidth = (_rowExtent * devicePixelRatio).round();
+    // Every network image has its own URL and so its own cache entry, while
+    // all the asset images share one.
+    return Row(
+      children: List<Widget>.generate(3, (int column) {
+        return Expanded(
+          child: Image(
+            image: _image(
+              column == 1
+                  ? const AssetImage('images/coast.jpg')
+                  : NetworkImage('https://localhost:${widget.port}/${index * 3 + column}'),
+              cacheWidth,
+            ),
+            fit: BoxFit.cover,
+            height: _rowExtent,
+          ),
+        );
+      }),
+    );
+  }
+
+  @override
+  Widget build(BuildContext context) {
+    return MaterialApp(
+      title: 'Image Scroll Benchmark',
+      home: Scaffold(
+        body: ListView.builder(
+          controller: _controller,
+          itemExtent: _rowExtent,
+          itemCount: _rowCount,
+          itemBuilder: _buildRow,
+        ),
+      ),
+    );
+  }
+}
+
+/// Wraps an [ImageProvider] to count image cache hits and misses, and to
+/// measure how long each image that is loaded takes to fetch and to decode.
+class MeteredImageProvider<T> extends ImageProvider<T> {
+  const MeteredImageProvider(this.imageProvider, this.stats);
+
+  final ImageProvider<T> imageProvider;
+  final ImageLoadStats stats;
+
+  @override
+  Future<T> obtainKey(ImageConfiguration configuration) => imageProvider.obtainKey(configuration);
+
+  @override
+  void resolveStreamForKey(ImageConfiguration configuration, ImageStream stream, T key, ImageErrorListener handleError) {
+    stats.resolves += 1;
+    super.resolveStreamForKey(configuration, stream, key, handleError);
+  }
+
+  // Only called when the image is not in the image cache.
+  @override
+  ImageStreamCompleter load(T key, DecoderCallback decode) {
+    stats.loads += 1;
+    final Stopwatch stopwatch = Stopwatch()..start();
+    Duration fetched;
+    final ImageStreamCompleter completer = imageProvider.load(key, (Uint8List bytes, {int cacheWidth, int cacheHeight}) {
+      fetched = stopwatch.elapsed;
+      return decode(bytes, cacheWidth: cacheWidth, cacheHeight: cacheHeight);
+    });
+    ImageStreamListener listener;
+    listener = ImageStreamListener(
+      (ImageInfo image, bool synchronousCall) {
+        completer.removeListener(listener);
+        fetched ??= Duration.zero;
+        stats.addLoad(fetched, stopwatch.elapsed - fetched);
+      },
+      onError: (dynamic exception, StackTrace stackTrace) {
+        completer.removeListener(listener);
+      },
+    );
+    completer.addListener(listener);
+    return completer;
+  }
+}
+
+/// Image loading statistics collected by [MeteredImageProvider].
+class ImageLoadStats {
+  /// How many times an image was resolved, whether it was cached or not.
+  int resolves = 0;
+
+  /// How many times an image was not in the cache and had to be loaded.
+  int loads = 0;
+
+  final List<double> _fetchMillis = <double>[];
+  final List<double> _decodeMillis = <double>[];
+  int _peakCacheBytes = 0;
+  int _peakRssBytes = 0;
+
+  void addLoad(Duration fetch, Duration decode) {
+    _fetchMillis.add(fetch.inMicroseconds / 1000.0);
+    _decodeMillis.add(decode.inMicroseconds / 1000.0);
+  }
+
+  /// Samples the image cache size and the resident set size.
+  void updatePeakMemory() {
+    _peakCacheBytes = math.max(_peakCacheBytes, PaintingBinding.instance.imageCache.currentSizeBytes);
+    _peakRssBytes = math.max(_peakRssBytes, ProcessInfo.currentRss);
+  }
+
+  Map<String, dynamic> toJson() {
+    return <String, dynamic>{
+      'image_loads': loads,
+      'image_cache_hit_rate': resolves == 0 ? 0.0 : (resolves - loads) / resolves,
+      'average_image_fetch_millis': _average(_fetchMillis),
+      'average_image_decode_millis': _average(_decodeMillis),
+      '90th_percentile_image_decode_millis': _percentile(_decodeMillis, 90),
+      'peak_image_cache_bytes': _peakCacheBytes,
+      'peak_rss_bytes': _peakRssBytes,
+    };
+  }
+}
+
+/// Frame build and raster times reported by the engine.
+class FrameStats {
+  final List<double> _buildMillis = <double>[];
+  final List<double> _rasterMillis = <double>[];
+
+  void addTimings(List<FrameTiming> timings) {
+    for (final FrameTiming timing in timings) {
+      _buildMillis.add(timing.buildDuration.inMicroseconds / 1000.0);
+      _rasterMillis.add(timing.rasterDuration.inMicroseconds / 1000.0);
+    }
+  }
+
+  Map<String, dynamic> toJson() {
+    return <String, dynamic>{
+      'frame_count': _rasterMillis.length,
+      'average_frame_build_time_millis': _average(_buildMillis),
+      'average_frame_rasterizer_time_millis': _average(_rasterMillis),
+      '90th_percentile_frame_rasterizer_time_millis': _percentile(_rasterMillis, 90),
+      '99th_percentile_frame_rasterizer_time_millis': _percentile(_rasterMillis, 99),
+      'worst_frame_rasterizer_time_millis': _rasterMillis.isEmpty ? 0.0 : _rasterMillis.reduce(math.max),
+    };
+  }
+}
+
+double _average(List<double> values) {
+  if (values.isEmpty)
+    return 0.0;
+  return values.reduce((double a, double b) => a + b) / values.length;
+}
+
+double _percentile(List<double> values, int percentile) {
+  if (values.isEmpty)
+    return 0.0;
+  final List<double> sorted = List<double>.from(values)..sort();
+  return sorted[((sorted.length - 1) * percentile / 100).round()];
+}
@@ -82,6 +82,13 @@ class MyHttpOverrides extends HttpOverrides {
 }
 
 Future<void> main() async {
+  final int port = await startImageServer();
+  runApp(MyApp(port));
+}
+
+/// Starts a local https server that serves `images/coast.jpg` in small chunks
+/// for any path, and returns its port.
+Future<int> startImageServer() async {
   HttpOverrides.global = MyHttpOverrides();
 
   final SecurityContext serverContext = SecurityContext()
@@ -109,8 +116,7 @@ Future<void> main() async {
     }
     request.response.close();
   });
-
-  runApp(MyApp(port));
+  return port;
 }
 
 const int IMAGES = 50;
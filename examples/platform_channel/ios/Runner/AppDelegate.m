@@ -4,26 +4,67 @@
 
 #import "AppDelegate.h"
 #import <Flutter/Flutter.h>
+#import "ChargingStressStreamHandler.h"
+#import "FastPathRegistry.h"
 #import "GeneratedPluginRegistrant.h"
+#import "QueuedMethodChannel.h"
+
+@interface AppDelegate ()
+// The battery level as last read on the main thread, since UIDevice must not
+// be used from the battery channel's queue.
+@property(atomic) int batteryLevel;
+@end
+
+// The fast path behind getBatteryLevel. |user_data| is the AppDelegate.
+static int64_t QueryBatteryLevel(void* user_data) {
+  return ((__bridge AppDelegate*)user_data).batteryLevel;
+}
 
 @implementation AppDelegate {
   FlutterEventSink _eventSink;
+  QueuedMethodChannel* _batteryChannel;
+  ChargingStressStreamHandler* _chargingStressHandler;
 }
 
 - (BOOL)application:(UIApplication*)application
     didFinishLaunchingWithOptions:(NSDictionary*)launchOptions {
-  [GeneratedPluginRegistrant registerWithRegistry:self];
+  [GeneratedPluginRegistrant registerLazilyWithRegistry:self];
   FlutterViewController* controller =
       (FlutterViewController*)self.window.rootViewController;
 
-  FlutterMethodChannel* batteryChannel = [FlutterMethodChannel
-      methodChannelWithName:@"samples.flutter.io/battery"
-            binaryMessenger:controller];
   __weak typeof(self) weakSelf = self;
-  [batteryChannel setMethodCallHandler:^(FlutterMethodCall* call,
-                                         FlutterResult result) {
+  self.batteryLevel = [self getBatteryLevel];
+  void (^updateBatteryLevel)(NSNotification*) = ^(NSNotification* notification) {
+    weakSelf.batteryLevel = [weakSelf getBatteryLevel];
+  };
+  NSNotificationCenter* center = [NSNotificationCenter defaultCenter];
+  NSOperationQueue* mainQueue = [NSOperationQueue mainQueue];
+  [center addObserverForName:UIDeviceBatteryLevelDidChangeNotification
+                      object:nil
+                       queue:mainQueue
+                  usingBlock:updateBatteryLevel];
+  [center addObserverForName:UIDeviceBatteryStateDidChangeNotification
+                      object:nil
+                       queue:mainQueue
+                  usingBlock:updateBatteryLevel];
+  // The same value is available synchronously, without a channel call. The
+  // app delegate lives as long as the process, so it isn't retained.
+  FlutterRunnerRegisterFastPath("samples.flutter.io/battery_level", QueryBatteryLevel,
+                                (__bridge void*)self);
+
+  // Battery calls are handled on a background queue, so a slow handler
+  // doesn't block the main thread.
+  dispatch_queue_t batteryQueue = dispatch_queue_create(
+      "samples.flutter.io/battery", DISPATCH_QUEUE_SERIAL);
+  _batteryChannel = [[QueuedMethodChannel alloc]
+      initWithName:@"samples.flutter.io/battery"
+   binaryMessenger:controller
+             codec:[FlutterStandardMethodCodec sharedInstance]
+             queue:batteryQueue];
+  [_batteryChannel setMethodCallHandler:^(FlutterMethodCall* call,
+                                          FlutterResult result) {
     if ([@"getBatteryLevel" isEqualToString:call.method]) {
-      int batteryLevel = [weakSelf getBatteryLevel];
+      int batteryLevel = weakSelf.batteryLevel;
       if (batteryLevel == -1) {
         result([FlutterError errorWithCode:@"UNAVAILABLE"
                                    message:@"Battery info unavailable"
@@ -40,6 +81,8 @@
       eventChannelWithName:@"samples.flutter.io/charging"
            binaryMessenger:controller];
   [chargingChannel setStreamHandler:self];
+  _chargingStressHandler =
+      [[ChargingStressStreamHandler alloc] initWithBinaryMessenger:controller];
   return [super application:application didFinishLaunchingWithOptions:launchOptions];
 }
 
@@ -0,0 +1,49 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <Flutter/Flutter.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Wraps a FlutterEventSink with flow control.
+ *
+ * At most |window| events are in flight, that is, sent but not yet
+ * acknowledged by the Dart side. Further events wait in a buffer of
+ * |capacity| events. When the buffer is full, a new event either replaces the
+ * newest buffered one, if coalescing, or pushes out the oldest.
+ *
+ * Must be used from the main thread.
+ */
+@interface BackpressureEventSink : NSObject
+
+@property(nonatomic, readonly) NSUInteger sentCount;
+@property(nonatomic, readonly) NSUInteger droppedCount;
+@property(nonatomic, readonly) NSUInteger coalescedCount;
+@property(nonatomic, readonly) NSUInteger bufferedCount;
+
+- (instancetype)initWithEventSink:(FlutterEventSink)eventSink
+                           window:(NSUInteger)window
+                         capacity:(NSUInteger)capacity
+                       coalescing:(BOOL)coalescing;
+
+/**
+ * Sends |event| if the window allows, and buffers it otherwise.
+ */
+- (void)addEvent:(id)event;
+
+/**
+ * Records that the Dart side has handled |count| events, and sends buffered
+ * events into the freed window.
+ */
+- (void)acknowledgeEvents:(NSUInteger)count;
+
+/**
+ * The counters, for reporting back to the Dart side.
+ */
+- (NSDictionary*)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,77 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "BackpressureEventSink.h"
+
+@implementation BackpressureEventSink {
+  FlutterEventSink _eventSink;
+  NSUInteger _window;
+  NSUInteger _capacity;
+  BOOL _coalescing;
+  NSUInteger _inFlight;
+  NSMutableArray* _buffer;
+}
+
+- (instancetype)initWithEventSink:(FlutterEventSink)eventSink
+                           window:(NSUInteger)window
+                         capacity:(NSUInteger)capacity
+                       coalescing:(BOOL)coalescing {
+  self = [super init];
+  if (self) {
+    _eventSink = [eventSink copy];
+    _window = MAX(window, 1u);
+    _capacity = MAX(capacity, 1u);
+    _coalescing = coalescing;
+    _buffer = [NSMutableArray arrayWithCapacity:_capacity];
+  }
+  return self;
+}
+
+- (NSUInteger)bufferedCount {
+  return _buffer.count;
+}
+
+- (void)addEvent:(id)event {
+  if (_inFlight < _window && _buffer.count == 0) {
+    [self send:event];
+    return;
+  }
+  if (_buffer.count < _capacity) {
+    [_buffer addObject:event];
+  } else if (_coalescing) {
+    _buffer[_buffer.count - 1] = event;
+    _coalescedCount++;
+  } else {
+    [_buffer removeObjectAtIndex:0];
+    [_buffer addObject:event];
+    _droppedCount++;
+  }
+}
+
+- (void)acknowledgeEvents:(NSUInteger)count {
+  _inFlight -= MIN(count, _inFlight);
+  while (_inFlight < _window && _buffer.count > 0) {
+    id event = _buffer[0];
+    [_buffer removeObjectAtIndex:0];
+    [self send:event];
+  }
+}
+
+- (void)send:(id)event {
+  _inFlight++;
+  _sentCount++;
+  _eventSink(event);
+}
+
+- (NSDictionary*)statistics {
+  return @{
+    @"sent" : @(_sentCount),
+    @"dropped" : @(_droppedCount),
+    @"coalesced" : @(_coalescedCount),
+    @"buffered" : @(_buffer.count),
+    @"inFlight" : @(_inFlight),
+  };
+}
+
+@end
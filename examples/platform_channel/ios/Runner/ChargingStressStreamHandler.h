@@ -0,0 +1,25 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <Flutter/Flutter.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Streams battery state events at a high rate through a
+ * BackpressureEventSink, to stress event channel flow control.
+ *
+ * Listens on "samples.flutter.io/charging_stress". The listen arguments may
+ * set the 'rate' in Hz, the 'window' and 'capacity' of the sink, and whether
+ * it is 'coalescing'. The Dart side acknowledges handled events by sending
+ * their count on "samples.flutter.io/charging_stress/ack", and gets the sink
+ * statistics in reply.
+ */
+@interface ChargingStressStreamHandler : NSObject <FlutterStreamHandler>
+
+- (instancetype)initWithBinaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,93 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "ChargingStressStreamHandler.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+#import "BackpressureEventSink.h"
+
+@implementation ChargingStressStreamHandler {
+  FlutterEventChannel* _eventChannel;
+  FlutterBasicMessageChannel* _ackChannel;
+  BackpressureEventSink* _sink;
+  dispatch_source_t _timer;
+  NSUInteger _sequence;
+}
+
+- (instancetype)initWithBinaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger {
+  self = [super init];
+  if (self) {
+    _eventChannel = [FlutterEventChannel eventChannelWithName:@"samples.flutter.io/charging_stress"
+                                              binaryMessenger:messenger];
+    [_eventChannel setStreamHandler:self];
+    _ackChannel = [FlutterBasicMessageChannel
+        messageChannelWithName:@"samples.flutter.io/charging_stress/ack"
+               binaryMessenger:messenger
+                         codec:[FlutterStandardMessageCodec sharedInstance]];
+    __weak ChargingStressStreamHandler* weakSelf = self;
+    [_ackChannel setMessageHandler:^(id message, FlutterReply reply) {
+      ChargingStressStreamHandler* strongSelf = weakSelf;
+      BackpressureEventSink* sink = strongSelf ? strongSelf->_sink : nil;
+      [sink acknowledgeEvents:[message unsignedIntegerValue]];
+      reply([sink statistics]);
+    }];
+  }
+  return self;
+}
+
+- (FlutterError*)onListenWithArguments:(id)arguments eventSink:(FlutterEventSink)eventSink {
+  NSDictionary* options = [arguments isKindOfClass:[NSDictionary class]] ? arguments : @{};
+  double rate = options[@"rate"] ? [options[@"rate"] doubleValue] : 200.0;
+  NSUInteger window = options[@"window"] ? [options[@"window"] unsignedIntegerValue] : 4;
+  NSUInteger capacity = options[@"capacity"] ? [options[@"capacity"] unsignedIntegerValue] : 16;
+  BOOL coalescing = [options[@"coalescing"] boolValue];
+  if (rate <= 0) {
+    return [FlutterError errorWithCode:@"BAD_ARGS"
+                               message:@"The rate must be positive"
+                               details:nil];
+  }
+
+  [self stopTimer];
+  _sequence = 0;
+  _sink = [[BackpressureEventSink alloc] initWithEventSink:eventSink
+                                                    window:window
+                                                  capacity:capacity
+                                                coalescing:coalescing];
+  [UIDevice currentDevice].batteryMonitoringEnabled = YES;
+  _timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_main_queue());
+  uint64_t interval = (uint64_t)(NSEC_PER_SEC / rate);
+  dispatch_source_set_timer(_timer, dispatch_time(DISPATCH_TIME_NOW, interval), interval, 0);
+  __weak ChargingStressStreamHandler* weakSelf = self;
+  dispatch_source_set_event_handler(_timer, ^{
+    [weakSelf emitEvent];
+  });
+  dispatch_resume(_timer);
+  return nil;
+}
+
+- (void)emitEvent {
+  UIDeviceBatteryState state = [UIDevice currentDevice].batteryState;
+  BOOL charging = state == UIDeviceBatteryStateCharging || state == UIDeviceBatteryStateFull;
+  [_sink addEvent:@{
+    @"sequence" : @(_sequence++),
+    @"timestamp" : @(CACurrentMediaTime()),
+    @"charging" : @(charging),
+  }];
+}
+
+- (FlutterError*)onCancelWithArguments:(id)arguments {
+  [self stopTimer];
+  _sink = nil;
+  return nil;
+}
+
+- (void)stopTimer {
+  if (_timer) {
+    dispatch_source_cancel(_timer);
+    _timer = nil;
+  }
+}
+
+@end
@@ -0,0 +1,68 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "FastPathRegistry.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+
+#define FAST_PATH_CAPACITY 64
+#define FAST_PATH_MAX_NAME_LENGTH 63
+
+typedef struct {
+  char name[FAST_PATH_MAX_NAME_LENGTH + 1];
+  int64_t (*query)(void* user_data);
+  void* user_data;
+} FastPath;
+
+// Entries are only ever appended, and each is written before the count that
+// publishes it, so readers need no lock.
+static FastPath gFastPaths[FAST_PATH_CAPACITY];
+static _Atomic int32_t gCount = 0;
+
+// Serializes registrations.
+static pthread_mutex_t gRegistrationMutex = PTHREAD_MUTEX_INITIALIZER;
+
+bool FlutterRunnerRegisterFastPath(const char* name,
+                                   int64_t (*query)(void* user_data),
+                                   void* user_data) {
+  if (!name || !query || strlen(name) > FAST_PATH_MAX_NAME_LENGTH) {
+    return false;
+  }
+  pthread_mutex_lock(&gRegistrationMutex);
+  int32_t count = atomic_load_explicit(&gCount, memory_order_relaxed);
+  bool registered = count < FAST_PATH_CAPACITY;
+  for (int32_t i = 0; registered && i < count; i++) {
+    registered = strcmp(gFastPaths[i].name, name) != 0;
+  }
+  if (registered) {
+    FastPath* fastPath = &gFastPaths[count];
+    strlcpy(fastPath->name, name, sizeof(fastPath->name));
+    fastPath->query = query;
+    fastPath->user_data = user_data;
+    atomic_store_explicit(&gCount, count + 1, memory_order_release);
+  }
+  pthread_mutex_unlock(&gRegistrationMutex);
+  return registered;
+}
+
+int32_t FlutterRunnerFastPathCount(void) {
+  return atomic_load_explicit(&gCount, memory_order_acquire);
+}
+
+const char* FlutterRunnerFastPathName(int32_t index) {
+  if (index < 0 || index >= atomic_load_explicit(&gCount, memory_order_acquire)) {
+    return NULL;
+  }
+  return gFastPaths[index].name;
+}
+
+int64_t FlutterRunnerQueryFastPath(int32_t index) {
+  if (index < 0 || index >= atomic_load_explicit(&gCount, memory_order_acquire)) {
+    return INT64_MIN;
+  }
+  const FastPath* fastPath = &gFastPaths[index];
+  return fastPath->query(fastPath->user_data);
+}
@@ -0,0 +1,49 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAST_PATH_REGISTRY_H_
+#define FAST_PATH_REGISTRY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * A registry of small native queries that Dart calls synchronously through
+ * dart:ffi (see lib/fast_path.dart), for values that are read too often to go
+ * through a method channel. A channel call is encoded, hops to the main
+ * thread and back, and allocates its reply; a fast path query is a direct call
+ * on the UI thread.
+ *
+ * These are the functions the Linux and Windows runner templates export, so
+ * the Dart side is the same on every platform. They are exported from the app
+ * executable, which Release and Profile builds strip only of non-global
+ * symbols so that Dart can find them.
+ *
+ * Queries are called on the UI thread, concurrently with the main thread, so
+ * they must be thread-safe and must not block: read a value that another
+ * thread keeps up to date, e.g. in an atomic. Queries stay registered for the
+ * life of the process.
+ */
+
+#define FAST_PATH_EXPORT __attribute__((visibility("default"), used))
+
+/**
+ * Registers |query| under |name|, to be called with |user_data|. |name| is
+ * copied. Returns false if |name| is already registered, is longer than 63
+ * bytes, or if the registry is full.
+ */
+FAST_PATH_EXPORT bool FlutterRunnerRegisterFastPath(const char* name,
+                                                    int64_t (*query)(void* user_data),
+                                                    void* user_data);
+
+/** Returns the number of registered queries. Indices below this are valid. */
+FAST_PATH_EXPORT int32_t FlutterRunnerFastPathCount(void);
+
+/** Returns the name of query |index|, or NULL if there is no such query. */
+FAST_PATH_EXPORT const char* FlutterRunnerFastPathName(int32_t index);
+
+/** Calls query |index|. Returns INT64_MIN if there is no such query. */
+FAST_PATH_EXPORT int64_t FlutterRunnerQueryFastPath(int32_t index);
+
+#endif  // FAST_PATH_REGISTRY_H_
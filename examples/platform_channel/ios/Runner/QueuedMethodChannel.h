@@ -0,0 +1,36 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <Flutter/Flutter.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A method channel whose calls are decoded, handled, and replied to on a
+ * dispatch queue of the caller's choosing instead of the main thread.
+ *
+ * Use it for handlers that do slow work, such as disk or crypto, so that they
+ * don't hold up UIKit or the engine's platform tasks. Handlers must not use
+ * UIKit, since they don't run on the main thread.
+ */
+@interface QueuedMethodChannel : NSObject
+
+- (instancetype)initWithName:(NSString*)name
+             binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger
+                       codec:(NSObject<FlutterMethodCodec>*)codec
+                       queue:(dispatch_queue_t)queue;
+
+/**
+ * Sets the handler of incoming method calls, or unregisters the existing one
+ * if |handler| is nil.
+ *
+ * |handler| runs on the channel's queue, and may call its result callback
+ * from any thread. The reply goes straight to the engine, without going
+ * through the main thread.
+ */
+- (void)setMethodCallHandler:(FlutterMethodCallHandler _Nullable)handler;
+
+@end
+
+NS_ASSUME_NONNULL_END
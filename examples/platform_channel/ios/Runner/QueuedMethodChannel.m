@@ -0,0 +1,55 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "QueuedMethodChannel.h"
+
+@implementation QueuedMethodChannel {
+  NSString* _name;
+  NSObject<FlutterBinaryMessenger>* _messenger;
+  NSObject<FlutterMethodCodec>* _codec;
+  dispatch_queue_t _queue;
+}
+
+- (instancetype)initWithName:(NSString*)name
+             binaryMessenger:(NSObject<FlutterBinaryMessenger>*)messenger
+                       codec:(NSObject<FlutterMethodCodec>*)codec
+                       queue:(dispatch_queue_t)queue {
+  self = [super init];
+  if (self) {
+    _name = [name copy];
+    _messenger = messenger;
+    _codec = codec;
+    _queue = queue;
+  }
+  return self;
+}
+
+- (void)setMethodCallHandler:(FlutterMethodCallHandler)handler {
+  if (!handler) {
+    [_messenger setMessageHandlerOnChannel:_name binaryMessageHandler:nil];
+    return;
+  }
+  // The engine delivers messages on the main thread, so that hop can't be
+  // avoided. Everything after it, including decoding the call, happens on
+  // the queue.
+  NSObject<FlutterMethodCodec>* codec = _codec;
+  dispatch_queue_t queue = _queue;
+  [_messenger setMessageHandlerOnChannel:_name
+                    binaryMessageHandler:^(NSData* message, FlutterBinaryReply reply) {
+                      dispatch_async(queue, ^{
+                        FlutterMethodCall* call = [codec decodeMethodCall:message];
+                        handler(call, ^(id result) {
+                          if (result == FlutterMethodNotImplemented) {
+                            reply(nil);
+                          } else if ([result isKindOfClass:[FlutterError class]]) {
+                            reply([codec encodeErrorEnvelope:(FlutterError*)result]);
+                          } else {
+                            reply([codec encodeSuccessEnvelope:result]);
+                          }
+                        });
+                      });
+                    }];
+}
+
+@end
@@ -0,0 +1,135 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:async';
+
+import 'package:flutter/material.dart';
+import 'package:flutter/services.dart';
+
+/// Streams battery state events from the platform at a high rate, with
+/// flow control. iOS only.
+///
+/// Every handled event is acknowledged on [ackChannel], which lets the
+/// platform send more. While the isolate is busy, events wait on the
+/// platform side in a bounded buffer instead of queueing up in the engine.
+class ChargingStress extends StatefulWidget {
+  const ChargingStress({
+    Key key,
+    this.rate = 200,
+    this.window = 4,
+    this.capacity = 16,
+    this.coalescing = false,
+  }) : super(key: key);
+
+  /// The rate at which the platform produces events, in Hz.
+  final double rate;
+
+  /// How many events may be sent but not yet acknowledged.
+  final int window;
+
+  /// How many events the platform buffers beyond the window.
+  final int capacity;
+
+  /// Whether a full buffer replaces its newest event rather than dropping the
+  /// oldest one.
+  final bool coalescing;
+
+  @override
+  ChargingStressState createState() => ChargingStressState();
+}
+
+class ChargingStressState extends State<ChargingStress> {
+  static const EventChannel eventChannel =
+      EventChannel('samples.flutter.io/charging_stress');
+  static const BasicMessageChannel<dynamic> ackChannel =
+      BasicMessageChannel<dynamic>(
+    'samples.flutter.io/charging_stress/ack',
+    StandardMessageCodec(),
+  );
+
+  StreamSubscription<dynamic> _subscription;
+  int _received = 0;
+  int _lastSequence = -1;
+  int _gaps = 0;
+  bool _busy = false;
+
+  /// The platform's counters, as of the last acknowledgement.
+  Map<dynamic, dynamic> platformStatistics = <dynamic, dynamic>{};
+
+  /// The counters seen on both sides.
+  Map<String, dynamic> get statistics {
+    final Map<String, dynamic> result = <String, dynamic>{
+      'received': _received,
+      'gaps': _gaps,
+    };
+    platformStatistics.forEach((dynamic key, dynamic value) {
+      result[key as String] = value;
+    });
+    return result;
+  }
+
+  @override
+  void initState() {
+    super.initState();
+    _subscription = eventChannel.receiveBroadcastStream(<String, dynamic>{
+      'rate': widget.rate,
+      'window': widget.window,
+      'capacity': widget.capacity,
+      'coalescing': widget.coalescing,
+    }).listen(_onEvent);
+  }
+
+  @override
+  void dispose() {
+    _subscription.cancel();
+    super.dispose();
+  }
+
+  Future<void> _onEvent(dynamic event) async {
+    final int sequence = event['sequence'] as int;
+    if (sequence != _lastSequence + 1)
+      _gaps++;
+    _lastSequence = sequence;
+    _received++;
+    if (_busy) {
+      // Simulates an isolate too busy to keep up with the event rate.
+      final Stopwatch watch = Stopwatch()..start();
+      while (watch.elapsedMilliseconds < 20) {}
+    }
+    final Map<dynamic, dynamic> reply =
+        await ackChannel.send(1) as Map<dynamic, dynamic>;
+    if (!mounted)
+      return;
+    setState(() {
+      platformStatistics = reply ?? <dynamic, dynamic>{};
+    });
+  }
+
+  @override
+  Widget build(BuildContext context) {
+    final List<Widget> children = statistics.entries
+        .map<Widget>((MapEntry<String, dynamic> entry) => Text('${entry.key}: ${entry.value}'))
+        .toList();
+    children.add(SwitchListTile(
+      key: const Key('Busy switch'),
+      title: const Text('Busy isolate'),
+      value: _busy,
+      onChanged: (bool value) {
+        setState(() {
+          _busy = value;
+        });
+      },
+    ));
+    return Material(
+      child: Column(
+        mainAxisAlignment: MainAxisAlignment.center,
+        children: children,
+      ),
+    );
+  }
+}
+
+void main() {
+  runApp(const MaterialApp(home: ChargingStress()));
+}
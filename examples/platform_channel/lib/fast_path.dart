@@ -0,0 +1,89 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:ffi' as ffi;
+
+typedef _CountNative = ffi.Int32 Function();
+typedef _Count = int Function();
+typedef _NameNative = ffi.Pointer<ffi.Uint8> Function(ffi.Int32 index);
+typedef _Name = ffi.Pointer<ffi.Uint8> Function(int index);
+typedef _QueryNative = ffi.Int64 Function(ffi.Int32 index);
+typedef _Query = int Function(int index);
+
+/// A small native query that can be called synchronously, without a platform
+/// channel.
+///
+/// Hosts register queries by name with `FlutterRunnerRegisterFastPath`, which
+/// the Linux and Windows runners export and which this example's iOS host
+/// provides (see `ios/Runner/FastPathRegistry.h`). Use them for values that
+/// are read too often for a channel, such as per-frame layout metrics or
+/// sensor snapshots: a call is a direct native call on the UI thread, with no
+/// encoding, thread hop, or reply allocation. Anything slow, or with side
+/// effects, still belongs on a channel.
+class FastPath {
+  FastPath._(this.name, this._index);
+
+  /// The name the query was registered with.
+  final String name;
+
+  final int _index;
+
+  /// Returns the query registered as [name], or null if there is none,
+  /// including when the host doesn't provide the registry.
+  static FastPath lookup(String name) {
+    final _Registry registry = _Registry.instance;
+    final int index = registry?.indexOf(name);
+    return index == null ? null : FastPath._(name, index);
+  }
+
+  /// Calls the query and returns its value.
+  int call() => _Registry.instance.query(_index);
+}
+
+/// The registry functions, looked up once per isolate.
+class _Registry {
+  _Registry._(this._count, this._name, this.query);
+
+  /// Null if the host doesn't export the registry.
+  static final _Registry instance = _load();
+
+  static _Registry _load() {
+    try {
+      final ffi.DynamicLibrary host = ffi.DynamicLibrary.executable();
+      return _Registry._(
+        host.lookupFunction<_CountNative, _Count>('FlutterRunnerFastPathCount'),
+        host.lookupFunction<_NameNative, _Name>('FlutterRunnerFastPathName'),
+        host.lookupFunction<_QueryNative, _Query>('FlutterRunnerQueryFastPath'),
+      );
+    } on ArgumentError {
+      return null;
+    } on UnsupportedError {
+      return null;
+    }
+  }
+
+  final _Count _count;
+  final _Name _name;
+  final _Query query;
+
+  /// The indices of the queries read so far, by name.
+  final Map<String, int> _indices = <String, int>{};
+
+  /// Returns the index of the query registered as [name], or null if there
+  /// is none.
+  int indexOf(String name) {
+    // Queries are only ever added, so only the new ones need reading.
+    final int count = _count();
+    for (int index = _indices.length; index < count; index += 1)
+      _indices[_readName(_name(index))] = index;
+    return _indices[name];
+  }
+
+  static String _readName(ffi.Pointer<ffi.Uint8> name) {
+    final List<int> codeUnits = <int>[];
+    for (int offset = 0; name.elementAt(offset).value != 0; offset += 1)
+      codeUnits.add(name.elementAt(offset).value);
+    return String.fromCharCodes(codeUnits);
+  }
+}
@@ -0,0 +1,32 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:async';
+
+import 'package:flutter/services.dart';
+
+import 'fast_path.dart';
+
+const MethodChannel _batteryChannel = MethodChannel('samples.flutter.io/battery');
+
+/// Reads the battery level [iterations] times through the battery method
+/// channel, one call at a time, and then through its fast path, and returns
+/// the mean microseconds per read of each, keyed by "methodChannel" and
+/// "fastPath". "fastPath" is missing if the host doesn't register it.
+Future<Map<String, double>> runFastPathBenchmark({int iterations = 10000}) async {
+  final Map<String, double> results = <String, double>{};
+  final Stopwatch watch = Stopwatch()..start();
+  for (int i = 0; i < iterations; i += 1)
+    await _batteryChannel.invokeMethod<int>('getBatteryLevel');
+  results['methodChannel'] = watch.elapsedMicroseconds / iterations;
+
+  final FastPath batteryLevel = FastPath.lookup('samples.flutter.io/battery_level');
+  if (batteryLevel != null) {
+    watch.reset();
+    for (int i = 0; i < iterations; i += 1)
+      batteryLevel();
+    results['fastPath'] = watch.elapsedMicroseconds / iterations;
+  }
+  return results;
+}
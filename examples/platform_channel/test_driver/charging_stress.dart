@@ -0,0 +1,18 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:convert';
+
+import 'package:flutter/material.dart';
+import 'package:flutter_driver/driver_extension.dart';
+import 'package:platform_channel/charging_stress.dart';
+
+final GlobalKey<ChargingStressState> _stressKey = GlobalKey<ChargingStressState>();
+
+void main() {
+  enableFlutterDriverExtension(handler: (String message) async {
+    return json.encode(_stressKey.currentState.statistics);
+  });
+  runApp(MaterialApp(home: ChargingStress(key: _stressKey)));
+}
@@ -0,0 +1,48 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:convert';
+
+import 'package:flutter_driver/flutter_driver.dart';
+import 'package:test/test.dart' hide TypeMatcher, isInstanceOf;
+
+// Must match the defaults of ChargingStress.
+const int window = 4;
+const int capacity = 16;
+
+void main() {
+  group('charging stress', () {
+    FlutterDriver driver;
+
+    setUpAll(() async {
+      driver = await FlutterDriver.connect();
+    });
+
+    Future<Map<String, dynamic>> statistics() async {
+      return json.decode(await driver.requestData('statistics')) as Map<String, dynamic>;
+    }
+
+    test('keeps up while idle', () async {
+      await Future<void>.delayed(const Duration(seconds: 5));
+      final Map<String, dynamic> stats = await statistics();
+      print('Idle: $stats');
+      expect(stats['received'], greaterThan(0));
+      expect(stats['buffered'], lessThanOrEqualTo(capacity));
+    });
+
+    test('bounds the backlog while busy', () async {
+      await driver.tap(find.byValueKey('Busy switch'));
+      await Future<void>.delayed(const Duration(seconds: 5));
+      final Map<String, dynamic> stats = await statistics();
+      print('Busy: $stats');
+      expect(stats['buffered'], lessThanOrEqualTo(capacity));
+      expect(stats['inFlight'], lessThanOrEqualTo(window));
+      expect(stats['dropped'], greaterThan(0));
+    });
+
+    tearDownAll(() async {
+      driver?.close();
+    });
+  });
+}
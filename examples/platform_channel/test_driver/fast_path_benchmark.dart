@@ -0,0 +1,16 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:convert';
+
+import 'package:flutter_driver/driver_extension.dart';
+import 'package:platform_channel/fast_path_benchmark.dart';
+import 'package:platform_channel/main.dart' as app;
+
+void main() {
+  enableFlutterDriverExtension(handler: (String message) async {
+    return json.encode(await runFastPathBenchmark());
+  });
+  app.main();
+}
@@ -0,0 +1,30 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:convert';
+
+import 'package:flutter_driver/flutter_driver.dart';
+import 'package:test/test.dart' hide TypeMatcher, isInstanceOf;
+
+void main() {
+  group('fast path benchmark', () {
+    FlutterDriver driver;
+
+    setUpAll(() async {
+      driver = await FlutterDriver.connect();
+    });
+
+    test('reads the battery level faster than the method channel', () async {
+      final Map<String, dynamic> results =
+          json.decode(await driver.requestData('run')) as Map<String, dynamic>;
+      print('Microseconds per read: $results');
+      expect(results['methodChannel'], greaterThan(0));
+      expect(results['fastPath'], lessThan(results['methodChannel']));
+    }, timeout: const Timeout(Duration(minutes: 2)));
+
+    tearDownAll(() async {
+      driver?.close();
+    });
+  });
+}
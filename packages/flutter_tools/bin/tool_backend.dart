@@ -9,6 +9,9 @@ import 'package:path/path.dart' as path; // ignore: package_path_import.
 Future<void> main(List<String> arguments) async {
   final String targetPlatform = arguments[0];
   final String buildMode = arguments[1].toLowerCase();
+  // An optional path to write a depfile listing the build's inputs and
+  // outputs to, so that the calling build system can tell when to rerun it.
+  final String depfile = arguments.length > 2 ? arguments[2] : null;
 
   final String projectDirectory = Platform.environment['PROJECT_DIR'];
   final bool verbose = Platform.environment['VERBOSE_SCRIPT_LOGGING'] != null;
@@ -50,6 +53,7 @@ or
           '-dBuildMode=debug',
           '-dTargetFile=$flutterTarget',
           '--output=build',
+          if (depfile != null) '--depfile=$depfile',
           'debug_bundle_linux_assets',
         ]);
     if (unpackResult.exitCode != 0) {
@@ -49,10 +49,16 @@ export PROJECT_DIR=${linuxProject.project.directory.path}
     buffer.writeln('export LOCAL_ENGINE=${globals.fs.path.basename(engineOutPath)}');
   }
 
-  /// Cache flutter configuration files in the linux directory.
-  linuxProject.generatedMakeConfigFile
-    ..createSync(recursive: true)
-    ..writeAsStringSync(buffer.toString());
+  /// Cache flutter configuration files in the linux directory. The Makefile
+  /// reruns the flutter build step whenever this file is newer than its last
+  /// run, so it is only rewritten when the configuration changes.
+  final File configFile = linuxProject.generatedMakeConfigFile;
+  final String config = buffer.toString();
+  if (!configFile.existsSync() || configFile.readAsStringSync() != config) {
+    configFile
+      ..createSync(recursive: true)
+      ..writeAsStringSync(config);
+  }
   createPluginSymlinks(linuxProject.project);
 
   if (!buildInfo.isDebug) {
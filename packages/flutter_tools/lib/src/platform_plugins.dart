@@ -164,14 +164,17 @@ class IOSPlugin extends PluginPlatform {
     @required this.name,
     this.classPrefix,
     @required this.pluginClass,
-  });
+    this.channels = const <String>[],
+  }) : assert(channels != null);
 
   factory IOSPlugin.fromYaml(String name, YamlMap yaml) {
     assert(validate(yaml));
+    final YamlList channels = yaml[kChannels] as YamlList;
     return IOSPlugin(
       name: name,
       classPrefix: '',
       pluginClass: yaml['pluginClass'] as String,
+      channels: channels == null ? const <String>[] : channels.cast<String>().toList(),
     );
   }
 
@@ -179,11 +182,19 @@ class IOSPlugin extends PluginPlatform {
     if (yaml == null) {
       return false;
     }
+    final dynamic channels = yaml[kChannels];
+    if (channels != null &&
+        (channels is! YamlList || !(channels as YamlList).every((dynamic channel) => channel is String))) {
+      return false;
+    }
     return yaml['pluginClass'] is String;
   }
 
   static const String kConfigKey = 'ios';
 
+  /// The key for the list of channel names the plugin handles messages on.
+  static const String kChannels = 'channels';
+
   final String name;
 
   /// Note, this is here only for legacy reasons. Multi-platform format
@@ -191,12 +202,27 @@ class IOSPlugin extends PluginPlatform {
   final String classPrefix;
   final String pluginClass;
 
+  /// The names of the channels this plugin handles messages on.
+  ///
+  /// When not empty, `registerLazilyWithRegistry:` in the generated plugin
+  /// registrant only instantiates the plugin when the first message arrives on
+  /// one of these channels. A lazily registered plugin misses application
+  /// delegate callbacks that happen before then, such as
+  /// `application:didFinishLaunchingWithOptions:`, so plugins that rely on
+  /// those should not list their channels.
+  final List<String> channels;
+
   @override
   Map<String, dynamic> toMap() {
     return <String, dynamic>{
       'name': name,
       'prefix': classPrefix,
       'class': pluginClass,
+      // Mustache doesn't support complex types.
+      'lazy': channels.isNotEmpty,
+      'channels': <Map<String, String>>[
+        for (final String channel in channels) <String, String>{'channel': channel},
+      ],
     };
   }
 }
@@ -61,6 +61,8 @@ class Plugin {
   ///            pluginClass: SamplePlugin
   ///          ios:
   ///            pluginClass: SamplePlugin
+  ///            channels:
+  ///              - plugins.flutter.io/sample
   ///          linux:
   ///            pluginClass: SamplePlugin
   ///          macos:
@@ -659,6 +661,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface GeneratedPluginRegistrant : NSObject
 + (void)registerWithRegistry:(NSObject<FlutterPluginRegistry>*)registry;
+// Like registerWithRegistry:, but plugins that list their channels in their
+// pubspec.yaml are only instantiated when the first message arrives on one of
+// those channels.
++ (void)registerLazilyWithRegistry:(NSObject<FlutterPluginRegistry>*)registry;
 @end
 
 NS_ASSUME_NONNULL_END
@@ -680,6 +686,131 @@ const String _objcPluginRegistryImplementationTemplate = '''
 #endif
 
 {{/plugins}}
+{{#hasLazyPlugins}}
+// Forwards to the real messenger, and remembers the message handlers a lazily
+// registered plugin sets so that the message that triggered its registration
+// can be handed to it.
+@interface FLTLazyPluginMessenger : NSObject <FlutterBinaryMessenger>
+@property(nonatomic, readonly) NSMutableDictionary<NSString*, FlutterBinaryMessageHandler>* handlers;
+- (instancetype)initWithMessenger:(NSObject<FlutterBinaryMessenger>*)messenger;
+@end
+
+@implementation FLTLazyPluginMessenger {
+  NSObject<FlutterBinaryMessenger>* _messenger;
+}
+
+- (instancetype)initWithMessenger:(NSObject<FlutterBinaryMessenger>*)messenger {
+  self = [super init];
+  if (self) {
+    _messenger = messenger;
+    _handlers = [NSMutableDictionary dictionary];
+  }
+  return self;
+}
+
+- (void)sendOnChannel:(NSString*)channel message:(NSData*)message {
+  [_messenger sendOnChannel:channel message:message];
+}
+
+- (void)sendOnChannel:(NSString*)channel
+              message:(NSData*)message
+          binaryReply:(FlutterBinaryReply)callback {
+  [_messenger sendOnChannel:channel message:message binaryReply:callback];
+}
+
+- (void)setMessageHandlerOnChannel:(NSString*)channel
+              binaryMessageHandler:(FlutterBinaryMessageHandler)handler {
+  _handlers[channel] = [handler copy];
+  [_messenger setMessageHandlerOnChannel:channel binaryMessageHandler:handler];
+}
+
+- (id)forwardingTargetForSelector:(SEL)selector {
+  return _messenger;
+}
+
+@end
+
+// Forwards to the real registrar, except that plugins get a
+// FLTLazyPluginMessenger as their messenger.
+@interface FLTLazyPluginRegistrar : NSProxy
+- (instancetype)initWithRegistrar:(NSObject<FlutterPluginRegistrar>*)registrar
+                        messenger:(FLTLazyPluginMessenger*)messenger;
+@end
+
+@implementation FLTLazyPluginRegistrar {
+  NSObject<FlutterPluginRegistrar>* _registrar;
+  FLTLazyPluginMessenger* _messenger;
+}
+
+- (instancetype)initWithRegistrar:(NSObject<FlutterPluginRegistrar>*)registrar
+                        messenger:(FLTLazyPluginMessenger*)messenger {
+  _registrar = registrar;
+  _messenger = messenger;
+  return self;
+}
+
+- (NSObject<FlutterBinaryMessenger>*)messenger {
+  return _messenger;
+}
+
+- (NSMethodSignature*)methodSignatureForSelector:(SEL)selector {
+  return [_registrar methodSignatureForSelector:selector];
+}
+
+- (void)forwardInvocation:(NSInvocation*)invocation {
+  [invocation invokeWithTarget:_registrar];
+}
+
+@end
+
+// Holds a placeholder handler on each of a plugin's channels, and registers
+// the plugin when the first message arrives on any of them. Registering
+// replaces the placeholders with the plugin's own handlers.
+@interface FLTLazyPluginRegistration : NSObject
++ (void)registerPlugin:(Class<FlutterPlugin>)pluginClass
+         withRegistrar:(NSObject<FlutterPluginRegistrar>*)registrar
+            onChannels:(NSArray<NSString*>*)channels;
+@end
+
+@implementation FLTLazyPluginRegistration {
+  Class<FlutterPlugin> _pluginClass;
+  NSObject<FlutterPluginRegistrar>* _registrar;
+  // Set once the plugin has been registered.
+  FLTLazyPluginMessenger* _messenger;
+}
+
++ (void)registerPlugin:(Class<FlutterPlugin>)pluginClass
+         withRegistrar:(NSObject<FlutterPluginRegistrar>*)registrar
+            onChannels:(NSArray<NSString*>*)channels {
+  FLTLazyPluginRegistration* registration = [[FLTLazyPluginRegistration alloc] init];
+  registration->_pluginClass = pluginClass;
+  registration->_registrar = registrar;
+  for (NSString* channel in channels) {
+    [registrar.messenger setMessageHandlerOnChannel:channel
+                               binaryMessageHandler:^(NSData* message, FlutterBinaryReply reply) {
+                                 [registration handleMessage:message onChannel:channel reply:reply];
+                               }];
+  }
+}
+
+- (void)handleMessage:(NSData*)message onChannel:(NSString*)channel reply:(FlutterBinaryReply)reply {
+  if (!_messenger) {
+    _messenger = [[FLTLazyPluginMessenger alloc] initWithMessenger:_registrar.messenger];
+    FLTLazyPluginRegistrar* registrar =
+        [[FLTLazyPluginRegistrar alloc] initWithRegistrar:_registrar messenger:_messenger];
+    [_pluginClass registerWithRegistrar:(NSObject<FlutterPluginRegistrar>*)registrar];
+  }
+  FlutterBinaryMessageHandler handler = _messenger.handlers[channel];
+  if (handler) {
+    handler(message, reply);
+  } else {
+    reply(nil);
+  }
+}
+
+@end
+
+{{/hasLazyPlugins}}
 @implementation GeneratedPluginRegistrant
 
 + (void)registerWithRegistry:(NSObject<FlutterPluginRegistry>*)registry {
@@ -688,6 +819,19 @@ const String _objcPluginRegistryImplementationTemplate = '''
 {{/plugins}}
 }
 
++ (void)registerLazilyWithRegistry:(NSObject<FlutterPluginRegistry>*)registry {
+{{#plugins}}
+{{#lazy}}
+  [FLTLazyPluginRegistration registerPlugin:[{{prefix}}{{class}} class]
+                              withRegistrar:[registry registrarForPlugin:@"{{prefix}}{{class}}"]
+                                 onChannels:@[{{#channels}}@"{{channel}}", {{/channels}}]];
+{{/lazy}}
+{{^lazy}}
+  [{{prefix}}{{class}} registerWithRegistrar:[registry registrarForPlugin:@"{{prefix}}{{class}}"]];
+{{/lazy}}
+{{/plugins}}
+}
+
 @end
 ''';
 
@@ -837,6 +981,7 @@ Future<void> _writeIOSPluginRegistrant(FlutterProject project, List<Plugin> plug
     'deploymentTarget': '8.0',
     'framework': 'Flutter',
     'plugins': iosPlugins,
+    'hasLazyPlugins': iosPlugins.any((Map<String, dynamic> plugin) => plugin['lazy'] == true),
   };
   final String registryDirectory = project.ios.pluginRegistrantHost.path;
   if (project.isModule) {
@@ -965,9 +1110,14 @@ Future<void> _writeWindowsPluginProperties(WindowsProject project, List<Map<Stri
   final String symlinkDirPath = project.pluginSymlinkDirectory.path.substring(projectDir.length + 1);
   final List<String> pluginIncludePaths = windowsPlugins.map((Map<String, dynamic> plugin) =>
     globals.fs.path.join(symlinkDirPath, plugin['name'] as String, 'windows')).toList();
+  // Plugin DLLs are only called into from plugin registration, so delay
+  // loading them keeps them off the process loader's critical path.
+  final List<String> pluginDllFilenames = windowsPlugins.map(
+    (Map<String, dynamic> plugin) => '${plugin['name']}_plugin.dll').toList();
   project.generatedPluginPropertySheetFile.writeAsStringSync(PropertySheet(
     includePaths: pluginIncludePaths,
     libraryDependencies: pluginLibraryFilenames,
+    delayLoadLibraries: pluginDllFilenames,
   ).toString());
 }
 
@@ -12,6 +12,7 @@ class PropertySheet {
     this.environmentVariables,
     this.includePaths,
     this.libraryDependencies,
+    this.delayLoadLibraries,
   });
 
   /// Variables to make available both as build macros and as environment
@@ -24,6 +25,9 @@ class PropertySheet {
   /// Libraries to link against.
   final List<String> libraryDependencies;
 
+  /// DLLs to load on the first call into them, rather than at process start.
+  final List<String> delayLoadLibraries;
+
   @override
   String toString() {
     // See https://docs.microsoft.com/en-us/cpp/build/reference/vcxproj-file-structure#property-sheet-layout
@@ -70,17 +74,28 @@ class PropertySheet {
     });
   }
 
-  /// Adds libraries to the link step.
+  /// Adds libraries to the link step, along with any DLLs to delay load.
   ///
   /// Must be called within the context of the ItemDefinitionGroup.
   void _addLibraryDependencies(xml.XmlBuilder builder) {
-    if (libraryDependencies == null || libraryDependencies.isEmpty) {
+    final bool hasDelayLoadLibraries = delayLoadLibraries != null && delayLoadLibraries.isNotEmpty;
+    final List<String> dependencies = <String>[
+      ...?libraryDependencies,
+      // Delay loading is implemented by helpers in delayimp.lib.
+      if (hasDelayLoadLibraries) 'delayimp.lib',
+    ];
+    if (dependencies.isEmpty) {
       return;
     }
     builder.element('Link', nest: () {
       builder.element('AdditionalDependencies', nest: () {
-        builder.text('${libraryDependencies.join(';')};%(AdditionalDependencies)');
+        builder.text('${dependencies.join(';')};%(AdditionalDependencies)');
       });
+      if (hasDelayLoadLibraries) {
+        builder.element('DelayLoadDLLs', nest: () {
+          builder.text('${delayLoadLibraries.join(';')};%(DelayLoadDLLs)');
+        });
+      }
     });
   }
 
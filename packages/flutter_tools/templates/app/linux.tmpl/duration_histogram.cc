@@ -0,0 +1,62 @@
+#include "duration_histogram.h"
+
+#include <algorithm>
+
+void DurationHistogram::Record(std::chrono::nanoseconds duration) {
+  if (duration.count() < 0) {
+    duration = std::chrono::nanoseconds(0);
+  }
+  uint64_t microseconds = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+  size_t bucket = 0;
+  while (microseconds >= 2 && bucket + 1 < kBucketCount) {
+    microseconds >>= 1;
+    ++bucket;
+  }
+  ++buckets_[bucket];
+  ++count_;
+  total_ += duration;
+  if (duration > longest_) {
+    longest_ = duration;
+  }
+}
+
+std::chrono::microseconds DurationHistogram::Percentile(
+    double percentile) const {
+  if (count_ == 0) {
+    return std::chrono::microseconds(0);
+  }
+  // The rank of the requested sample, rounded up so that e.g. the 50th
+  // percentile of a single sample is that sample.
+  double rank = percentile / 100.0 * static_cast<double>(count_);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    seen += buckets_[i];
+    if (buckets_[i] > 0 && static_cast<double>(seen) >= rank) {
+      // The exclusive upper bound of bucket i is 2^(i+1) microseconds, but
+      // never report more than the longest duration.
+      std::chrono::microseconds bound(int64_t{1} << (i + 1));
+      auto longest_microseconds =
+          std::chrono::duration_cast<std::chrono::microseconds>(longest_);
+      return bound < longest_microseconds ? bound : longest_microseconds;
+    }
+  }
+  return std::chrono::duration_cast<std::chrono::microseconds>(longest_);
+}
+
+DurationHistogram DurationHistogram::Since(
+    const DurationHistogram &earlier) const {
+  DurationHistogram since;
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    since.buckets_[i] = buckets_[i] - earlier.buckets_[i];
+    if (since.buckets_[i] > 0) {
+      // The exclusive upper bound of the bucket, but never more than the
+      // longest duration overall.
+      since.longest_ = std::min<std::chrono::nanoseconds>(
+          std::chrono::microseconds(int64_t{1} << (i + 1)), longest_);
+    }
+  }
+  since.count_ = count_ - earlier.count_;
+  since.total_ = total_ - earlier.total_;
+  return since;
+}
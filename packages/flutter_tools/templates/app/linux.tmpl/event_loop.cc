@@ -0,0 +1,263 @@
+#include "event_loop.h"
+
+#include <dlfcn.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+
+namespace {
+
+// The default maximum delay in dispatching ready file descriptors.
+constexpr std::chrono::milliseconds kDefaultPollInterval(4);
+
+// The maximum time the shared engine wait can delay another window's
+// delayed tasks.
+constexpr std::chrono::milliseconds kDelayedTaskInterval(100);
+
+// The shortest engine wait. A zero timeout means "wait forever" to the
+// engine.
+constexpr std::chrono::milliseconds kMinimumWait(1);
+
+// The maximum number of ready file descriptors dispatched per epoll_wait.
+constexpr int kMaxEventsPerDispatch = 32;
+
+using PostEmptyEventFunction = void (*)();
+
+// Returns GLFW's glfwPostEmptyEvent, which wakes glfwWaitEvents from any
+// thread, or nullptr if the embedding library doesn't export it.
+PostEmptyEventFunction GetPostEmptyEvent() {
+  return reinterpret_cast<PostEmptyEventFunction>(
+      dlsym(RTLD_DEFAULT, "glfwPostEmptyEvent"));
+}
+
+}  // namespace
+
+EventLoop::EventLoop()
+    : epoll_fd_(epoll_create1(EPOLL_CLOEXEC)),
+      poll_interval_(kDefaultPollInterval) {
+  if (epoll_fd_ < 0) {
+    std::cerr << "Unable to create epoll instance: errno " << errno
+              << std::endl;
+  }
+  PostEmptyEventFunction post_empty_event = GetPostEmptyEvent();
+  if (post_empty_event) {
+    wake_ = post_empty_event;
+  }
+}
+
+EventLoop::~EventLoop() {
+  StopWatcher();
+  if (epoll_fd_ >= 0) {
+    close(epoll_fd_);
+  }
+}
+
+bool EventLoop::AddFd(int fd, uint32_t events, FdCallback callback) {
+  if (epoll_fd_ < 0) {
+    return false;
+  }
+  struct epoll_event event = {};
+  event.events = events;
+  event.data.fd = fd;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+    return false;
+  }
+  fd_callbacks_[fd] = std::move(callback);
+  return true;
+}
+
+void EventLoop::RemoveFd(int fd) {
+  if (fd_callbacks_.erase(fd) > 0) {
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+  }
+}
+
+void EventLoop::SetPollInterval(std::chrono::milliseconds poll_interval) {
+  poll_interval_ = std::max(kMinimumWait, poll_interval);
+}
+
+void EventLoop::SetWakeFunction(std::function<void()> wake) {
+  wake_ = std::move(wake);
+}
+
+void EventLoop::SetTrace(RecentTrace *trace) {
+  trace_ = trace;
+}
+
+void EventLoop::AddWindow(flutter::FlutterWindowController *flutter_controller,
+                          std::function<void()> on_closed) {
+  windows_.push_back({flutter_controller, std::move(on_closed)});
+}
+
+void EventLoop::Run(flutter::FlutterWindowController *flutter_controller) {
+  bool watching = StartWatcher();
+  while (true) {
+    std::chrono::milliseconds timeout = std::chrono::milliseconds::max();
+    // The timeout for the other windows' engines, which only run their due
+    // tasks when there is a wake function.
+    std::chrono::milliseconds window_timeout = kMinimumWait;
+    if (!windows_.empty() && wake_) {
+      timeout = kDelayedTaskInterval;
+    } else if (!windows_.empty()) {
+      timeout = std::max(
+          kMinimumWait,
+          poll_interval_ / static_cast<int>(windows_.size() + 1));
+      window_timeout = timeout;
+    } else if (!watching && !fd_callbacks_.empty()) {
+      timeout = poll_interval_;
+    }
+    if (!RunEngine(flutter_controller, timeout)) {
+      break;
+    }
+    for (size_t i = 0; i < windows_.size();) {
+      if (wake_) {
+        wake_();
+      }
+      if (RunEngine(windows_[i].flutter_controller, window_timeout)) {
+        ++i;
+        continue;
+      }
+      // Remove the window first, since the callback may add another.
+      std::function<void()> on_closed = std::move(windows_[i].on_closed);
+      windows_.erase(windows_.begin() + i);
+      if (on_closed) {
+        on_closed();
+      }
+    }
+    if (watching) {
+      if (fds_ready_) {
+        DispatchEvents(watched_events_.data(), watched_event_count_);
+        {
+          std::lock_guard<std::mutex> lock(watcher_mutex_);
+          fds_ready_ = false;
+        }
+        watcher_condition_.notify_one();
+      }
+    } else if (!fd_callbacks_.empty()) {
+      DispatchReadyFds();
+    }
+  }
+  StopWatcher();
+}
+
+bool EventLoop::RunEngine(flutter::FlutterWindowController *flutter_controller,
+                          std::chrono::milliseconds timeout) {
+  auto engine_start = std::chrono::steady_clock::now();
+  bool keep_running = flutter_controller->RunEventLoopWithTimeout(timeout);
+  auto engine_end = std::chrono::steady_clock::now();
+  statistics_.engine_durations.Record(engine_end - engine_start);
+  if (trace_) {
+    trace_->AddEvent("EngineEventLoop", engine_start, engine_end);
+  }
+  return keep_running;
+}
+
+void EventLoop::DispatchReadyFds() {
+  struct epoll_event events[kMaxEventsPerDispatch];
+  int count = epoll_wait(epoll_fd_, events, kMaxEventsPerDispatch, 0);
+  DispatchEvents(events, count);
+}
+
+void EventLoop::DispatchEvents(const struct epoll_event *events, int count) {
+  for (int i = 0; i < count; ++i) {
+    // Look the callback up each time, since an earlier callback may have
+    // removed this descriptor.
+    auto it = fd_callbacks_.find(events[i].data.fd);
+    if (it == fd_callbacks_.end()) {
+      continue;
+    }
+    // Copy the callback, since it may remove its own descriptor.
+    FdCallback callback = it->second;
+    auto dispatch_start = std::chrono::steady_clock::now();
+    callback(events[i].events);
+    auto dispatch_end = std::chrono::steady_clock::now();
+    statistics_.fd_dispatch_durations.Record(dispatch_end - dispatch_start);
+    if (trace_) {
+      trace_->AddEvent("FdCallback", dispatch_start, dispatch_end,
+                       events[i].data.fd);
+    }
+  }
+}
+
+bool EventLoop::StartWatcher() {
+  if (!wake_ || epoll_fd_ < 0 || watcher_.joinable()) {
+    return false;
+  }
+  stop_fd_ = eventfd(0, EFD_CLOEXEC);
+  if (stop_fd_ < 0) {
+    return false;
+  }
+  struct epoll_event stop_event = {};
+  stop_event.events = EPOLLIN;
+  stop_event.data.fd = stop_fd_;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, stop_fd_, &stop_event) != 0) {
+    close(stop_fd_);
+    stop_fd_ = -1;
+    return false;
+  }
+  watched_events_.resize(kMaxEventsPerDispatch);
+  watched_event_count_ = 0;
+  fds_ready_ = false;
+  stopping_ = false;
+  watcher_ = std::thread(&EventLoop::WatchFds, this);
+  return true;
+}
+
+void EventLoop::StopWatcher() {
+  if (!watcher_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(watcher_mutex_);
+    stopping_ = true;
+  }
+  watcher_condition_.notify_one();
+  uint64_t stop = 1;
+  if (write(stop_fd_, &stop, sizeof(stop)) < 0) {
+    std::cerr << "Unable to stop the event loop watcher: errno " << errno
+              << std::endl;
+  }
+  watcher_.join();
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, stop_fd_, nullptr);
+  close(stop_fd_);
+  stop_fd_ = -1;
+}
+
+void EventLoop::WatchFds() {
+  while (true) {
+    // The events are read here rather than by polling the epoll descriptor
+    // and reading them in Run, since polling it polls each descriptor, which
+    // consumes the events of those like PSI triggers.
+    int count = epoll_wait(epoll_fd_, watched_events_.data(),
+                           static_cast<int>(watched_events_.size()), -1);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      std::cerr << "Unable to watch event loop descriptors: errno " << errno
+                << std::endl;
+      return;
+    }
+    for (int i = 0; i < count; ++i) {
+      if (watched_events_[i].data.fd == stop_fd_) {
+        return;
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock(watcher_mutex_);
+      watched_event_count_ = count;
+      fds_ready_ = true;
+    }
+    wake_();
+    // Level-triggered descriptors stay ready until their callbacks have run,
+    // so wait for Run to dispatch them rather than waking it again.
+    std::unique_lock<std::mutex> lock(watcher_mutex_);
+    watcher_condition_.wait(lock, [this] { return !fds_ready_ || stopping_; });
+    if (stopping_) {
+      return;
+    }
+  }
+}
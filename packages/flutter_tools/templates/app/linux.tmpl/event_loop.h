@@ -0,0 +1,171 @@
+#ifndef EVENT_LOOP_H_
+#define EVENT_LOOP_H_
+
+#include <flutter/flutter_window_controller.h>
+#include <sys/epoll.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "duration_histogram.h"
+#include "recent_trace.h"
+
+// A single-threaded event loop that services the Flutter engine and window
+// events along with registered file descriptors (sockets, eventfd, timerfd,
+// etc.), so that native event sources don't need their own threads.
+//
+// The engine's GLFW event wait can't include other file descriptors, so they
+// are watched by a helper thread, which waits for them to become ready,
+// collects their events and then wakes the engine wait (see
+// SetWakeFunction). Their callbacks are still called on the event loop
+// thread, after the engine wait returns, so the loop blocks until there is
+// work of any kind, and an idle app doesn't wake up at all.
+//
+// Each readiness is read from epoll only once, by whichever thread is
+// waiting, and the callbacks get those events. This matters for descriptors
+// whose events are consumed by being polled, such as PSI triggers (see
+// MemoryPressureMonitor), which report each event to only one poll.
+//
+// Without a wake function, the engine wait is instead bounded by the poll
+// interval while any descriptors are registered, and ready descriptors are
+// dispatched after each wait.
+//
+// Windows added with AddWindow, each with its own engine, are serviced by the
+// same loop. GLFW's event queue is shared by every window, and every engine
+// wakes it when posting a task, so one blocking wait (in Run's own engine)
+// ends when any window has input or any engine has work. The other engines
+// then run their due tasks, each with a wake posted first so that it doesn't
+// wait. Tasks an engine schedules for later only end its own wait, so while
+// other windows are open the shared wait also ends at least every 100ms to
+// run those.
+//
+// Without a wake function, an engine can't be stopped from waiting, so while
+// there is more than one window, each wait is instead bounded by the poll
+// interval divided among the windows (but at least 1ms).
+class EventLoop {
+ public:
+  // Called with the ready epoll event mask (EPOLLIN, EPOLLOUT, etc.).
+  using FdCallback = std::function<void(uint32_t events)>;
+
+  // Histograms describing how the event loop's time has been spent.
+  struct Statistics {
+    // The time spent in each engine event loop call, which includes both
+    // waiting for and handling window events and engine tasks.
+    DurationHistogram engine_durations;
+    // The time taken by each file descriptor callback.
+    DurationHistogram fd_dispatch_durations;
+  };
+
+  EventLoop();
+  ~EventLoop();
+
+  // Prevent copying
+  EventLoop(EventLoop const &) = delete;
+  EventLoop &operator=(EventLoop const &) = delete;
+
+  // Watches |fd| for |events| (an epoll event mask), calling |callback| on
+  // the event loop thread when any are ready. The caller retains ownership of
+  // |fd|, and must remove it before closing it. Returns false on failure.
+  bool AddFd(int fd, uint32_t events, FdCallback callback);
+
+  // Stops watching |fd|.
+  void RemoveFd(int fd);
+
+  // Sets the maximum time registered file descriptors can be ready before
+  // being dispatched when there is no wake function. Lower values reduce
+  // latency at the cost of more frequent wakeups.
+  void SetPollInterval(std::chrono::milliseconds poll_interval);
+
+  // Sets the function called, from another thread, to end the engine's
+  // current wait early when registered file descriptors become ready. It
+  // must be safe to call from any thread. Must be called before Run.
+  //
+  // Defaults to GLFW's glfwPostEmptyEvent if the embedding library exports
+  // it (GLFW is linked into the embedding rather than the runner, so it's
+  // looked up at runtime), and to none otherwise.
+  void SetWakeFunction(std::function<void()> wake);
+
+  // Services the window managed by |flutter_controller| while Run runs, in
+  // addition to Run's own window. When the window is closed, it stops being
+  // serviced and |on_closed| is called on the event loop thread, which must
+  // destroy the window (see FlutterWindowController::DestroyWindow).
+  void AddWindow(flutter::FlutterWindowController *flutter_controller,
+                 std::function<void()> on_closed);
+
+  // Runs until the window managed by |flutter_controller| is closed. Added
+  // windows that are still open then are left for the caller to destroy.
+  void Run(flutter::FlutterWindowController *flutter_controller);
+
+  // Sets a trace to record each engine event loop call and file descriptor
+  // callback in. Pass nullptr to stop recording.
+  void SetTrace(RecentTrace *trace);
+
+  // Returns the histograms accumulated since the event loop was created.
+  const Statistics &statistics() const { return statistics_; }
+
+ private:
+  // A window added with AddWindow.
+  struct Window {
+    flutter::FlutterWindowController *flutter_controller;
+    std::function<void()> on_closed;
+  };
+
+  // Runs one engine event loop call for |flutter_controller|, returning
+  // false if its window has been closed.
+  bool RunEngine(flutter::FlutterWindowController *flutter_controller,
+                 std::chrono::milliseconds timeout);
+
+  // Calls the callbacks for all currently ready file descriptors.
+  void DispatchReadyFds();
+
+  // Calls the callbacks for the first |count| of |events|.
+  void DispatchEvents(const struct epoll_event *events, int count);
+
+  // Starts the thread that watches the registered file descriptors and calls
+  // wake_, returning false if there is no wake function or the thread can't
+  // be started.
+  bool StartWatcher();
+
+  // Stops the watcher thread, if it's running.
+  void StopWatcher();
+
+  // The watcher thread's body. Waits for registered descriptors to become
+  // ready, stores their events in watched_events_, sets fds_ready_ and wakes
+  // the engine wait, then waits until Run has dispatched the events before
+  // watching again.
+  void WatchFds();
+
+  int epoll_fd_;
+  // See SetWakeFunction.
+  std::function<void()> wake_;
+  std::thread watcher_;
+  // An eventfd that is signaled to stop the watcher. It's in the epoll set
+  // while the watcher runs, without a callback.
+  int stop_fd_ = -1;
+  // Set by the watcher when descriptors are ready, and cleared by Run once
+  // they have been dispatched. watcher_mutex_ and watcher_condition_ are used
+  // to wait for it to be cleared.
+  std::atomic<bool> fds_ready_{false};
+  // The events the watcher read, which only Run accesses while fds_ready_ is
+  // set.
+  std::vector<struct epoll_event> watched_events_;
+  int watched_event_count_ = 0;
+  bool stopping_ = false;
+  std::mutex watcher_mutex_;
+  std::condition_variable watcher_condition_;
+  std::map<int, FdCallback> fd_callbacks_;
+  std::vector<Window> windows_;
+  std::chrono::milliseconds poll_interval_;
+  Statistics statistics_;
+  // See SetTrace.
+  RecentTrace *trace_ = nullptr;
+};
+
+#endif  // EVENT_LOOP_H_
@@ -0,0 +1,70 @@
+#include "fast_path_registry.h"
+
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <mutex>
+
+namespace {
+
+constexpr int32_t kCapacity = 64;
+constexpr size_t kMaxNameLength = 63;
+
+struct FastPath {
+  char name[kMaxNameLength + 1];
+  int64_t (*query)(void *user_data);
+  void *user_data;
+};
+
+// Entries are only ever appended, and each is written before the count that
+// publishes it, so readers need no lock.
+FastPath g_fast_paths[kCapacity];
+std::atomic<int32_t> g_count(0);
+
+// Serializes registrations.
+std::mutex g_registration_mutex;
+
+}  // namespace
+
+bool FlutterRunnerRegisterFastPath(const char *name,
+                                   int64_t (*query)(void *user_data),
+                                   void *user_data) {
+  if (!name || !query || strlen(name) > kMaxNameLength) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(g_registration_mutex);
+  int32_t count = g_count.load(std::memory_order_relaxed);
+  if (count == kCapacity) {
+    return false;
+  }
+  for (int32_t i = 0; i < count; ++i) {
+    if (strcmp(g_fast_paths[i].name, name) == 0) {
+      return false;
+    }
+  }
+  FastPath &fast_path = g_fast_paths[count];
+  strcpy(fast_path.name, name);
+  fast_path.query = query;
+  fast_path.user_data = user_data;
+  g_count.store(count + 1, std::memory_order_release);
+  return true;
+}
+
+int32_t FlutterRunnerFastPathCount() {
+  return g_count.load(std::memory_order_acquire);
+}
+
+const char *FlutterRunnerFastPathName(int32_t index) {
+  if (index < 0 || index >= g_count.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  return g_fast_paths[index].name;
+}
+
+int64_t FlutterRunnerQueryFastPath(int32_t index) {
+  if (index < 0 || index >= g_count.load(std::memory_order_acquire)) {
+    return INT64_MIN;
+  }
+  const FastPath &fast_path = g_fast_paths[index];
+  return fast_path.query(fast_path.user_data);
+}
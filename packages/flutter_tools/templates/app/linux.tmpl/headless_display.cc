@@ -0,0 +1,116 @@
+#include "headless_display.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+
+// How long to wait for Xvfb to report its display number.
+constexpr std::chrono::seconds kStartTimeout(10);
+
+// Reads the display number that Xvfb writes to |fd| once it is ready to
+// accept connections, returning an empty string on failure.
+std::string ReadDisplayNumber(int fd) {
+  std::string display_number;
+  auto deadline = std::chrono::steady_clock::now() + kStartTimeout;
+  while (true) {
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now());
+    if (remaining.count() <= 0) {
+      return "";
+    }
+    struct pollfd poll_fd = {fd, POLLIN, 0};
+    int ready = poll(&poll_fd, 1, static_cast<int>(remaining.count()));
+    if (ready < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ready <= 0) {
+      return "";
+    }
+    char buffer[16];
+    ssize_t length = read(fd, buffer, sizeof(buffer));
+    if (length <= 0) {
+      // Xvfb exited without reporting a display.
+      return "";
+    }
+    display_number.append(buffer, length);
+    size_t newline = display_number.find('\n');
+    if (newline != std::string::npos) {
+      return display_number.substr(0, newline);
+    }
+  }
+}
+
+}  // namespace
+
+HeadlessDisplay::HeadlessDisplay() = default;
+
+HeadlessDisplay::~HeadlessDisplay() {
+  if (server_pid_ > 0) {
+    kill(server_pid_, SIGTERM);
+    waitpid(server_pid_, nullptr, 0);
+  }
+}
+
+bool HeadlessDisplay::Start(unsigned int width, unsigned int height) {
+  int fds[2];
+  if (pipe2(fds, O_CLOEXEC) != 0) {
+    std::cerr << "Unable to create pipe for Xvfb: " << strerror(errno)
+              << std::endl;
+    return false;
+  }
+  // Everything the child needs is prepared before forking, since only
+  // async-signal-safe calls can be made between fork and exec.
+  std::string display_fd = std::to_string(fds[1]);
+  std::string screen =
+      std::to_string(width) + "x" + std::to_string(height) + "x24";
+  const char *arguments[] = {"Xvfb",      "-displayfd", display_fd.c_str(),
+                             "-screen",   "0",          screen.c_str(),
+                             "-nolisten", "tcp",        nullptr};
+  pid_t parent_pid = getpid();
+  pid_t pid = fork();
+  if (pid == 0) {
+    // Stop the server if the runner dies without running the destructor.
+    prctl(PR_SET_PDEATHSIG, SIGTERM);
+    if (getppid() != parent_pid) {
+      _exit(EXIT_FAILURE);
+    }
+    // Keep the write end open across exec for -displayfd.
+    fcntl(fds[1], F_SETFD, 0);
+    execvp(arguments[0], const_cast<char *const *>(arguments));
+    _exit(127);
+  }
+  close(fds[1]);
+  if (pid < 0) {
+    std::cerr << "Unable to start Xvfb: " << strerror(errno) << std::endl;
+    close(fds[0]);
+    return false;
+  }
+  server_pid_ = pid;
+
+  std::string display_number = ReadDisplayNumber(fds[0]);
+  close(fds[0]);
+  if (display_number.empty()) {
+    std::cerr << "Xvfb didn't start; headless mode requires Xvfb to be "
+                 "installed"
+              << std::endl;
+    kill(server_pid_, SIGTERM);
+    waitpid(server_pid_, nullptr, 0);
+    server_pid_ = -1;
+    return false;
+  }
+  setenv("DISPLAY", (":" + display_number).c_str(), 1);
+  std::cerr << "Running headless on display :" << display_number << std::endl;
+  return true;
+}
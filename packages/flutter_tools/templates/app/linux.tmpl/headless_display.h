@@ -0,0 +1,38 @@
+#ifndef HEADLESS_DISPLAY_H_
+#define HEADLESS_DISPLAY_H_
+
+#include <sys/types.h>
+
+// A private X server for running without a display server, such as on CI
+// machines and render farms.
+//
+// The GLFW embedding always renders into a window, and doesn't expose the
+// engine's offscreen rendering API, so headless mode runs the window on its
+// own Xvfb server instead. Each instance asks Xvfb for a free display number,
+// so several runners can share a host, and the server is stopped when the
+// runner exits (or dies). Xvfb has no GPU, so rendering uses the software
+// renderer; combine with software_render_threads and cpu_affinity to divide
+// a many-core host between instances. Frames are paced by the engine's
+// 60Hz fallback vsync, as Xvfb has no display to sync to, and frame timings
+// can be collected through RunnerMetrics as usual.
+class HeadlessDisplay {
+ public:
+  HeadlessDisplay();
+
+  // Stops the server, if it was started.
+  ~HeadlessDisplay();
+
+  // Prevent copying
+  HeadlessDisplay(HeadlessDisplay const &) = delete;
+  HeadlessDisplay &operator=(HeadlessDisplay const &) = delete;
+
+  // Starts Xvfb with a |width| x |height| screen and points DISPLAY at it.
+  // Must be called before the window controller is created. Returns false if
+  // Xvfb isn't installed or doesn't start.
+  bool Start(unsigned int width, unsigned int height);
+
+ private:
+  pid_t server_pid_ = -1;
+};
+
+#endif  // HEADLESS_DISPLAY_H_
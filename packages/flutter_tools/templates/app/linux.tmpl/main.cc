@@ -1,39 +1,90 @@
 #include <flutter/flutter_window_controller.h>
+#include <flutter/plugin_registrar_glfw.h>
 #include <linux/limits.h>
 #include <unistd.h>
 
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "event_loop.h"
 #include "flutter/generated_plugin_registrant.h"
-#include "window_configuration.h"
+#include "headless_display.h"
+#include "memory_pressure_monitor.h"
+#include "pixel_buffer_registrar.h"
+#include "project_prefetcher.h"
+#include "renderer_selection.h"
+#include "runner_configuration.h"
+#include "runner_diagnostics.h"
+#include "runner_metrics.h"
+#include "secondary_windows.h"
+#include "thread_scheduling.h"
 
 namespace {
 
+// The channel used by the framework for system messages, which uses a JSON
+// codec.
+constexpr char kSystemChannel[] = "flutter/system";
+
 // Returns the path of the directory containing this executable, or an empty
 // string if the directory cannot be found.
 std::string GetExecutableDirectory() {
   char buffer[PATH_MAX + 1];
   ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer));
-  if (length > PATH_MAX) {
+  if (length < 0 || length > PATH_MAX) {
     std::cerr << "Couldn't locate executable" << std::endl;
     return "";
   }
-  std::string executable_path(buffer, length);
-  size_t last_separator_position = executable_path.find_last_of('/');
-  if (last_separator_position == std::string::npos) {
-    std::cerr << "Unabled to find parent directory of " << executable_path
-              << std::endl;
+  const char *last_separator =
+      static_cast<const char *>(memrchr(buffer, '/', length));
+  if (last_separator == nullptr) {
+    std::cerr << "Unable to find parent directory of "
+              << std::string(buffer, length) << std::endl;
     return "";
   }
-  return executable_path.substr(0, last_separator_position);
+  return std::string(buffer, last_separator - buffer);
+}
+
+// Returns the messenger for the engine of |flutter_controller|.
+flutter::BinaryMessenger *GetMessenger(
+    flutter::FlutterWindowController *flutter_controller) {
+  return flutter::PluginRegistrarManager::GetInstance()
+      ->GetRegistrar<flutter::PluginRegistrarGlfw>(
+          flutter_controller->GetRegistrarForPlugin("Runner"))
+      ->messenger();
+}
+
+// A window after the main one, with its own engine.
+struct SecondaryWindow {
+  std::unique_ptr<flutter::FlutterWindowController> flutter_controller;
+  // The engine's messenger while the window is open, or nullptr if it has
+  // been closed or couldn't be created.
+  flutter::BinaryMessenger *messenger = nullptr;
+  std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>>
+      metrics_channel;
+};
+
+// Destroys |window|, if it is open, along with everything bound to its
+// engine.
+void CloseSecondaryWindow(SecondaryWindow *window) {
+  if (!window->messenger) {
+    return;
+  }
+  window->metrics_channel = nullptr;
+  window->messenger = nullptr;
+  window->flutter_controller->DestroyWindow();
 }
 
 }  // namespace
 
 int main(int argc, char **argv) {
+  // The first frame time is measured from here.
+  RunnerMetrics metrics;
+  metrics.EnableOutputFromEnvironment();
+
   // Resources are located relative to the executable.
   std::string base_directory = GetExecutableDirectory();
   if (base_directory.empty()) {
@@ -43,25 +94,139 @@ int main(int argc, char **argv) {
   std::string assets_path = data_directory + "/flutter_assets";
   std::string icu_data_path = data_directory + "/icudtl.dat";
 
-  // Arguments for the Flutter Engine.
-  std::vector<std::string> arguments;
+  // Start reading the engine's startup files while the window is created.
+  PrefetchProjectFiles(data_directory);
+
+  // Window settings, engine arguments and thread scheduling, which can be
+  // changed per deployment with a configuration file.
+  RunnerConfiguration configuration = LoadRunnerConfiguration(base_directory);
+
+  // This must come before the engine starts its threads, so that they
+  // inherit the settings.
+  ApplyThreadScheduling(configuration);
+
+  // A headless runner shows its window on a private X server, which has no
+  // GPU. The server must outlive the window controller.
+  HeadlessDisplay headless_display;
+  if (configuration.headless) {
+    if (!headless_display.Start(configuration.window_width,
+                                configuration.window_height)) {
+      return EXIT_FAILURE;
+    }
+    configuration.renderer = RunnerConfiguration::Renderer::kSoftware;
+  }
+
+  // Like the scheduling settings, this must come before the engine starts its
+  // threads, but after the private X server has started so that the server
+  // doesn't inherit it.
+  if (configuration.diagnostics) {
+    RunnerDiagnostics::BlockSignals();
+  }
+
+  SelectRenderer(configuration.renderer,
+                 configuration.software_render_threads);
+  metrics.SetRenderer(GetActiveRendererName());
+
+  // Every window's controller initializes GLFW, and the first one to be
+  // destroyed terminates it, which destroys any window still open. So
+  // secondary windows are closed explicitly before the main one, and their
+  // controllers, including those whose window couldn't be created, are
+  // declared first so that they are destroyed last.
+  std::vector<SecondaryWindow> secondary_windows;
 
   flutter::FlutterWindowController flutter_controller(icu_data_path);
   flutter::WindowProperties window_properties = {};
-  window_properties.title = kFlutterWindowTitle;
-  window_properties.width = kFlutterWindowWidth;
-  window_properties.height = kFlutterWindowHeight;
+  window_properties.title = configuration.window_title;
+  window_properties.width = configuration.window_width;
+  window_properties.height = configuration.window_height;
 
   // Start the engine.
   if (!flutter_controller.CreateWindow(window_properties, assets_path,
-                                       arguments)) {
+                                       configuration.engine_arguments)) {
     return EXIT_FAILURE;
   }
+
+  // Further windows share this process, and so its Dart VM, ICU data and
+  // event loop, but each needs an engine of its own, since the GLFW
+  // embedding runs one view per engine.
+  for (SecondaryWindowController &controller : CreateSecondaryWindows(
+           configuration.windows, window_properties, icu_data_path,
+           assets_path, configuration.engine_arguments)) {
+    SecondaryWindow secondary_window;
+    if (controller.created) {
+      secondary_window.messenger =
+          GetMessenger(controller.flutter_controller.get());
+    }
+    secondary_window.flutter_controller =
+        std::move(controller.flutter_controller);
+    secondary_windows.push_back(std::move(secondary_window));
+  }
+
+  EventLoop event_loop;
+  flutter::BinaryMessenger *messenger = GetMessenger(&flutter_controller);
+
+  // Plugins may register pixel buffers as they are registered.
+  PixelBufferRegistrar pixel_buffer_registrar(&event_loop, messenger);
+  PixelBufferRegistrar::SetPluginRegistrar(&pixel_buffer_registrar);
   RegisterPlugins(&flutter_controller);
 
-  // Run until the window is closed.
-  while (flutter_controller.RunEventLoopWithTimeout(
-      std::chrono::milliseconds::max())) {
+  auto metrics_channel = metrics.CreateChannel(messenger, &event_loop);
+
+  // Pixel buffers are only served to the main window, but plugins and
+  // metrics work in every window. The app keeps running until the main
+  // window is closed; any other window can be closed on its own.
+  for (SecondaryWindow &secondary_window : secondary_windows) {
+    if (!secondary_window.messenger) {
+      continue;
+    }
+    RegisterPlugins(secondary_window.flutter_controller.get());
+    secondary_window.metrics_channel =
+        metrics.CreateChannel(secondary_window.messenger, &event_loop);
+    SecondaryWindow *closed_window = &secondary_window;
+    event_loop.AddWindow(
+        secondary_window.flutter_controller.get(),
+        [closed_window]() { CloseSecondaryWindow(closed_window); });
   }
+
+  // Under memory pressure, the framework clears its image cache and notifies
+  // WidgetsBindingObserver.didHaveMemoryPressure. Cache size limits are left
+  // alone, so caches refill normally once the pressure has passed.
+  MemoryPressureMonitor memory_pressure_monitor(
+      &event_loop,
+      [messenger, &secondary_windows]() {
+        static constexpr char kMessage[] = "{\"type\":\"memoryPressure\"}";
+        messenger->Send(kSystemChannel,
+                        reinterpret_cast<const uint8_t *>(kMessage),
+                        sizeof(kMessage) - 1);
+        for (const SecondaryWindow &secondary_window : secondary_windows) {
+          if (secondary_window.messenger) {
+            secondary_window.messenger->Send(
+                kSystemChannel, reinterpret_cast<const uint8_t *>(kMessage),
+                sizeof(kMessage) - 1);
+          }
+        }
+      },
+      [&metrics](int64_t freed_bytes) {
+        metrics.RecordMemoryTrim(freed_bytes);
+      });
+  memory_pressure_monitor.Start();
+
+  std::unique_ptr<RunnerDiagnostics> diagnostics;
+  if (configuration.diagnostics) {
+    diagnostics = std::make_unique<RunnerDiagnostics>(&event_loop, &metrics);
+    if (!diagnostics->Start()) {
+      diagnostics = nullptr;
+    }
+  }
+
+  // Run until the window is closed. Native event sources can be added to the
+  // event loop with AddFd before it starts running.
+  event_loop.Run(&flutter_controller);
+
+  for (SecondaryWindow &secondary_window : secondary_windows) {
+    CloseSecondaryWindow(&secondary_window);
+  }
+
+  metrics.WriteOutput(event_loop.statistics());
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,154 @@
+#include "memory_pressure_monitor.h"
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+// Fires when some task has been stalled on memory for 150ms within any 2s
+// window. Unprivileged processes can only set triggers whose window is a
+// multiple of 2s.
+constexpr char kPressureTrigger[] = "some 150000 2000000";
+
+// How long after asking the app to trim before measuring what was freed.
+// The framework releases images asynchronously, once the message has been
+// handled on the UI thread.
+constexpr std::chrono::seconds kSettleTime(1);
+
+// The minimum time between trims while memory stays under pressure.
+constexpr std::chrono::seconds kCooldown(10);
+
+// Returns the path of the cgroup v2 memory.pressure file for this process, or
+// an empty string if the process isn't in a cgroup v2 hierarchy.
+std::string GetCgroupPressurePath() {
+  std::ifstream cgroups("/proc/self/cgroup");
+  std::string line;
+  while (std::getline(cgroups, line)) {
+    // The v2 hierarchy is listed as "0::<path>".
+    if (line.compare(0, 3, "0::") == 0) {
+      return "/sys/fs/cgroup" + line.substr(3) + "/memory.pressure";
+    }
+  }
+  return "";
+}
+
+// Opens |path| and sets kPressureTrigger on it, returning the descriptor or -1
+// on failure.
+int OpenPressureTrigger(const std::string &path) {
+  int fd = open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+  if (fd < 0) {
+    return -1;
+  }
+  if (write(fd, kPressureTrigger, strlen(kPressureTrigger) + 1) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// Returns the resident set size of this process in bytes, or 0 if it can't
+// be read.
+int64_t GetResidentBytes() {
+  FILE *statm = fopen("/proc/self/statm", "r");
+  if (!statm) {
+    return 0;
+  }
+  long long size_pages = 0;
+  long long resident_pages = 0;
+  int fields = fscanf(statm, "%lld %lld", &size_pages, &resident_pages);
+  fclose(statm);
+  if (fields != 2) {
+    return 0;
+  }
+  return resident_pages * sysconf(_SC_PAGESIZE);
+}
+
+}  // namespace
+
+MemoryPressureMonitor::MemoryPressureMonitor(EventLoop *event_loop,
+                                             LowMemoryCallback on_low_memory,
+                                             TrimmedCallback on_trimmed)
+    : event_loop_(event_loop),
+      on_low_memory_(std::move(on_low_memory)),
+      on_trimmed_(std::move(on_trimmed)) {}
+
+MemoryPressureMonitor::~MemoryPressureMonitor() { Stop(); }
+
+bool MemoryPressureMonitor::Start() {
+  if (pressure_fd_ >= 0) {
+    return true;
+  }
+  std::string cgroup_path = GetCgroupPressurePath();
+  if (!cgroup_path.empty()) {
+    pressure_fd_ = OpenPressureTrigger(cgroup_path);
+  }
+  if (pressure_fd_ < 0) {
+    pressure_fd_ = OpenPressureTrigger("/proc/pressure/memory");
+  }
+  settle_timer_fd_ =
+      timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  // A trigger event is consumed by the first poll that sees it, so this
+  // relies on EventLoop reading each descriptor's events only once.
+  if (pressure_fd_ < 0 || settle_timer_fd_ < 0 ||
+      !event_loop_->AddFd(
+          pressure_fd_, EPOLLPRI,
+          [this](uint32_t events) { OnPressureEvent(events); }) ||
+      !event_loop_->AddFd(settle_timer_fd_, EPOLLIN,
+                          [this](uint32_t) { OnSettled(); })) {
+    Stop();
+    return false;
+  }
+  return true;
+}
+
+void MemoryPressureMonitor::OnPressureEvent(uint32_t events) {
+  if (events & EPOLLERR) {
+    // The monitored cgroup has been removed.
+    Stop();
+    return;
+  }
+  auto now = std::chrono::steady_clock::now();
+  if (rss_before_trim_ > 0 || now < next_trim_time_) {
+    return;
+  }
+  next_trim_time_ = now + kCooldown;
+  rss_before_trim_ = GetResidentBytes();
+  on_low_memory_();
+
+  struct itimerspec settle = {};
+  settle.it_value.tv_sec = kSettleTime.count();
+  timerfd_settime(settle_timer_fd_, 0, &settle, nullptr);
+}
+
+void MemoryPressureMonitor::OnSettled() {
+  uint64_t expirations;
+  if (read(settle_timer_fd_, &expirations, sizeof(expirations)) < 0 ||
+      rss_before_trim_ == 0) {
+    return;
+  }
+  int64_t rss = GetResidentBytes();
+  if (rss > 0) {
+    on_trimmed_(rss_before_trim_ - rss);
+  }
+  rss_before_trim_ = 0;
+}
+
+void MemoryPressureMonitor::Stop() {
+  if (pressure_fd_ >= 0) {
+    event_loop_->RemoveFd(pressure_fd_);
+    close(pressure_fd_);
+    pressure_fd_ = -1;
+  }
+  if (settle_timer_fd_ >= 0) {
+    event_loop_->RemoveFd(settle_timer_fd_);
+    close(settle_timer_fd_);
+    settle_timer_fd_ = -1;
+  }
+  rss_before_trim_ = 0;
+}
@@ -0,0 +1,64 @@
+#ifndef MEMORY_PRESSURE_MONITOR_H_
+#define MEMORY_PRESSURE_MONITOR_H_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "event_loop.h"
+
+// Watches for memory pressure using a pressure stall information (PSI)
+// trigger, and asks the app to release memory.
+//
+// The trigger is set on the process's cgroup (v2) memory.pressure file when
+// there is one, so that pressure from a container's memory limit is seen,
+// and on the system-wide /proc/pressure/memory otherwise. Kernels without PSI
+// (before 4.20, or built without it) are not supported, and Start fails.
+//
+// When the trigger fires, |on_low_memory| is called on the event loop thread.
+// After a short settle time the resident set size is sampled again and
+// |on_trimmed| is called with how much was freed (negative if usage grew).
+// The app is asked to trim at most once per cooldown.
+class MemoryPressureMonitor {
+ public:
+  using LowMemoryCallback = std::function<void()>;
+  using TrimmedCallback = std::function<void(int64_t freed_bytes)>;
+
+  MemoryPressureMonitor(EventLoop *event_loop, LowMemoryCallback on_low_memory,
+                        TrimmedCallback on_trimmed);
+  ~MemoryPressureMonitor();
+
+  // Prevent copying
+  MemoryPressureMonitor(MemoryPressureMonitor const &) = delete;
+  MemoryPressureMonitor &operator=(MemoryPressureMonitor const &) = delete;
+
+  // Starts watching. Returns false if no PSI trigger can be set.
+  bool Start();
+
+ private:
+  // Called when the pressure file descriptor is ready.
+  void OnPressureEvent(uint32_t events);
+
+  // Called when the settle timer fires.
+  void OnSettled();
+
+  // Stops watching and closes all descriptors.
+  void Stop();
+
+  EventLoop *event_loop_;
+  LowMemoryCallback on_low_memory_;
+  TrimmedCallback on_trimmed_;
+
+  int pressure_fd_ = -1;
+  int settle_timer_fd_ = -1;
+
+  // The earliest time the app can be asked to trim again.
+  std::chrono::steady_clock::time_point next_trim_time_;
+
+  // The resident set size sampled when the last trim was requested, or 0 if
+  // no trim is settling.
+  int64_t rss_before_trim_ = 0;
+};
+
+#endif  // MEMORY_PRESSURE_MONITOR_H_
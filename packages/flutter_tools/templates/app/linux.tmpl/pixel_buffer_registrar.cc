@@ -0,0 +1,295 @@
+#include "pixel_buffer_registrar.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <shared_mutex>
+
+namespace {
+
+constexpr char kChannelName[] = "flutter_runner/pixel_buffers";
+
+// The size of the width, height and sequence number header that precedes the
+// pixels in each reply.
+constexpr size_t kHeaderSize = 16;
+
+constexpr size_t kBytesPerPixel = 4;
+
+// The registrar used by the FlutterRunner*PixelBuffer functions, which can be
+// called from any thread. They hold g_plugin_registrar_mutex shared while
+// they use it, and it's only changed with the mutex held exclusively, so a
+// registrar isn't destroyed while another thread is using it.
+std::atomic<PixelBufferRegistrar *> g_plugin_registrar{nullptr};
+std::shared_timed_mutex g_plugin_registrar_mutex;
+
+// Writes the low |size| bytes of |value| to |destination|, little-endian.
+void WriteLittleEndian(uint64_t value, size_t size, uint8_t *destination) {
+  for (size_t i = 0; i < size; ++i) {
+    destination[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+// Signals |fd|, an eventfd.
+void SignalEventFd(int fd) {
+  if (fd >= 0) {
+    uint64_t value = 1;
+    ssize_t ignored = write(fd, &value, sizeof(value));
+    (void)ignored;
+  }
+}
+
+}  // namespace
+
+PixelBufferRegistrar::PixelBufferRegistrar(EventLoop *event_loop,
+                                           flutter::BinaryMessenger *messenger)
+    : event_loop_(event_loop),
+      messenger_(messenger),
+      wake_fd_(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {
+  if (wake_fd_ < 0) {
+    std::cerr << "Unable to create eventfd for pixel buffers: "
+              << strerror(errno) << std::endl;
+  }
+  messenger_->SetMessageHandler(
+      kChannelName, [this](const uint8_t *message, size_t message_size,
+                           flutter::BinaryReply reply) {
+        HandleRequest(message, message_size, std::move(reply));
+      });
+}
+
+PixelBufferRegistrar::~PixelBufferRegistrar() {
+  {
+    // Waits for calls from plugin threads that are using this registrar.
+    std::unique_lock<std::shared_timed_mutex> lock(g_plugin_registrar_mutex);
+    PixelBufferRegistrar *registrar = this;
+    g_plugin_registrar.compare_exchange_strong(registrar, nullptr);
+  }
+  messenger_->SetMessageHandler(kChannelName, nullptr);
+  if (wake_fd_watched_) {
+    event_loop_->RemoveFd(wake_fd_);
+  }
+  if (wake_fd_ >= 0) {
+    close(wake_fd_);
+  }
+  std::vector<flutter::BinaryReply> pending_replies;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_replies.swap(orphaned_replies_);
+    for (auto &entry : buffers_) {
+      if (entry.second.pending_reply) {
+        pending_replies.push_back(std::move(entry.second.pending_reply));
+      }
+    }
+    buffers_.clear();
+  }
+  for (const flutter::BinaryReply &reply : pending_replies) {
+    reply(nullptr, 0);
+  }
+}
+
+int64_t PixelBufferRegistrar::RegisterBuffer() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  int64_t id = next_id_++;
+  buffers_[id];
+  return id;
+}
+
+void PixelBufferRegistrar::UnregisterBuffer(int64_t id) {
+  bool wake = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = buffers_.find(id);
+    if (it == buffers_.end()) {
+      return;
+    }
+    if (it->second.pending_reply) {
+      // Replies must be sent on the event loop thread.
+      orphaned_replies_.push_back(std::move(it->second.pending_reply));
+      wake = true;
+    }
+    buffers_.erase(it);
+  }
+  if (wake) {
+    SignalEventFd(wake_fd_);
+  }
+}
+
+bool PixelBufferRegistrar::PublishFrame(int64_t id, const uint8_t *pixels,
+                                        uint32_t width, uint32_t height,
+                                        size_t row_bytes) {
+  size_t packed_row_bytes = static_cast<size_t>(width) * kBytesPerPixel;
+  if (!pixels || width == 0 || height == 0 || row_bytes < packed_row_bytes) {
+    return false;
+  }
+
+  // Copy outside the lock, into storage from an earlier frame where possible,
+  // so that the event loop thread isn't blocked for the duration of the copy.
+  std::vector<uint8_t> frame;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = buffers_.find(id);
+    if (it == buffers_.end()) {
+      return false;
+    }
+    frame = std::move(it->second.spare);
+  }
+  frame.resize(kHeaderSize + packed_row_bytes * height);
+  WriteLittleEndian(width, 4, &frame[0]);
+  WriteLittleEndian(height, 4, &frame[4]);
+  for (uint32_t row = 0; row < height; ++row) {
+    memcpy(&frame[kHeaderSize + row * packed_row_bytes],
+           pixels + row * row_bytes, packed_row_bytes);
+  }
+
+  bool wake = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = buffers_.find(id);
+    if (it == buffers_.end()) {
+      return false;
+    }
+    Buffer &buffer = it->second;
+    WriteLittleEndian(++buffer.sequence, 8, &frame[8]);
+    // Any frame that hasn't been sent yet is dropped, and its storage reused.
+    std::swap(buffer.frame, frame);
+    if (frame.capacity() > buffer.spare.capacity()) {
+      buffer.spare = std::move(frame);
+    }
+    wake = buffer.pending_reply && !buffer.send_pending;
+    buffer.send_pending = buffer.send_pending || wake;
+  }
+  if (wake) {
+    SignalEventFd(wake_fd_);
+  }
+  return true;
+}
+
+// static
+void PixelBufferRegistrar::SetPluginRegistrar(
+    PixelBufferRegistrar *registrar) {
+  std::unique_lock<std::shared_timed_mutex> lock(g_plugin_registrar_mutex);
+  g_plugin_registrar = registrar;
+}
+
+void PixelBufferRegistrar::HandleRequest(const uint8_t *message,
+                                         size_t message_size,
+                                         flutter::BinaryReply reply) {
+  int64_t id = 0;
+  if (message && message_size == sizeof(id)) {
+    for (size_t i = 0; i < sizeof(id); ++i) {
+      id |= static_cast<int64_t>(message[i]) << (8 * i);
+    }
+  }
+  if (!wake_fd_watched_ && wake_fd_ >= 0) {
+    wake_fd_watched_ = event_loop_->AddFd(
+        wake_fd_, EPOLLIN, [this](uint32_t) { OnWake(); });
+  }
+  flutter::BinaryReply replaced_reply;
+  bool has_frame = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = buffers_.find(id);
+    if (it != buffers_.end()) {
+      replaced_reply = std::move(it->second.pending_reply);
+      it->second.pending_reply = std::move(reply);
+      reply = nullptr;
+      has_frame = !it->second.frame.empty();
+    }
+  }
+  if (reply) {
+    // There is no such buffer.
+    reply(nullptr, 0);
+    return;
+  }
+  if (replaced_reply) {
+    replaced_reply(nullptr, 0);
+  }
+  if (has_frame) {
+    SendFrame(id);
+  }
+}
+
+void PixelBufferRegistrar::OnWake() {
+  uint64_t value;
+  ssize_t ignored = read(wake_fd_, &value, sizeof(value));
+  (void)ignored;
+
+  std::vector<flutter::BinaryReply> orphaned_replies;
+  std::vector<int64_t> sends;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    orphaned_replies.swap(orphaned_replies_);
+    for (const auto &entry : buffers_) {
+      if (entry.second.send_pending) {
+        sends.push_back(entry.first);
+      }
+    }
+  }
+  for (const flutter::BinaryReply &reply : orphaned_replies) {
+    reply(nullptr, 0);
+  }
+  for (int64_t id : sends) {
+    SendFrame(id);
+  }
+}
+
+void PixelBufferRegistrar::SendFrame(int64_t id) {
+  flutter::BinaryReply reply;
+  std::vector<uint8_t> frame;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = buffers_.find(id);
+    if (it == buffers_.end()) {
+      return;
+    }
+    Buffer &buffer = it->second;
+    buffer.send_pending = false;
+    if (!buffer.pending_reply || buffer.frame.empty()) {
+      return;
+    }
+    reply = std::move(buffer.pending_reply);
+    buffer.pending_reply = nullptr;
+    std::swap(frame, buffer.frame);
+  }
+  reply(frame.data(), frame.size());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = buffers_.find(id);
+    if (it != buffers_.end() &&
+        frame.capacity() > it->second.spare.capacity()) {
+      it->second.spare = std::move(frame);
+    }
+  }
+}
+
+int64_t FlutterRunnerRegisterPixelBuffer() {
+  std::shared_lock<std::shared_timed_mutex> lock(g_plugin_registrar_mutex);
+  PixelBufferRegistrar *registrar = g_plugin_registrar;
+  if (!registrar) {
+    return 0;
+  }
+  return registrar->RegisterBuffer();
+}
+
+void FlutterRunnerUnregisterPixelBuffer(int64_t id) {
+  std::shared_lock<std::shared_timed_mutex> lock(g_plugin_registrar_mutex);
+  PixelBufferRegistrar *registrar = g_plugin_registrar;
+  if (registrar) {
+    registrar->UnregisterBuffer(id);
+  }
+}
+
+bool FlutterRunnerPublishPixelBuffer(int64_t id, const uint8_t *pixels,
+                                     uint32_t width, uint32_t height,
+                                     size_t row_bytes) {
+  std::shared_lock<std::shared_timed_mutex> lock(g_plugin_registrar_mutex);
+  PixelBufferRegistrar *registrar = g_plugin_registrar;
+  if (!registrar) {
+    return false;
+  }
+  return registrar->PublishFrame(id, pixels, width, height, row_bytes);
+}
@@ -0,0 +1,141 @@
+#ifndef PIXEL_BUFFER_REGISTRAR_H_
+#define PIXEL_BUFFER_REGISTRAR_H_
+
+#include <flutter/binary_messenger.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "event_loop.h"
+
+// Carries frames from native code, such as video and camera plugins, to the
+// framework.
+//
+// The GLFW embedding doesn't expose the engine's external texture API, so
+// frames can't be shared with the raster thread as textures. This is the
+// cheapest path available without one: each frame is copied once, when it is
+// published, into the message that is sent to the framework, with no codec
+// encoding. Frames are pulled, so a buffer that publishes faster than the
+// framework consumes only ever sends its latest frame, and stale frames are
+// dropped without being sent.
+//
+// The framework requests the next frame of a buffer by sending its ID, as a
+// little-endian int64, on the 'flutter_runner/pixel_buffers' channel. The
+// reply is sent once a frame newer than the last one replied with has been
+// published, and is a 16-byte header of little-endian width and height
+// (uint32) and sequence number (uint64, the count of frames published so
+// far), followed by the tightly packed BGRA pixels. An empty reply means the
+// buffer has been unregistered, or that a newer request has replaced this
+// one. For example:
+//
+//   final ByteData request = ByteData(8)..setInt64(0, id, Endian.little);
+//   final ByteData frame = await ServicesBinding
+//       .instance.defaultBinaryMessenger
+//       .send('flutter_runner/pixel_buffers', request);
+//   final int width = frame.getUint32(0, Endian.little);
+//   final int height = frame.getUint32(4, Endian.little);
+//   ui.decodeImageFromPixels(
+//       frame.buffer.asUint8List(frame.offsetInBytes + 16),
+//       width, height, ui.PixelFormat.bgra8888, onImage);
+//
+// Frames published on other threads are handed to the event loop through an
+// eventfd. It is only added to the event loop once the first frame has been
+// requested, since without a wake function (see EventLoop::SetWakeFunction)
+// any registered descriptor bounds the loop's wait by its poll interval.
+class PixelBufferRegistrar {
+ public:
+  // Handles frame requests on |messenger|, delivering frames published on
+  // other threads through |event_loop|. Must be created and destroyed on the
+  // event loop thread, and must not outlive |messenger|.
+  PixelBufferRegistrar(EventLoop *event_loop,
+                       flutter::BinaryMessenger *messenger);
+
+  ~PixelBufferRegistrar();
+
+  // Prevent copying
+  PixelBufferRegistrar(PixelBufferRegistrar const &) = delete;
+  PixelBufferRegistrar &operator=(PixelBufferRegistrar const &) = delete;
+
+  // Returns the ID of a new buffer.
+  //
+  // This may be called from any thread.
+  int64_t RegisterBuffer();
+
+  // Releases buffer |id|, answering any pending request with an empty reply.
+  //
+  // This may be called from any thread.
+  void UnregisterBuffer(int64_t id);
+
+  // Copies a |width| x |height| BGRA frame with rows |row_bytes| apart into
+  // buffer |id|, replacing any frame that hasn't been sent yet. Returns false
+  // if there is no such buffer.
+  //
+  // This may be called from any thread.
+  bool PublishFrame(int64_t id, const uint8_t *pixels, uint32_t width,
+                    uint32_t height, size_t row_bytes);
+
+  // Sets the registrar used by the FlutterRunner*PixelBuffer functions, or
+  // nullptr to make them fail. Waits for any calls to them in progress. A
+  // registrar that is in use is cleared when it is destroyed, in the same
+  // way.
+  static void SetPluginRegistrar(PixelBufferRegistrar *registrar);
+
+ private:
+  struct Buffer {
+    // The latest frame in the reply format, or empty if no frame has been
+    // published since the last reply.
+    std::vector<uint8_t> frame;
+    // A previously sent frame's storage, reused by the next publish.
+    std::vector<uint8_t> spare;
+    uint64_t sequence = 0;
+    // The request waiting for the next frame, if any.
+    flutter::BinaryReply pending_reply;
+    // Whether the frame is waiting to be sent to pending_reply.
+    bool send_pending = false;
+  };
+
+  // Handles a frame request from the framework.
+  void HandleRequest(const uint8_t *message, size_t message_size,
+                     flutter::BinaryReply reply);
+
+  // Called on the event loop thread when the wake eventfd is signaled.
+  void OnWake();
+
+  // Sends buffer |id|'s frame to its pending request, if it has both.
+  void SendFrame(int64_t id);
+
+  EventLoop *event_loop_;
+  flutter::BinaryMessenger *messenger_;
+  int wake_fd_ = -1;
+  bool wake_fd_watched_ = false;
+
+  // Guards all members below.
+  std::mutex mutex_;
+  std::map<int64_t, Buffer> buffers_;
+  // Requests for unregistered buffers, to be answered on the event loop
+  // thread.
+  std::vector<flutter::BinaryReply> orphaned_replies_;
+  int64_t next_id_ = 1;
+};
+
+// Entry points for plugins, which are built as separate libraries and so
+// can't use PixelBufferRegistrar directly. The runner is linked with
+// --export-dynamic, so plugins can look them up with
+// dlsym(RTLD_DEFAULT, ...).
+//
+// They may be called from any thread. FlutterRunnerRegisterPixelBuffer returns
+// 0 when there is no registrar.
+extern "C" {
+__attribute__((visibility("default"))) int64_t
+FlutterRunnerRegisterPixelBuffer();
+__attribute__((visibility("default"))) void FlutterRunnerUnregisterPixelBuffer(
+    int64_t id);
+__attribute__((visibility("default"))) bool FlutterRunnerPublishPixelBuffer(
+    int64_t id, const uint8_t *pixels, uint32_t width, uint32_t height,
+    size_t row_bytes);
+}
+
+#endif  // PIXEL_BUFFER_REGISTRAR_H_
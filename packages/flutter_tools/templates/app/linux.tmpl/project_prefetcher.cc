@@ -0,0 +1,48 @@
+#include "project_prefetcher.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Files read by the engine at startup, relative to the data directory. Not
+// all of them exist in every build mode (e.g., kernel_blob.bin is only
+// present in JIT builds); missing files are skipped.
+constexpr const char *kStartupFiles[] = {
+    "icudtl.dat",
+    "flutter_assets/kernel_blob.bin",
+    "flutter_assets/vm_snapshot_data",
+    "flutter_assets/isolate_snapshot_data",
+    "flutter_assets/AssetManifest.json",
+    "flutter_assets/FontManifest.json",
+};
+
+// Queues readahead of the whole file at |path|.
+void PrefetchFile(const std::string &path) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return;
+  }
+  struct stat file_info;
+  if (fstat(fd, &file_info) == 0 && file_info.st_size > 0) {
+    size_t length = static_cast<size_t>(file_info.st_size);
+    void *mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping != MAP_FAILED) {
+      // The readahead is queued by the time madvise returns, so the mapping
+      // doesn't need to outlive this call.
+      madvise(mapping, length, MADV_WILLNEED);
+      munmap(mapping, length);
+    }
+  }
+  close(fd);
+}
+
+}  // namespace
+
+void PrefetchProjectFiles(const std::string &data_directory) {
+  for (const char *file : kStartupFiles) {
+    PrefetchFile(data_directory + "/" + file);
+  }
+}
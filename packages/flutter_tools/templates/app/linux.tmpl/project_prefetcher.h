@@ -0,0 +1,16 @@
+#ifndef PROJECT_PREFETCHER_H_
+#define PROJECT_PREFETCHER_H_
+
+#include <string>
+
+// Starts asynchronous readahead of the files the engine loads at startup (ICU
+// data, snapshots, etc.) from |data_directory|, so that they are in the page
+// cache by the time the engine opens them. Each file is mapped and advised
+// with MADV_WILLNEED, which queues the reads without blocking, so calling this
+// before window creation overlaps the disk I/O with GLFW and GL setup.
+//
+// Missing files are skipped. This is purely an optimization; failures are
+// ignored.
+void PrefetchProjectFiles(const std::string &data_directory);
+
+#endif  // PROJECT_PREFETCHER_H_
@@ -0,0 +1,35 @@
+#include "renderer_selection.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+void SelectRenderer(RunnerConfiguration::Renderer renderer,
+                    unsigned int software_render_threads) {
+  if (renderer != RunnerConfiguration::Renderer::kSoftware) {
+    return;
+  }
+  // Route GLX through Mesa when libglvnd is in use, then ask Mesa for
+  // llvmpipe rather than a hardware driver.
+  setenv("__GLX_VENDOR_LIBRARY_NAME", "mesa", 1);
+  setenv("LIBGL_ALWAYS_SOFTWARE", "1", 1);
+  setenv("GALLIUM_DRIVER", "llvmpipe", 1);
+  if (software_render_threads > 0) {
+    setenv("LP_NUM_THREADS", std::to_string(software_render_threads).c_str(),
+           1);
+  }
+  std::cerr << "Using software rendering with "
+            << (software_render_threads > 0
+                    ? std::to_string(software_render_threads)
+                    : std::string("one per CPU"))
+            << " rasterizer threads" << std::endl;
+}
+
+std::string GetActiveRendererName() {
+  const char *always_software = getenv("LIBGL_ALWAYS_SOFTWARE");
+  if (always_software && strcmp(always_software, "0") != 0 &&
+      always_software[0] != '\0') {
+    return "software";
+  }
+  return "gpu";
+}
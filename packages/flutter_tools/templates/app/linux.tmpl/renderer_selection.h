@@ -0,0 +1,23 @@
+#ifndef RENDERER_SELECTION_H_
+#define RENDERER_SELECTION_H_
+
+#include <string>
+
+#include "runner_configuration.h"
+
+// Selects the OpenGL implementation the engine's GLFW contexts will use. This
+// must be called before the window is created.
+//
+// The software renderer is selected through Mesa's environment variables, so
+// it requires Mesa (directly, or through libglvnd) to be installed; with a
+// proprietary libGL that doesn't dispatch through libglvnd, the GPU is
+// always used.
+void SelectRenderer(RunnerConfiguration::Renderer renderer,
+                    unsigned int software_render_threads);
+
+// Returns the name of the renderer in effect after SelectRenderer, which is
+// 'software' when the GPU renderer was requested but software rendering has
+// been forced from the environment.
+std::string GetActiveRendererName();
+
+#endif  // RENDERER_SELECTION_H_
@@ -0,0 +1,228 @@
+#include "runner_configuration.h"
+
+#include <sched.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "window_configuration.h"
+
+namespace {
+
+constexpr char kConfigurationFileVariable[] = "FLUTTER_RUNNER_CONFIG_FILE";
+
+constexpr char kConfigurationFileName[] = "runner.conf";
+
+// Returns |value| without leading and trailing whitespace.
+std::string Trim(const std::string &value) {
+  const char *whitespace = " \t\r";
+  size_t start = value.find_first_not_of(whitespace);
+  if (start == std::string::npos) {
+    return "";
+  }
+  size_t end = value.find_last_not_of(whitespace);
+  return value.substr(start, end - start + 1);
+}
+
+// Parses |value| as a positive window dimension or count, returning false if
+// it isn't one.
+bool ParsePositive(const std::string &value, unsigned int *result) {
+  char *end = nullptr;
+  errno = 0;
+  unsigned long parsed = strtoul(value.c_str(), &end, 10);
+  if (value.empty() || *end != '\0' || errno != 0 || parsed == 0 ||
+      parsed > INT_MAX || value[0] == '-') {
+    return false;
+  }
+  *result = static_cast<unsigned int>(parsed);
+  return true;
+}
+
+// Parses |value| as 'true' or 'false', returning false if it is neither.
+bool ParseBool(const std::string &value, bool *result) {
+  if (value == "true") {
+    *result = true;
+  } else if (value == "false") {
+    *result = false;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Parses |value| as an integer from |min| to |max|, returning false if it
+// isn't one.
+bool ParseInteger(const std::string &value, long min, long max, int *result) {
+  char *end = nullptr;
+  errno = 0;
+  long parsed = strtol(value.c_str(), &end, 10);
+  if (value.empty() || *end != '\0' || errno != 0 || parsed < min ||
+      parsed > max) {
+    return false;
+  }
+  *result = static_cast<int>(parsed);
+  return true;
+}
+
+// Parses |value| as a comma-separated list of CPUs and inclusive CPU ranges,
+// such as '0,2-3', returning false if it isn't one.
+bool ParseCpuList(const std::string &value, std::vector<unsigned int> *result) {
+  std::vector<unsigned int> cpus;
+  size_t start = 0;
+  while (start <= value.size()) {
+    size_t comma = value.find(',', start);
+    if (comma == std::string::npos) {
+      comma = value.size();
+    }
+    std::string item = Trim(value.substr(start, comma - start));
+    size_t dash = item.find('-');
+    int first = 0;
+    int last = 0;
+    if (dash == std::string::npos) {
+      if (!ParseInteger(item, 0, CPU_SETSIZE - 1, &first)) {
+        return false;
+      }
+      last = first;
+    } else if (!ParseInteger(Trim(item.substr(0, dash)), 0, CPU_SETSIZE - 1,
+                             &first) ||
+               !ParseInteger(Trim(item.substr(dash + 1)), first,
+                             CPU_SETSIZE - 1, &last)) {
+      return false;
+    }
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(static_cast<unsigned int>(cpu));
+    }
+    start = comma + 1;
+  }
+  *result = cpus;
+  return true;
+}
+
+// Parses |value| as '<route>', '<route>@<left>,<top>' or
+// '<route>@<left>,<top>,<width>,<height>', returning false if it isn't one.
+bool ParseWindow(const std::string &value,
+                 RunnerConfiguration::Window *result) {
+  RunnerConfiguration::Window window;
+  size_t at = value.find('@');
+  window.route = Trim(value.substr(0, at));
+  if (window.route.empty()) {
+    return false;
+  }
+  if (at != std::string::npos) {
+    std::vector<std::string> fields;
+    size_t start = at + 1;
+    while (start <= value.size()) {
+      size_t comma = value.find(',', start);
+      if (comma == std::string::npos) {
+        comma = value.size();
+      }
+      fields.push_back(Trim(value.substr(start, comma - start)));
+      start = comma + 1;
+    }
+    if ((fields.size() != 2 && fields.size() != 4) ||
+        !ParseInteger(fields[0], INT_MIN, INT_MAX, &window.left) ||
+        !ParseInteger(fields[1], INT_MIN, INT_MAX, &window.top) ||
+        (fields.size() == 4 && (!ParsePositive(fields[2], &window.width) ||
+                                !ParsePositive(fields[3], &window.height)))) {
+      return false;
+    }
+    window.has_position = true;
+  }
+  *result = window;
+  return true;
+}
+
+}  // namespace
+
+RunnerConfiguration LoadRunnerConfiguration(const std::string &base_directory) {
+  RunnerConfiguration configuration;
+  configuration.window_title = kFlutterWindowTitle;
+  configuration.window_width = kFlutterWindowWidth;
+  configuration.window_height = kFlutterWindowHeight;
+
+  const char *path_override = getenv(kConfigurationFileVariable);
+  std::string path = path_override && path_override[0] != '\0'
+                         ? path_override
+                         : base_directory + "/" + kConfigurationFileName;
+  std::ifstream file(path);
+  if (!file) {
+    if (path_override) {
+      std::cerr << "Unable to read runner configuration " << path
+                << std::endl;
+    }
+    return configuration;
+  }
+
+  std::string line;
+  int line_number = 0;
+  while (std::getline(file, line)) {
+    ++line_number;
+    line = Trim(line);
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    size_t separator = line.find('=');
+    if (separator == std::string::npos) {
+      std::cerr << path << ":" << line_number << ": expected 'key=value'"
+                << std::endl;
+      continue;
+    }
+    std::string key = Trim(line.substr(0, separator));
+    std::string value = Trim(line.substr(separator + 1));
+    bool valid = true;
+    if (key == "title") {
+      configuration.window_title = value;
+    } else if (key == "width") {
+      valid = ParsePositive(value, &configuration.window_width);
+    } else if (key == "height") {
+      valid = ParsePositive(value, &configuration.window_height);
+    } else if (key == "engine_argument") {
+      valid = !value.empty();
+      if (valid) {
+        configuration.engine_arguments.push_back(value);
+      }
+    } else if (key == "renderer") {
+      if (value == "gpu") {
+        configuration.renderer = RunnerConfiguration::Renderer::kGpu;
+      } else if (value == "software") {
+        configuration.renderer = RunnerConfiguration::Renderer::kSoftware;
+      } else {
+        valid = false;
+      }
+    } else if (key == "software_render_threads") {
+      valid = ParsePositive(value, &configuration.software_render_threads);
+    } else if (key == "nice") {
+      valid = ParseInteger(value, -20, 19, &configuration.nice);
+    } else if (key == "realtime_priority") {
+      int priority = 0;
+      valid = ParseInteger(value, 1, 99, &priority);
+      if (valid) {
+        configuration.realtime_priority = static_cast<unsigned int>(priority);
+      }
+    } else if (key == "cpu_affinity") {
+      valid = ParseCpuList(value, &configuration.cpu_affinity);
+    } else if (key == "headless") {
+      valid = ParseBool(value, &configuration.headless);
+    } else if (key == "window") {
+      RunnerConfiguration::Window window;
+      valid = ParseWindow(value, &window);
+      if (valid) {
+        configuration.windows.push_back(window);
+      }
+    } else if (key == "diagnostics") {
+      valid = ParseBool(value, &configuration.diagnostics);
+    } else {
+      std::cerr << path << ":" << line_number << ": unknown setting '" << key
+                << "'" << std::endl;
+      continue;
+    }
+    if (!valid) {
+      std::cerr << path << ":" << line_number << ": invalid value for '"
+                << key << "'" << std::endl;
+    }
+  }
+  return configuration;
+}
@@ -0,0 +1,103 @@
+#ifndef RUNNER_CONFIGURATION_
+#define RUNNER_CONFIGURATION_
+
+#include <string>
+#include <vector>
+
+// Settings that can be changed per deployment without rebuilding the runner.
+// The defaults come from window_configuration.h, and can be overridden by a
+// configuration file read at startup.
+//
+// The file is read from the path in the FLUTTER_RUNNER_CONFIG_FILE
+// environment variable if it is set, or from runner.conf next to the
+// executable otherwise. Each line is a 'key=value' setting; blank lines and
+// lines starting with '#' are ignored. For example:
+//
+//   title=My App
+//   width=1280
+//   height=720
+//   engine_argument=--cache-sksl
+//   engine_argument=--old-gen-heap-size=512
+//   renderer=software
+//   software_render_threads=8
+//   nice=-5
+//   cpu_affinity=0-2
+//   headless=true
+//   window=/alarms@1920,0
+//   diagnostics=true
+//
+// engine_argument can be repeated, and each occurrence adds one argument.
+// Switches are passed to the engine as-is; see the engine's
+// shell/common/switches.h for the available switches.
+//
+// renderer is 'gpu' (the default) or 'software'; see Renderer.
+// software_render_threads sets the number of software rasterizer threads,
+// and defaults to one per CPU.
+//
+// nice (-20 to 19), realtime_priority (1 to 99, for SCHED_RR) and
+// cpu_affinity (a list of CPUs and CPU ranges such as '0,2-3') set how the
+// platform and engine threads are scheduled; see thread_scheduling.h.
+// realtime_priority takes precedence over nice.
+//
+// headless is 'true' or 'false' (the default). When true, the window is shown
+// on a private X server rather than the user's display, and the software
+// renderer is used; see headless_display.h.
+//
+// window adds a window after the main one, and can be repeated. Its value is
+// the route the window starts on (window.defaultRouteName in Dart),
+// optionally followed by '@<left>,<top>' or '@<left>,<top>,<width>,<height>'
+// to place it, e.g., on another monitor. Each window runs its own engine,
+// sharing the process, the Dart VM and the event loop with the main window,
+// and uses the main window's title, engine arguments and (unless given) size.
+//
+// diagnostics is 'true' or 'false' (the default). When true, SIGUSR1 toggles
+// live counters on stderr and SIGUSR2 writes a trace of the last few seconds;
+// see runner_diagnostics.h.
+struct RunnerConfiguration {
+  // How frames are rasterized.
+  enum class Renderer {
+    // OpenGL on the system's GPU driver.
+    kGpu,
+    // OpenGL on Mesa's llvmpipe software rasterizer, for machines without a
+    // usable GPU such as VDI and remote desktop sessions. llvmpipe bins each
+    // frame into tiles that are rasterized in parallel on a thread pool, so
+    // it keeps up at resolutions where a single-threaded rasterizer can't.
+    kSoftware,
+  };
+
+  // A window added with the 'window' setting.
+  struct Window {
+    std::string route;
+    bool has_position = false;
+    int left = 0;
+    int top = 0;
+    // Zero for the main window's size.
+    unsigned int width = 0;
+    unsigned int height = 0;
+  };
+
+  std::string window_title;
+  unsigned int window_width;
+  unsigned int window_height;
+  std::vector<std::string> engine_arguments;
+  Renderer renderer = Renderer::kGpu;
+  // Zero for one per CPU.
+  unsigned int software_render_threads = 0;
+  // Zero to leave the nice value unchanged.
+  int nice = 0;
+  // Zero to keep the default scheduling policy.
+  unsigned int realtime_priority = 0;
+  // Empty to allow every CPU.
+  std::vector<unsigned int> cpu_affinity;
+  bool headless = false;
+  std::vector<Window> windows;
+  bool diagnostics = false;
+};
+
+// Returns the configuration for this run, reading the configuration file
+// described above relative to |base_directory| (the executable's directory).
+// A missing configuration file isn't an error. Invalid lines are reported on
+// stderr and otherwise ignored.
+RunnerConfiguration LoadRunnerConfiguration(const std::string &base_directory);
+
+#endif  // RUNNER_CONFIGURATION_
@@ -0,0 +1,194 @@
+#include "runner_diagnostics.h"
+
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+// About ten seconds of a busy event loop, in 1MB.
+constexpr size_t kTraceCapacity = 32 * 1024;
+
+constexpr std::chrono::seconds kPrintInterval(1);
+
+constexpr int kToggleCountersSignal = SIGUSR1;
+constexpr int kWriteTraceSignal = SIGUSR2;
+
+// Returns the diagnostics signals as a set.
+sigset_t GetSignals() {
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, kToggleCountersSignal);
+  sigaddset(&signals, kWriteTraceSignal);
+  return signals;
+}
+
+// Returns |duration| in milliseconds.
+double ToMilliseconds(std::chrono::nanoseconds duration) {
+  return static_cast<double>(duration.count()) / 1e6;
+}
+
+// Returns the user and system time used by this process.
+std::chrono::nanoseconds GetProcessCpuTime() {
+  struct timespec time;
+  if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0) {
+    return std::chrono::nanoseconds(0);
+  }
+  return std::chrono::seconds(time.tv_sec) +
+         std::chrono::nanoseconds(time.tv_nsec);
+}
+
+}  // namespace
+
+// static
+void RunnerDiagnostics::BlockSignals() {
+  sigset_t signals = GetSignals();
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+}
+
+RunnerDiagnostics::RunnerDiagnostics(EventLoop *event_loop,
+                                     const RunnerMetrics *metrics)
+    : event_loop_(event_loop), metrics_(metrics), trace_(kTraceCapacity) {
+  event_loop_->SetTrace(&trace_);
+  previous_sample_ = TakeSample();
+}
+
+RunnerDiagnostics::~RunnerDiagnostics() {
+  event_loop_->SetTrace(nullptr);
+  if (timer_fd_ >= 0) {
+    event_loop_->RemoveFd(timer_fd_);
+    close(timer_fd_);
+  }
+  if (signal_fd_ >= 0) {
+    event_loop_->RemoveFd(signal_fd_);
+    close(signal_fd_);
+  }
+}
+
+bool RunnerDiagnostics::Start() {
+  if (signal_fd_ >= 0) {
+    return true;
+  }
+  sigset_t signals = GetSignals();
+  signal_fd_ = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+  timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (signal_fd_ < 0 || timer_fd_ < 0 ||
+      !event_loop_->AddFd(signal_fd_, EPOLLIN,
+                          [this](uint32_t) { OnSignal(); })) {
+    std::cerr << "Unable to watch for diagnostics signals" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+void RunnerDiagnostics::ToggleCounters() {
+  printing_ = !printing_;
+  // The timer is only watched while printing, since without a wake function
+  // every watched descriptor bounds the event loop's engine wait.
+  if (!printing_) {
+    event_loop_->RemoveFd(timer_fd_);
+    struct itimerspec stop = {};
+    timerfd_settime(timer_fd_, 0, &stop, nullptr);
+    return;
+  }
+  previous_sample_ = TakeSample();
+  struct itimerspec interval = {};
+  interval.it_value.tv_sec = kPrintInterval.count();
+  interval.it_interval.tv_sec = kPrintInterval.count();
+  if (timerfd_settime(timer_fd_, 0, &interval, nullptr) != 0 ||
+      !event_loop_->AddFd(timer_fd_, EPOLLIN, [this](uint32_t) {
+        uint64_t expirations;
+        if (read(timer_fd_, &expirations, sizeof(expirations)) > 0) {
+          PrintCounters();
+        }
+      })) {
+    std::cerr << "Unable to start printing diagnostics counters" << std::endl;
+    printing_ = false;
+  }
+}
+
+std::string RunnerDiagnostics::WriteTrace() {
+  const char *directory = getenv("TMPDIR");
+  if (!directory || directory[0] == '\0') {
+    directory = "/tmp";
+  }
+  std::string path = std::string(directory) + "/flutter_runner_trace_" +
+                     std::to_string(getpid()) + "_" +
+                     std::to_string(++traces_written_) + ".json";
+  if (!trace_.WriteOutput(path)) {
+    std::cerr << "Unable to write trace " << path << std::endl;
+    return "";
+  }
+  std::cerr << "Wrote trace " << path << std::endl;
+  return path;
+}
+
+RunnerDiagnostics::Sample RunnerDiagnostics::TakeSample() const {
+  Sample sample;
+  sample.time = std::chrono::steady_clock::now();
+  sample.event_loop = event_loop_->statistics();
+  sample.build_durations = metrics_->build_durations();
+  sample.raster_durations = metrics_->raster_durations();
+  sample.cpu_time = GetProcessCpuTime();
+  return sample;
+}
+
+void RunnerDiagnostics::OnSignal() {
+  struct signalfd_siginfo info;
+  while (read(signal_fd_, &info, sizeof(info)) == sizeof(info)) {
+    if (static_cast<int>(info.ssi_signo) == kToggleCountersSignal) {
+      ToggleCounters();
+    } else if (static_cast<int>(info.ssi_signo) == kWriteTraceSignal) {
+      WriteTrace();
+    }
+  }
+}
+
+void RunnerDiagnostics::PrintCounters() {
+  Sample sample = TakeSample();
+  const Sample &previous = previous_sample_;
+  double seconds =
+      std::chrono::duration<double>(sample.time - previous.time).count();
+  if (seconds <= 0) {
+    seconds = 1;
+  }
+  DurationHistogram engine_calls = sample.event_loop.engine_durations.Since(
+      previous.event_loop.engine_durations);
+  DurationHistogram fd_callbacks =
+      sample.event_loop.fd_dispatch_durations.Since(
+          previous.event_loop.fd_dispatch_durations);
+  DurationHistogram builds =
+      sample.build_durations.Since(previous.build_durations);
+  DurationHistogram rasters =
+      sample.raster_durations.Since(previous.raster_durations);
+  double cpu_milliseconds =
+      ToMilliseconds(sample.cpu_time - previous.cpu_time);
+
+  fprintf(stderr,
+          "diagnostics: engine %.0f calls/s, %.1f ms/s, p90 %lld us | "
+          "fd callbacks %.0f/s, %.1f ms/s, p90 %lld us\n",
+          static_cast<double>(engine_calls.count()) / seconds,
+          ToMilliseconds(engine_calls.total()) / seconds,
+          static_cast<long long>(engine_calls.Percentile(90).count()),
+          static_cast<double>(fd_callbacks.count()) / seconds,
+          ToMilliseconds(fd_callbacks.total()) / seconds,
+          static_cast<long long>(fd_callbacks.Percentile(90).count()));
+  fprintf(stderr,
+          "diagnostics: frames %.1f/s, build p90 %lld us, raster p90 %lld "
+          "us | CPU %.1f ms/s, %.1f ms per frame\n",
+          static_cast<double>(builds.count()) / seconds,
+          static_cast<long long>(builds.Percentile(90).count()),
+          static_cast<long long>(rasters.Percentile(90).count()),
+          cpu_milliseconds / seconds,
+          builds.count() > 0
+              ? cpu_milliseconds / static_cast<double>(builds.count())
+              : 0.0);
+  previous_sample_ = sample;
+}
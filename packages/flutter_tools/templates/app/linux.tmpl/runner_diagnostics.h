@@ -0,0 +1,90 @@
+#ifndef RUNNER_DIAGNOSTICS_H_
+#define RUNNER_DIAGNOSTICS_H_
+
+#include <chrono>
+#include <string>
+
+#include "duration_histogram.h"
+#include "event_loop.h"
+#include "recent_trace.h"
+#include "runner_metrics.h"
+
+// Live diagnostics for finding the cause of jank on machines without a
+// profiler, enabled with the 'diagnostics' runner setting. The GLFW embedding
+// keeps keyboard input and window creation to itself, so they are driven by
+// signals rather than hotkeys and a window:
+//
+// - SIGUSR1 starts or stops printing live counters to stderr every second:
+//   engine event loop calls (each one a wakeup) and the time spent in them,
+//   file descriptor callbacks, frame build and raster times, and process CPU
+//   time.
+// - SIGUSR2 writes the event loop's last few seconds (every engine event loop
+//   call and file descriptor callback) to a trace in $TMPDIR (or /tmp), and
+//   reports its path on stderr.
+//
+// e.g., 'kill -USR1 $(pidof my_app)'. Frame times are the ones the app
+// reports to RunnerMetrics, so they are only shown for apps that report
+// them. The embedding doesn't expose its GL context, so GPU time can't be
+// measured; the raster time includes submitting work to the GPU.
+//
+// The signals are received through a signalfd on the event loop, so they
+// must be blocked in every thread; see BlockSignals.
+class RunnerDiagnostics {
+ public:
+  // Blocks SIGUSR1 and SIGUSR2 on the calling thread. Must be called before
+  // the engine starts its threads, so that they inherit the mask.
+  static void BlockSignals();
+
+  // Reads counters from |event_loop| and |metrics|, and records |event_loop|
+  // in the recent trace while this object exists.
+  RunnerDiagnostics(EventLoop *event_loop, const RunnerMetrics *metrics);
+  ~RunnerDiagnostics();
+
+  // Prevent copying
+  RunnerDiagnostics(RunnerDiagnostics const &) = delete;
+  RunnerDiagnostics &operator=(RunnerDiagnostics const &) = delete;
+
+  // Starts handling the signals. Returns false on failure.
+  bool Start();
+
+  // Starts printing counters if they aren't being printed, and stops
+  // otherwise.
+  void ToggleCounters();
+
+  // Writes the recent trace to a new file in the temporary directory,
+  // returning its path, or an empty string if it can't be written.
+  std::string WriteTrace();
+
+ private:
+  // The counters at one point in time. Rates are computed from the
+  // difference between two samples.
+  struct Sample {
+    std::chrono::steady_clock::time_point time;
+    EventLoop::Statistics event_loop;
+    DurationHistogram build_durations;
+    DurationHistogram raster_durations;
+    // User and system time used by the process.
+    std::chrono::nanoseconds cpu_time{0};
+  };
+
+  // Returns the current counters.
+  Sample TakeSample() const;
+
+  // Handles the pending signals.
+  void OnSignal();
+
+  // Prints the counters for the time since the last call, starting a new
+  // interval.
+  void PrintCounters();
+
+  EventLoop *event_loop_;
+  const RunnerMetrics *metrics_;
+  RecentTrace trace_;
+  int signal_fd_ = -1;
+  int timer_fd_ = -1;
+  bool printing_ = false;
+  Sample previous_sample_;
+  int traces_written_ = 0;
+};
+
+#endif  // RUNNER_DIAGNOSTICS_H_
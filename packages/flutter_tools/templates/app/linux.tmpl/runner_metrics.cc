@@ -0,0 +1,210 @@
+#include "runner_metrics.h"
+
+#include <flutter/standard_method_codec.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+constexpr char kChannelName[] = "flutter_runner/metrics";
+
+constexpr char kMetricsFileVariable[] = "FLUTTER_RUNNER_METRICS_FILE";
+
+int64_t ToMicroseconds(std::chrono::nanoseconds duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+      .count();
+}
+
+flutter::EncodableValue EncodeHistogram(const DurationHistogram &histogram) {
+  flutter::EncodableList buckets;
+  for (uint64_t count : histogram.buckets()) {
+    buckets.push_back(flutter::EncodableValue(static_cast<int64_t>(count)));
+  }
+  return flutter::EncodableValue(flutter::EncodableMap{
+      {flutter::EncodableValue("count"),
+       flutter::EncodableValue(static_cast<int64_t>(histogram.count()))},
+      {flutter::EncodableValue("totalMicros"),
+       flutter::EncodableValue(ToMicroseconds(histogram.total()))},
+      {flutter::EncodableValue("longestMicros"),
+       flutter::EncodableValue(ToMicroseconds(histogram.longest()))},
+      {flutter::EncodableValue("p50Micros"),
+       flutter::EncodableValue(
+           static_cast<int64_t>(histogram.Percentile(50).count()))},
+      {flutter::EncodableValue("p90Micros"),
+       flutter::EncodableValue(
+           static_cast<int64_t>(histogram.Percentile(90).count()))},
+      {flutter::EncodableValue("p99Micros"),
+       flutter::EncodableValue(
+           static_cast<int64_t>(histogram.Percentile(99).count()))},
+      {flutter::EncodableValue("buckets"), flutter::EncodableValue(buckets)},
+  });
+}
+
+void WriteHistogram(FILE *file,
+                    const char *name,
+                    const DurationHistogram &histogram) {
+  fprintf(file,
+          "\"%s\":{\"count\":%llu,\"totalMicros\":%lld,"
+          "\"longestMicros\":%lld,\"p50Micros\":%lld,\"p90Micros\":%lld,"
+          "\"p99Micros\":%lld,\"buckets\":[",
+          name, static_cast<unsigned long long>(histogram.count()),
+          static_cast<long long>(ToMicroseconds(histogram.total())),
+          static_cast<long long>(ToMicroseconds(histogram.longest())),
+          static_cast<long long>(histogram.Percentile(50).count()),
+          static_cast<long long>(histogram.Percentile(90).count()),
+          static_cast<long long>(histogram.Percentile(99).count()));
+  for (size_t i = 0; i < histogram.buckets().size(); ++i) {
+    fprintf(file, "%s%llu", i > 0 ? "," : "",
+            static_cast<unsigned long long>(histogram.buckets()[i]));
+  }
+  fprintf(file, "]}");
+}
+
+}  // namespace
+
+RunnerMetrics::RunnerMetrics()
+    : start_time_(std::chrono::steady_clock::now()) {}
+
+void RunnerMetrics::EnableOutputFromEnvironment() {
+  const char *path = getenv(kMetricsFileVariable);
+  if (path && path[0] != '\0') {
+    output_path_ = path;
+  }
+}
+
+std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>>
+RunnerMetrics::CreateChannel(flutter::BinaryMessenger *messenger,
+                             const EventLoop *event_loop) {
+  auto channel =
+      std::make_unique<flutter::MethodChannel<flutter::EncodableValue>>(
+          messenger, kChannelName,
+          &flutter::StandardMethodCodec::GetInstance());
+  channel->SetMethodCallHandler(
+      [this, event_loop](const auto &call, auto result) {
+        HandleMethodCall(call, std::move(result), event_loop);
+      });
+  return channel;
+}
+
+void RunnerMetrics::RecordFirstFrame() {
+  if (first_frame_time_.count() >= 0) {
+    return;
+  }
+  first_frame_time_ = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start_time_);
+}
+
+void RunnerMetrics::RecordFrameTiming(
+    std::chrono::microseconds build_duration,
+    std::chrono::microseconds raster_duration) {
+  build_durations_.Record(build_duration);
+  raster_durations_.Record(raster_duration);
+}
+
+void RunnerMetrics::SetRenderer(const std::string &renderer) {
+  renderer_ = renderer;
+}
+
+void RunnerMetrics::RecordMemoryTrim(int64_t freed_bytes) {
+  ++memory_trims_;
+  memory_trim_freed_bytes_ += freed_bytes;
+}
+
+flutter::EncodableValue RunnerMetrics::ToEncodableValue(
+    const EventLoop::Statistics &event_loop_statistics) const {
+  flutter::EncodableValue first_frame_time;
+  if (first_frame_time_.count() >= 0) {
+    first_frame_time = flutter::EncodableValue(
+        static_cast<int64_t>(first_frame_time_.count()));
+  }
+  flutter::EncodableMap event_loop{
+      {flutter::EncodableValue("engine"),
+       EncodeHistogram(event_loop_statistics.engine_durations)},
+      {flutter::EncodableValue("fdDispatch"),
+       EncodeHistogram(event_loop_statistics.fd_dispatch_durations)},
+  };
+  return flutter::EncodableValue(flutter::EncodableMap{
+      {flutter::EncodableValue("renderer"), flutter::EncodableValue(renderer_)},
+      {flutter::EncodableValue("firstFrameMicros"), first_frame_time},
+      {flutter::EncodableValue("build"), EncodeHistogram(build_durations_)},
+      {flutter::EncodableValue("raster"), EncodeHistogram(raster_durations_)},
+      {flutter::EncodableValue("eventLoop"),
+       flutter::EncodableValue(event_loop)},
+      {flutter::EncodableValue("memoryTrims"),
+       flutter::EncodableValue(memory_trims_)},
+      {flutter::EncodableValue("memoryTrimFreedBytes"),
+       flutter::EncodableValue(memory_trim_freed_bytes_)},
+  });
+}
+
+bool RunnerMetrics::WriteOutput(
+    const EventLoop::Statistics &event_loop_statistics) const {
+  if (output_path_.empty()) {
+    return false;
+  }
+  FILE *file = fopen(output_path_.c_str(), "w");
+  if (!file) {
+    return false;
+  }
+  // The renderer name is one of a fixed set, so it doesn't need escaping.
+  fprintf(file, "{\"renderer\":\"%s\",", renderer_.c_str());
+  if (first_frame_time_.count() >= 0) {
+    fprintf(file, "\"firstFrameMicros\":%lld,",
+            static_cast<long long>(first_frame_time_.count()));
+  } else {
+    fprintf(file, "\"firstFrameMicros\":null,");
+  }
+  WriteHistogram(file, "build", build_durations_);
+  fprintf(file, ",");
+  WriteHistogram(file, "raster", raster_durations_);
+  fprintf(file, ",\"eventLoop\":{");
+  WriteHistogram(file, "engine", event_loop_statistics.engine_durations);
+  fprintf(file, ",");
+  WriteHistogram(file, "fdDispatch",
+                 event_loop_statistics.fd_dispatch_durations);
+  fprintf(file, "},\"memoryTrims\":%lld,\"memoryTrimFreedBytes\":%lld}\n",
+          static_cast<long long>(memory_trims_),
+          static_cast<long long>(memory_trim_freed_bytes_));
+  bool success = ferror(file) == 0;
+  fclose(file);
+  return success;
+}
+
+void RunnerMetrics::HandleMethodCall(
+    const flutter::MethodCall<flutter::EncodableValue> &method_call,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result,
+    const EventLoop *event_loop) {
+  const std::string &method = method_call.method_name();
+  if (method == "reportFirstFrame") {
+    RecordFirstFrame();
+    result->Success();
+  } else if (method == "reportFrameTimings") {
+    // A flat list of [build, raster] microsecond pairs.
+    const flutter::EncodableValue *arguments = method_call.arguments();
+    if (!arguments || !arguments->IsList() ||
+        arguments->ListValue().size() % 2 != 0) {
+      result->Error("bad_arguments",
+                    "Expected a list of build and raster duration pairs");
+      return;
+    }
+    const flutter::EncodableList &timings = arguments->ListValue();
+    for (const flutter::EncodableValue &timing : timings) {
+      if (!timing.IsInt() && !timing.IsLong()) {
+        result->Error("bad_arguments", "Expected integer durations");
+        return;
+      }
+    }
+    for (size_t i = 0; i + 1 < timings.size(); i += 2) {
+      RecordFrameTiming(std::chrono::microseconds(timings[i].LongValue()),
+                        std::chrono::microseconds(timings[i + 1].LongValue()));
+    }
+    result->Success();
+  } else if (method == "getMetrics") {
+    flutter::EncodableValue metrics =
+        ToEncodableValue(event_loop->statistics());
+    result->Success(&metrics);
+  } else {
+    result->NotImplemented();
+  }
+}
@@ -0,0 +1,109 @@
+#ifndef RUNNER_METRICS_H_
+#define RUNNER_METRICS_H_
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+#include <flutter/method_channel.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "duration_histogram.h"
+#include "event_loop.h"
+
+// Collects first frame and frame timing metrics, which can be queried along
+// with the event loop's statistics over a method channel, and written to a
+// file on exit.
+//
+// The engine doesn't report frame timings to the embedder, so they are
+// reported by the app over the channel created by CreateChannel:
+//
+//   const channel = MethodChannel('flutter_runner/metrics');
+//   WidgetsBinding.instance.waitUntilFirstFrameRasterized
+//       .then((_) => channel.invokeMethod<void>('reportFirstFrame'));
+//   SchedulerBinding.instance.addTimingsCallback((timings) {
+//     channel.invokeMethod<void>('reportFrameTimings', <int>[
+//       for (final timing in timings) ...<int>[
+//         timing.buildDuration.inMicroseconds,
+//         timing.rasterDuration.inMicroseconds,
+//       ],
+//     ]);
+//   });
+//
+// and 'getMetrics' returns a map of everything collected so far.
+class RunnerMetrics {
+ public:
+  RunnerMetrics();
+
+  // Prevent copying
+  RunnerMetrics(RunnerMetrics const &) = delete;
+  RunnerMetrics &operator=(RunnerMetrics const &) = delete;
+
+  // Sets the file written by WriteOutput to the path in the
+  // FLUTTER_RUNNER_METRICS_FILE environment variable, if it is set.
+  void EnableOutputFromEnvironment();
+
+  // Creates the metrics channel on |messenger|, reporting the statistics of
+  // |event_loop| along with frame metrics. Calls are handled for as long as
+  // the returned channel exists, which must not outlive |messenger| or this
+  // object.
+  std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>>
+  CreateChannel(flutter::BinaryMessenger *messenger,
+                const EventLoop *event_loop);
+
+  // Records that the first frame has been rasterized. Only the first call has
+  // any effect.
+  void RecordFirstFrame();
+
+  // Records the build (UI thread) and raster durations of a frame.
+  void RecordFrameTiming(std::chrono::microseconds build_duration,
+                         std::chrono::microseconds raster_duration);
+
+  // Sets the name of the renderer in use, which is reported with the frame
+  // metrics so that results from different renderers can be told apart.
+  void SetRenderer(const std::string &renderer);
+
+  // Records that the app was asked to release memory for memory pressure, and
+  // |freed_bytes| of resident memory were freed as a result.
+  void RecordMemoryTrim(int64_t freed_bytes);
+
+  // The frame timings recorded so far.
+  const DurationHistogram &build_durations() const { return build_durations_; }
+  const DurationHistogram &raster_durations() const {
+    return raster_durations_;
+  }
+
+  // Returns all metrics, including |event_loop_statistics|, as a map.
+  flutter::EncodableValue ToEncodableValue(
+      const EventLoop::Statistics &event_loop_statistics) const;
+
+  // Writes all metrics, including |event_loop_statistics|, as JSON to the
+  // path set by EnableOutputFromEnvironment. Returns false if no path is set
+  // or the file can't be written.
+  bool WriteOutput(const EventLoop::Statistics &event_loop_statistics) const;
+
+ private:
+  // Handles a call on a channel created by CreateChannel.
+  void HandleMethodCall(
+      const flutter::MethodCall<flutter::EncodableValue> &method_call,
+      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result,
+      const EventLoop *event_loop);
+
+  std::chrono::steady_clock::time_point start_time_;
+  std::string output_path_;
+  std::string renderer_;
+
+  // The time from start_time_ to the first frame, or a negative value if it
+  // hasn't been reported.
+  std::chrono::microseconds first_frame_time_{-1};
+
+  DurationHistogram build_durations_;
+  DurationHistogram raster_durations_;
+
+  // The number of memory trims, and the total bytes they freed.
+  int64_t memory_trims_ = 0;
+  int64_t memory_trim_freed_bytes_ = 0;
+};
+
+#endif  // RUNNER_METRICS_H_
@@ -0,0 +1,56 @@
+#include "secondary_windows.h"
+
+#include <iostream>
+
+namespace {
+
+// Returns |engine_arguments| with the initial route set to |route|.
+std::vector<std::string> WithRoute(
+    const std::vector<std::string> &engine_arguments,
+    const std::string &route) {
+  std::vector<std::string> arguments;
+  for (const std::string &argument : engine_arguments) {
+    if (argument.compare(0, 7, "--route") != 0) {
+      arguments.push_back(argument);
+    }
+  }
+  arguments.push_back("--route=" + route);
+  return arguments;
+}
+
+}  // namespace
+
+std::vector<SecondaryWindowController> CreateSecondaryWindows(
+    const std::vector<RunnerConfiguration::Window> &windows,
+    const flutter::WindowProperties &main_window_properties,
+    const std::string &icu_data_path, const std::string &assets_path,
+    const std::vector<std::string> &engine_arguments) {
+  std::vector<SecondaryWindowController> controllers;
+  for (const RunnerConfiguration::Window &window : windows) {
+    SecondaryWindowController controller;
+    controller.flutter_controller =
+        std::make_unique<flutter::FlutterWindowController>(icu_data_path);
+    flutter::WindowProperties window_properties = main_window_properties;
+    if (window.width != 0) {
+      window_properties.width = window.width;
+      window_properties.height = window.height;
+    }
+    controller.created = controller.flutter_controller->CreateWindow(
+        window_properties, assets_path,
+        WithRoute(engine_arguments, window.route));
+    if (!controller.created) {
+      std::cerr << "Unable to create the window for " << window.route
+                << std::endl;
+    } else if (window.has_position) {
+      flutter::FlutterWindow *flutter_window =
+          controller.flutter_controller->window();
+      flutter::WindowFrame frame = flutter_window->GetFrame();
+      frame.left = window.left;
+      frame.top = window.top;
+      flutter_window->SetFrame(frame);
+    }
+    // Kept even if the window wasn't created; see the header.
+    controllers.push_back(std::move(controller));
+  }
+  return controllers;
+}
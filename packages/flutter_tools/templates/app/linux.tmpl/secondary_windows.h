@@ -0,0 +1,34 @@
+#ifndef SECONDARY_WINDOWS_H_
+#define SECONDARY_WINDOWS_H_
+
+#include <flutter/flutter_window_controller.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "runner_configuration.h"
+
+// The controller for a window added with the 'window' setting.
+struct SecondaryWindowController {
+  std::unique_ptr<flutter::FlutterWindowController> flutter_controller;
+  // False if the window couldn't be created.
+  bool created = false;
+};
+
+// Creates a window, each with its own engine, for each of |windows|, using
+// |main_window_properties| for the title and any size that isn't given.
+// Each engine starts on its window's route, with |engine_arguments|.
+//
+// Every controller initializes GLFW, and destroying any of them terminates
+// it, which destroys every window still open. So a controller is returned for
+// every entry in |windows|, including those whose window couldn't be created
+// (which are reported on stderr), and the caller must keep them all until
+// after the main window's controller has been destroyed.
+std::vector<SecondaryWindowController> CreateSecondaryWindows(
+    const std::vector<RunnerConfiguration::Window> &windows,
+    const flutter::WindowProperties &main_window_properties,
+    const std::string &icu_data_path, const std::string &assets_path,
+    const std::vector<std::string> &engine_arguments);
+
+#endif  // SECONDARY_WINDOWS_H_
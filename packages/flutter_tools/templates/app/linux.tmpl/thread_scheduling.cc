@@ -0,0 +1,42 @@
+#include "thread_scheduling.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+void ApplyThreadScheduling(const RunnerConfiguration &configuration) {
+  if (!configuration.cpu_affinity.empty()) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (unsigned int cpu : configuration.cpu_affinity) {
+      CPU_SET(cpu, &cpus);
+    }
+    // A pid of zero is the calling thread.
+    if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+      std::cerr << "Unable to set CPU affinity: " << strerror(errno)
+                << std::endl;
+    }
+  }
+
+  if (configuration.realtime_priority > 0) {
+    sched_param param = {};
+    param.sched_priority = static_cast<int>(configuration.realtime_priority);
+    int result = pthread_setschedparam(pthread_self(), SCHED_RR, &param);
+    if (result != 0) {
+      std::cerr << "Unable to use SCHED_RR priority "
+                << configuration.realtime_priority << ": " << strerror(result)
+                << std::endl;
+    }
+  } else if (configuration.nice != 0) {
+    // On Linux the nice value is per thread, and a who of zero is the calling
+    // thread.
+    if (setpriority(PRIO_PROCESS, 0, configuration.nice) != 0) {
+      std::cerr << "Unable to set nice value " << configuration.nice << ": "
+                << strerror(errno) << std::endl;
+    }
+  }
+}
@@ -0,0 +1,23 @@
+#ifndef THREAD_SCHEDULING_H_
+#define THREAD_SCHEDULING_H_
+
+#include "runner_configuration.h"
+
+// Applies the configuration's nice, realtime_priority and cpu_affinity
+// settings to the calling thread. This must be called on the main thread
+// before the window is created, since Linux threads inherit their scheduling
+// policy, nice value and CPU affinity from the thread that creates them: the
+// engine's UI, raster and IO threads are created with the window, so they
+// pick up the settings along with the platform thread.
+//
+// All settings are opt-in. Raising priority (a negative nice value, or any
+// realtime priority) needs CAP_SYS_NICE or a matching RLIMIT_NICE or
+// RLIMIT_RTPRIO limit; settings that can't be applied are reported on stderr
+// and otherwise ignored.
+//
+// SCHED_RR threads run ahead of every normal thread on their CPUs, including
+// the compositor's, so realtime_priority is best combined with a cpu_affinity
+// that leaves at least one CPU to the rest of the system.
+void ApplyThreadScheduling(const RunnerConfiguration &configuration);
+
+#endif  // THREAD_SCHEDULING_H_
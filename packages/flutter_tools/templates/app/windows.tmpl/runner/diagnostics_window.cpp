@@ -0,0 +1,103 @@
+#include "diagnostics_window.h"
+
+#include <flutter_windows.h>
+
+namespace {
+
+// The refresh timer. Win32Window's own timers start from 1.
+constexpr UINT_PTR kRefreshTimerId = 100;
+
+// The text size, in points.
+constexpr int kFontPointSize = 9;
+
+// The margin around the text, in logical pixels.
+constexpr int kMargin = 8;
+
+}  // namespace
+
+DiagnosticsWindow::DiagnosticsWindow(std::function<std::wstring()> get_text,
+                                     std::chrono::milliseconds refresh_interval)
+    : get_text_(std::move(get_text)), refresh_interval_(refresh_interval) {
+  // Shown by OnCreate, without activation.
+  SetShowDeferred(true);
+}
+
+DiagnosticsWindow::~DiagnosticsWindow() {
+  // Destroyed here rather than by Win32Window, so that OnDestroy runs.
+  Destroy();
+  if (font_) {
+    ::DeleteObject(font_);
+  }
+}
+
+void DiagnosticsWindow::OnCreate() {
+  Win32Window::OnCreate();
+  HWND window = GetHandle();
+  text_ = get_text_();
+  UpdateFont(window);
+  ::SetTimer(window, kRefreshTimerId,
+             static_cast<UINT>(refresh_interval_.count()), nullptr);
+  ::SetWindowPos(window, HWND_TOPMOST, 0, 0, 0, 0,
+                 SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
+  ::ShowWindow(window, SW_SHOWNOACTIVATE);
+}
+
+void DiagnosticsWindow::OnDestroy() {
+  HWND window = GetHandle();
+  if (window) {
+    ::KillTimer(window, kRefreshTimerId);
+  }
+  Win32Window::OnDestroy();
+}
+
+LRESULT
+DiagnosticsWindow::MessageHandler(HWND hwnd,
+                                  UINT const message,
+                                  WPARAM const wparam,
+                                  LPARAM const lparam) noexcept {
+  switch (message) {
+    case WM_TIMER:
+      if (wparam == kRefreshTimerId) {
+        text_ = get_text_();
+        ::InvalidateRect(hwnd, nullptr, TRUE);
+        return 0;
+      }
+      break;
+    case WM_PAINT:
+      Paint(hwnd);
+      return 0;
+    case WM_DPICHANGED:
+      UpdateFont(hwnd);
+      ::InvalidateRect(hwnd, nullptr, TRUE);
+      break;
+  }
+  return Win32Window::MessageHandler(hwnd, message, wparam, lparam);
+}
+
+void DiagnosticsWindow::Paint(HWND window) {
+  PAINTSTRUCT paint;
+  HDC dc = ::BeginPaint(window, &paint);
+  RECT rect;
+  ::GetClientRect(window, &rect);
+  int margin = ::MulDiv(kMargin, FlutterDesktopGetDpiForHWND(window), 96);
+  ::InflateRect(&rect, -margin, -margin);
+  HGDIOBJ previous_font = ::SelectObject(dc, font_);
+  ::SetBkMode(dc, TRANSPARENT);
+  ::DrawTextW(dc, text_.c_str(), static_cast<int>(text_.size()), &rect,
+              DT_LEFT | DT_TOP | DT_EXPANDTABS | DT_NOPREFIX);
+  ::SelectObject(dc, previous_font);
+  ::EndPaint(window, &paint);
+}
+
+void DiagnosticsWindow::UpdateFont(HWND window) {
+  if (font_) {
+    ::DeleteObject(font_);
+  }
+  int height =
+      -::MulDiv(kFontPointSize, FlutterDesktopGetDpiForHWND(window), 72);
+  // Fixed-width, so that columns of numbers line up.
+  font_ = ::CreateFontW(height, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE,
+                        DEFAULT_CHARSET, OUT_DEFAULT_PRECIS,
+                        CLIP_DEFAULT_PRECIS, CLEARTYPE_QUALITY,
+                        FIXED_PITCH | FF_MODERN, L"Consolas");
+}
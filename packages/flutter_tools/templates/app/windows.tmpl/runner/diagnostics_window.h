@@ -0,0 +1,49 @@
+#ifndef DIAGNOSTICS_WINDOW_H_
+#define DIAGNOSTICS_WINDOW_H_
+
+#include <windows.h>
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include "win32_window.h"
+
+// A small always-on-top window showing text that is refreshed periodically,
+// such as live counters from RunnerDiagnostics. It is shown without taking
+// focus from the app.
+class DiagnosticsWindow : public Win32Window {
+ public:
+  // Shows the result of |get_text|, which is called again every
+  // |refresh_interval|.
+  DiagnosticsWindow(std::function<std::wstring()> get_text,
+                    std::chrono::milliseconds refresh_interval);
+  virtual ~DiagnosticsWindow();
+
+  // Prevent copying
+  DiagnosticsWindow(DiagnosticsWindow const&) = delete;
+  DiagnosticsWindow& operator=(DiagnosticsWindow const&) = delete;
+
+ protected:
+  // Win32Window:
+  LRESULT MessageHandler(HWND window,
+                         UINT const message,
+                         WPARAM const wparam,
+                         LPARAM const lparam) noexcept override;
+  void OnCreate() override;
+  void OnDestroy() override;
+
+ private:
+  // Draws text_ into the client area.
+  void Paint(HWND window);
+
+  // Recreates font_ for |window|'s DPI.
+  void UpdateFont(HWND window);
+
+  std::function<std::wstring()> get_text_;
+  std::chrono::milliseconds refresh_interval_;
+  std::wstring text_;
+  HFONT font_ = nullptr;
+};
+
+#endif  // DIAGNOSTICS_WINDOW_H_
@@ -0,0 +1,47 @@
+#ifndef DURATION_HISTOGRAM_H_
+#define DURATION_HISTOGRAM_H_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+// A fixed-size histogram of durations, with power-of-two microsecond buckets.
+// Bucket 0 counts durations under 2us, and bucket i (for i > 0) counts
+// durations in [2^i, 2^(i+1)) microseconds; the last bucket also counts
+// anything longer.
+//
+// Recording is constant time and never allocates, so it's cheap enough to use
+// on every run loop iteration.
+class DurationHistogram {
+ public:
+  static constexpr size_t kBucketCount = 24;
+
+  // Adds |duration| to the histogram. Negative durations count as zero.
+  void Record(std::chrono::nanoseconds duration);
+
+  // Returns an upper bound on the given |percentile| (in [0, 100]) of the
+  // recorded durations, based on the bucket it falls in, or zero if nothing
+  // has been recorded.
+  std::chrono::microseconds Percentile(double percentile) const;
+
+  // Returns a histogram of the durations recorded since this histogram was
+  // copied to |earlier|, e.g., for the last second of a live display. Its
+  // longest duration is an upper bound, since the longest of the new
+  // durations isn't tracked separately.
+  DurationHistogram Since(const DurationHistogram& earlier) const;
+
+  uint64_t count() const { return count_; }
+  std::chrono::nanoseconds total() const { return total_; }
+  std::chrono::nanoseconds longest() const { return longest_; }
+  const std::array<uint64_t, kBucketCount>& buckets() const {
+    return buckets_;
+  }
+
+ private:
+  std::array<uint64_t, kBucketCount> buckets_ = {};
+  uint64_t count_ = 0;
+  std::chrono::nanoseconds total_{0};
+  std::chrono::nanoseconds longest_{0};
+};
+
+#endif  // DURATION_HISTOGRAM_H_
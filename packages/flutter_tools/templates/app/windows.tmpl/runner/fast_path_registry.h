@@ -0,0 +1,49 @@
+#ifndef FAST_PATH_REGISTRY_H_
+#define FAST_PATH_REGISTRY_H_
+
+#include <cstdint>
+
+// A registry of small native queries that the framework can call
+// synchronously through dart:ffi, for values that are read too often to go
+// through a platform channel, such as per-frame layout metrics or sensor
+// snapshots. A channel call is encoded, hops to the platform thread and back,
+// and allocates its reply; a fast path query is a direct call on the UI
+// thread.
+//
+// Plugins register queries by name, with FlutterRunnerRegisterFastPath. The
+// framework finds them with DynamicLibrary.executable(): it looks up each
+// name's index once, with FlutterRunnerFastPathCount and
+// FlutterRunnerFastPathName, and then calls FlutterRunnerQueryFastPath with
+// the index. The same functions are exported by the Linux runner and can be
+// provided by iOS hosts, so the Dart side is the same everywhere. See the
+// platform_channel example's lib/fast_path.dart.
+//
+// Queries are called on the framework's UI thread, concurrently with
+// everything else, so they must be thread-safe and must not block: read a
+// value that another thread keeps up to date, e.g. in an atomic. Queries stay
+// registered for the life of the process.
+//
+// Plugins can look the functions up with
+// GetProcAddress(GetModuleHandle(nullptr), ...), as with
+// FlutterRunnerPostWorkerTask.
+
+// Registers |query| under |name|, to be called with |user_data|. |name| is
+// copied. Returns false if |name| is already registered, is longer than 63
+// bytes, or if the registry is full.
+extern "C" __declspec(dllexport) bool FlutterRunnerRegisterFastPath(
+    const char* name,
+    int64_t (*query)(void* user_data),
+    void* user_data);
+
+// Returns the number of registered queries. Indices below this are valid.
+extern "C" __declspec(dllexport) int32_t FlutterRunnerFastPathCount();
+
+// Returns the name of query |index|, or nullptr if there is no such query.
+extern "C" __declspec(dllexport) const char* FlutterRunnerFastPathName(
+    int32_t index);
+
+// Calls query |index|. Returns INT64_MIN if there is no such query.
+extern "C" __declspec(dllexport) int64_t FlutterRunnerQueryFastPath(
+    int32_t index);
+
+#endif  // FAST_PATH_REGISTRY_H_
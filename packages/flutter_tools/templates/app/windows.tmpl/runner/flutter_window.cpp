@@ -1,6 +1,25 @@
 #include "flutter_window.h"
 
+#include <flutter/plugin_registrar_windows.h>
+
 #include "flutter/generated_plugin_registrant.h"
+#include "runner_metrics.h"
+#include "startup_trace.h"
+
+namespace {
+
+// The channel used by the framework for application lifecycle state, which
+// uses a string codec.
+constexpr char kLifecycleChannel[] = "flutter/lifecycle";
+
+// The channel used by the framework for system messages, which uses a JSON
+// codec.
+constexpr char kSystemChannel[] = "flutter/system";
+
+// The number of threads in the worker pool.
+constexpr size_t kWorkerThreadCount = 2;
+
+}  // namespace
 
 FlutterWindow::FlutterWindow(RunLoop* run_loop,
                              const flutter::DartProject& project)
@@ -8,22 +27,91 @@ FlutterWindow::FlutterWindow(RunLoop* run_loop,
 
 FlutterWindow::~FlutterWindow() {}
 
+void FlutterWindow::SetWorkerThreadPriority(int priority) {
+  worker_thread_priority_ = priority;
+}
+
 void FlutterWindow::OnCreate() {
   Win32Window::OnCreate();
+  // Flutter lays out and redraws the whole view for each size change, so a
+  // live resize is applied at most once per display refresh.
+  SetResizeCoalescingEnabled(true);
 
-  // The size here is arbitrary since SetChildContent will resize it.
-  flutter_controller_ =
-      std::make_unique<flutter::FlutterViewController>(100, 100, project_);
-  RegisterPlugins(flutter_controller_.get());
+  {
+    StartupTrace::Scope scope("CreateFlutterViewController");
+    // The size here is arbitrary since SetChildContent will resize it.
+    flutter_controller_ =
+        std::make_unique<flutter::FlutterViewController>(100, 100, project_);
+  }
+  // Plugins may post blocking work and register pixel buffers as they are
+  // registered.
+  worker_pool_ = std::make_unique<WorkerPool>(run_loop_, kWorkerThreadCount);
+  worker_pool_->SetWorkerThreadPriority(worker_thread_priority_);
+  WorkerPool::SetPluginWorkerPool(worker_pool_.get());
+  pixel_buffer_registrar_ =
+      std::make_unique<PixelBufferRegistrar>(run_loop_, GetMessenger());
+  PixelBufferRegistrar::SetPluginRegistrar(pixel_buffer_registrar_.get());
+  {
+    StartupTrace::Scope scope("RegisterPlugins");
+    RegisterPlugins(flutter_controller_.get());
+  }
+  metrics_channel_ =
+      RunnerMetrics::GetInstance()->CreateChannel(GetMessenger(), run_loop_);
   run_loop_->RegisterFlutterInstance(flutter_controller_.get());
+  memory_pressure_monitor_ = std::make_unique<MemoryPressureMonitor>(
+      run_loop_, [this]() { SendMemoryPressure(); },
+      [](int64_t freed_bytes) {
+        RunnerMetrics::GetInstance()->RecordMemoryTrim(freed_bytes);
+      });
+  memory_pressure_monitor_->Start();
   SetChildContent(flutter_controller_->view()->GetNativeWindow());
 }
 
 void FlutterWindow::OnDestroy() {
   if (flutter_controller_) {
+    // This runs the cancel callbacks of outstanding plugin tasks, so it must
+    // come before the plugins are destroyed along with the engine.
+    worker_pool_ = nullptr;
+    memory_pressure_monitor_ = nullptr;
+    metrics_channel_ = nullptr;
+    pixel_buffer_registrar_ = nullptr;
     run_loop_->UnregisterFlutterInstance(flutter_controller_.get());
     flutter_controller_ = nullptr;
   }
 
   Win32Window::OnDestroy();
 }
+
+void FlutterWindow::OnOcclusionChanged(bool occluded) {
+  if (!flutter_controller_) {
+    return;
+  }
+  // A paused app stops scheduling frames, so the engine stops rendering while
+  // nothing is visible.
+  SendLifecycleState(occluded ? "AppLifecycleState.paused"
+                              : "AppLifecycleState.resumed");
+  run_loop_->SetFlutterInstanceThrottled(flutter_controller_.get(), occluded);
+}
+
+void FlutterWindow::SendLifecycleState(const std::string& state) {
+  GetMessenger()->Send(kLifecycleChannel,
+                       reinterpret_cast<const uint8_t*>(state.data()),
+                       state.size());
+}
+
+void FlutterWindow::SendMemoryPressure() {
+  // The framework clears its image cache and notifies
+  // WidgetsBindingObserver.didHaveMemoryPressure; cache size limits are left
+  // alone, so caches refill normally once memory is available again.
+  static constexpr char kMessage[] = "{\"type\":\"memoryPressure\"}";
+  GetMessenger()->Send(kSystemChannel,
+                       reinterpret_cast<const uint8_t*>(kMessage),
+                       sizeof(kMessage) - 1);
+}
+
+flutter::BinaryMessenger* FlutterWindow::GetMessenger() {
+  return flutter::PluginRegistrarManager::GetInstance()
+      ->GetRegistrar<flutter::PluginRegistrarWindows>(
+          flutter_controller_->GetRegistrarForPlugin("FlutterWindow"))
+      ->messenger();
+}
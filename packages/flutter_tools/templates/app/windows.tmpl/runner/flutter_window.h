@@ -1,15 +1,27 @@
 #ifndef FLUTTER_WINDOW_H_
 #define FLUTTER_WINDOW_H_
 
+#include <flutter/binary_messenger.h>
 #include <flutter/dart_project.h>
+#include <flutter/encodable_value.h>
 #include <flutter/flutter_view_controller.h>
+#include <flutter/method_channel.h>
 
+#include "memory_pressure_monitor.h"
+#include "pixel_buffer_registrar.h"
 #include "run_loop.h"
 #include "win32_window.h"
+#include "worker_pool.h"
 
 #include <memory>
+#include <string>
 
 // A window that does nothing but host a Flutter view.
+//
+// Each FlutterWindow runs its own engine; the Windows embedding currently
+// supports only a single view per engine, so views can't be shared between
+// windows. Multiple FlutterWindows can still share one RunLoop, which
+// services each engine only when it has due work.
 class FlutterWindow : public Win32Window {
  public:
   // Creates a new FlutterWindow driven by the |run_loop|, hosting a
@@ -18,12 +30,28 @@ class FlutterWindow : public Win32Window {
                          const flutter::DartProject& project);
   virtual ~FlutterWindow();
 
+  // Sets the SetThreadPriority priority of the worker pool's threads (see
+  // WorkerPool). Must be called before the window is created.
+  void SetWorkerThreadPriority(int priority);
+
  protected:
   // Win32Window:
   void OnCreate() override;
   void OnDestroy() override;
+  void OnOcclusionChanged(bool occluded) override;
 
  private:
+  // Sends |state| (the string form of a Dart AppLifecycleState value) to the
+  // framework.
+  void SendLifecycleState(const std::string& state);
+
+  // Asks the framework to release memory it can recreate, such as decoded
+  // images.
+  void SendMemoryPressure();
+
+  // Returns the messenger for the runner's own channels.
+  flutter::BinaryMessenger* GetMessenger();
+
   // The run loop driving events for this window.
   RunLoop* run_loop_;
 
@@ -32,6 +60,23 @@ class FlutterWindow : public Win32Window {
 
   // The Flutter instance hosted by this window.
   std::unique_ptr<flutter::FlutterViewController> flutter_controller_;
+
+  // The channel for querying and reporting runner metrics (see
+  // RunnerMetrics).
+  std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>>
+      metrics_channel_;
+
+  // Runs blocking work for plugins and runner code (see WorkerPool). It is
+  // created before plugins are registered and destroyed before the engine,
+  // so that outstanding tasks are cancelled while the plugins still exist.
+  std::unique_ptr<WorkerPool> worker_pool_;
+  int worker_thread_priority_ = THREAD_PRIORITY_NORMAL;
+
+  // Carries frames from plugins to the framework (see PixelBufferRegistrar).
+  std::unique_ptr<PixelBufferRegistrar> pixel_buffer_registrar_;
+
+  // Forwards low system memory to the framework.
+  std::unique_ptr<MemoryPressureMonitor> memory_pressure_monitor_;
 };
 
 #endif  // FLUTTER_WINDOW_H_
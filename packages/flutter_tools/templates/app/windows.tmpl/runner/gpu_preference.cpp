@@ -0,0 +1,122 @@
+#include "gpu_preference.h"
+
+#include <windows.h>
+
+#include <cwchar>
+#include <iostream>
+#include <string>
+
+namespace {
+
+constexpr const wchar_t kUserGpuPreferencesKey[] =
+    L"Software\\Microsoft\\DirectX\\UserGpuPreferences";
+
+// Where the runner records the preference values it has written, keyed by
+// executable path like kUserGpuPreferencesKey, so that it can tell them apart
+// from values the user chose in graphics settings.
+constexpr const wchar_t kRunnerGpuPreferencesKey[] =
+    L"Software\\Flutter\\RunnerGpuPreferences";
+
+// Returns the registry value for |preference|, in the format used by
+// Windows' graphics settings.
+const wchar_t* GpuPreferenceValue(
+    RunnerConfiguration::GpuPreference preference) {
+  switch (preference) {
+    case RunnerConfiguration::GpuPreference::kPowerSaving:
+      return L"GpuPreference=1;";
+    case RunnerConfiguration::GpuPreference::kHighPerformance:
+      return L"GpuPreference=2;";
+    default:
+      return nullptr;
+  }
+}
+
+// Returns the full path of this executable, or an empty string on failure.
+std::wstring GetExecutablePath() {
+  wchar_t buffer[MAX_PATH];
+  DWORD length = ::GetModuleFileNameW(nullptr, buffer, MAX_PATH);
+  if (length == 0 || length == MAX_PATH) {
+    return std::wstring();
+  }
+  return std::wstring(buffer, length);
+}
+
+// Reads the string value |name| of HKEY_CURRENT_USER\|key| into |value|,
+// returning false if there is no such value.
+bool ReadPreference(const wchar_t* key, const std::wstring& name,
+                    std::wstring* value) {
+  wchar_t buffer[64];
+  DWORD size = sizeof(buffer);
+  if (::RegGetValueW(HKEY_CURRENT_USER, key, name.c_str(), RRF_RT_REG_SZ,
+                     nullptr, buffer, &size) != ERROR_SUCCESS) {
+    return false;
+  }
+  *value = buffer;
+  return true;
+}
+
+// Sets the string value |name| of HKEY_CURRENT_USER\|key| to |value|,
+// creating the key if needed. Returns false on failure.
+bool WritePreference(const wchar_t* key, const std::wstring& name,
+                     const wchar_t* value) {
+  DWORD size = static_cast<DWORD>((wcslen(value) + 1) * sizeof(wchar_t));
+  LSTATUS status = ::RegSetKeyValueW(HKEY_CURRENT_USER, key, name.c_str(),
+                                     REG_SZ, value, size);
+  if (status != ERROR_SUCCESS) {
+    std::wcerr << L"Unable to set the GPU preference: error " << status
+               << std::endl;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+void ApplyGpuPreference(RunnerConfiguration::GpuPreference preference) {
+  std::wstring executable_path = GetExecutablePath();
+  if (executable_path.empty()) {
+    return;
+  }
+
+  std::wstring current;
+  bool has_current =
+      ReadPreference(kUserGpuPreferencesKey, executable_path, &current);
+  std::wstring written;
+  bool has_written =
+      ReadPreference(kRunnerGpuPreferencesKey, executable_path, &written);
+  // A value the runner wrote that has since been changed in graphics
+  // settings belongs to the user.
+  bool runner_owned = has_current && has_written && current == written;
+  if (has_written && !runner_owned) {
+    ::RegDeleteKeyValueW(HKEY_CURRENT_USER, kRunnerGpuPreferencesKey,
+                         executable_path.c_str());
+  }
+
+  const wchar_t* value = GpuPreferenceValue(preference);
+  if (!value) {
+    // Remove the runner's preference, restoring the system default.
+    if (runner_owned) {
+      ::RegDeleteKeyValueW(HKEY_CURRENT_USER, kUserGpuPreferencesKey,
+                           executable_path.c_str());
+      ::RegDeleteKeyValueW(HKEY_CURRENT_USER, kRunnerGpuPreferencesKey,
+                           executable_path.c_str());
+    }
+    return;
+  }
+  if (has_current && !runner_owned) {
+    if (current != value) {
+      std::cerr << "gpu_preference is ignored, since a preference has been "
+                   "chosen for this app in Windows graphics settings"
+                << std::endl;
+    }
+    return;
+  }
+  if (runner_owned && current == value) {
+    return;
+  }
+  // The marker is written first, so that a value the runner wrote is never
+  // mistaken for the user's.
+  if (WritePreference(kRunnerGpuPreferencesKey, executable_path, value)) {
+    WritePreference(kUserGpuPreferencesKey, executable_path, value);
+  }
+}
@@ -0,0 +1,28 @@
+#ifndef GPU_PREFERENCE_H_
+#define GPU_PREFERENCE_H_
+
+#include "runner_configuration.h"
+
+// Sets the GPU that Windows gives this executable on machines with more than
+// one, such as laptops with integrated and discrete graphics.
+//
+// This is the per-app preference from Windows' graphics settings, which
+// reorders the adapters DXGI enumerates so that the preferred one comes first;
+// the embedding's ANGLE device uses the first adapter. It is stored for the
+// current user, keyed by the executable's path, and is only written when it
+// differs from the stored value. The runner records the values it writes
+// under HKEY_CURRENT_USER\Software\Flutter\RunnerGpuPreferences, and never
+// overwrites a preference it didn't write, so a choice the user has made in
+// graphics settings takes precedence.
+//
+// Windows may only read the preference when the process first uses DXGI, so
+// this must be called before anything creates a DXGI factory or Direct3D
+// device, and a preference that was just changed may only take effect from
+// the next launch. The adapter that was selected is reported by
+// GetDefaultAdapter (see renderer_detection.h).
+//
+// kDefault removes a preference the runner wrote, and leaves any preference
+// the user has chosen in graphics settings unchanged.
+void ApplyGpuPreference(RunnerConfiguration::GpuPreference preference);
+
+#endif  // GPU_PREFERENCE_H_
@@ -0,0 +1,282 @@
+#include "input_trace.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// Don't stomp std::min/std::max
+#undef max
+#undef min
+
+// Available in the Windows 10 1803 SDK and later.
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace {
+
+// The first line of every trace, followed by the format version.
+constexpr char kTraceMagic[] = "flutter_input_trace";
+constexpr int kTraceVersion = 1;
+
+// How long after the last event the replay is reported as finished.
+constexpr std::chrono::seconds kSettleTime(1);
+
+// Returns true if |message| is input that InputTraceRecorder records from the
+// queue. Characters aren't recorded, since the run loop's TranslateMessage
+// generates them again from the replayed key messages.
+bool IsRecordedInput(UINT message) {
+  return (message >= WM_MOUSEFIRST && message <= WM_MOUSELAST) ||
+         message == WM_MOUSELEAVE || message == WM_KEYDOWN ||
+         message == WM_KEYUP || message == WM_SYSKEYDOWN ||
+         message == WM_SYSKEYUP;
+}
+
+// Resizes |window| as described by the WM_SIZE |wparam| and |lparam|.
+void ApplySize(HWND window, WPARAM wparam, LPARAM lparam) {
+  if (wparam == SIZE_MINIMIZED) {
+    ::ShowWindow(window, SW_SHOWMINNOACTIVE);
+    return;
+  }
+  if (wparam == SIZE_MAXIMIZED) {
+    ::ShowWindow(window, SW_MAXIMIZE);
+    return;
+  }
+  if (::IsIconic(window) || ::IsZoomed(window)) {
+    ::ShowWindow(window, SW_SHOWNOACTIVATE);
+  }
+  // WM_SIZE has the client size, so add the current non-client size.
+  RECT window_rect;
+  RECT client_rect;
+  ::GetWindowRect(window, &window_rect);
+  ::GetClientRect(window, &client_rect);
+  int width = LOWORD(lparam) + (window_rect.right - window_rect.left) -
+              client_rect.right;
+  int height = HIWORD(lparam) + (window_rect.bottom - window_rect.top) -
+               client_rect.bottom;
+  ::SetWindowPos(window, nullptr, 0, 0, width, height,
+                 SWP_NOMOVE | SWP_NOZORDER | SWP_NOACTIVATE);
+}
+
+}  // namespace
+
+InputTraceRecorder::InputTraceRecorder(HWND window,
+                                       const std::wstring& output_path)
+    : window_(window),
+      output_path_(output_path),
+      start_time_(std::chrono::steady_clock::now()) {
+  // A few minutes of continuous mouse movement.
+  events_.reserve(64 * 1024);
+}
+
+void InputTraceRecorder::RecordQueuedMessage(const MSG& message) {
+  if (!IsRecordedInput(message.message) ||
+      (message.hwnd != window_ && !::IsChild(window_, message.hwnd))) {
+    return;
+  }
+  InputTraceEvent event = {};
+  event.time = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start_time_);
+  event.for_view = message.hwnd != window_;
+  event.message = message.message;
+  event.wparam = message.wParam;
+  event.lparam = message.lParam;
+  events_.push_back(event);
+}
+
+void InputTraceRecorder::RecordWindowMessage(UINT message,
+                                             WPARAM wparam,
+                                             LPARAM lparam) {
+  if (message != WM_SIZE && message != WM_DPICHANGED &&
+      message != WM_ACTIVATE) {
+    return;
+  }
+  InputTraceEvent event = {};
+  event.time = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start_time_);
+  event.for_view = false;
+  event.message = message;
+  event.wparam = wparam;
+  if (message == WM_DPICHANGED) {
+    event.rect = *reinterpret_cast<const RECT*>(lparam);
+  } else if (message == WM_SIZE) {
+    event.lparam = lparam;
+  }
+  // WM_ACTIVATE's lparam is the other window involved, which means nothing
+  // in a replay.
+  events_.push_back(event);
+}
+
+bool InputTraceRecorder::WriteOutput() const {
+  FILE* file = nullptr;
+  if (_wfopen_s(&file, output_path_.c_str(), L"w") != 0 || !file) {
+    return false;
+  }
+  fprintf(file, "%s %d\n", kTraceMagic, kTraceVersion);
+  for (const InputTraceEvent& event : events_) {
+    fprintf(file, "%lld %s %u %llu %lld",
+            static_cast<long long>(event.time.count()),
+            event.for_view ? "view" : "window", event.message,
+            static_cast<unsigned long long>(event.wparam),
+            static_cast<long long>(event.lparam));
+    if (event.message == WM_DPICHANGED) {
+      fprintf(file, " %ld %ld %ld %ld", event.rect.left, event.rect.top,
+              event.rect.right, event.rect.bottom);
+    }
+    fprintf(file, "\n");
+  }
+  bool success = ferror(file) == 0;
+  fclose(file);
+  return success;
+}
+
+InputTraceReplayer::InputTraceReplayer(RunLoop* run_loop, HWND window)
+    : run_loop_(run_loop), window_(window) {}
+
+InputTraceReplayer::~InputTraceReplayer() {
+  if (timer_) {
+    run_loop_->RemoveWaitHandle(timer_);
+    ::CloseHandle(timer_);
+  }
+}
+
+bool InputTraceReplayer::Load(const std::wstring& path) {
+  std::ifstream file(path.c_str());
+  if (!file) {
+    std::wcerr << L"Unable to read input trace " << path << std::endl;
+    return false;
+  }
+  std::string line;
+  std::getline(file, line);
+  std::istringstream header(line);
+  std::string magic;
+  int version = 0;
+  if (!(header >> magic >> version) || magic != kTraceMagic ||
+      version != kTraceVersion) {
+    std::wcerr << path << L": not a version " << kTraceVersion
+               << L" input trace" << std::endl;
+    return false;
+  }
+  events_.clear();
+  int line_number = 1;
+  while (std::getline(file, line)) {
+    ++line_number;
+    if (line.empty()) {
+      continue;
+    }
+    std::istringstream fields(line);
+    long long time;
+    std::string target;
+    unsigned long long wparam;
+    long long lparam;
+    InputTraceEvent event = {};
+    bool valid = static_cast<bool>(fields >> time >> target >> event.message >>
+                                   wparam >> lparam) &&
+                 (target == "window" || target == "view");
+    if (valid && event.message == WM_DPICHANGED) {
+      valid = static_cast<bool>(fields >> event.rect.left >> event.rect.top >>
+                                event.rect.right >> event.rect.bottom);
+    }
+    if (!valid) {
+      std::wcerr << path << L":" << line_number << L": invalid event"
+                 << std::endl;
+      return false;
+    }
+    event.time = std::chrono::microseconds(time);
+    event.for_view = target == "view";
+    event.wparam = static_cast<WPARAM>(wparam);
+    event.lparam = static_cast<LPARAM>(lparam);
+    events_.push_back(event);
+  }
+  return true;
+}
+
+bool InputTraceReplayer::Start(double speed,
+                               std::function<void()> on_finished) {
+  if (timer_) {
+    return false;
+  }
+  // Fall back to a standard timer, with the system timer resolution
+  // (typically ~15.6ms), before Windows 10 1803.
+  timer_ = ::CreateWaitableTimerExW(nullptr, nullptr,
+                                    CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                    TIMER_ALL_ACCESS);
+  if (!timer_) {
+    timer_ = ::CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+  }
+  if (!timer_) {
+    return false;
+  }
+  if (!run_loop_->AddWaitHandle(timer_, [this]() { DeliverDueEvents(); })) {
+    ::CloseHandle(timer_);
+    timer_ = nullptr;
+    return false;
+  }
+  speed_ = speed;
+  on_finished_ = std::move(on_finished);
+  next_event_ = 0;
+  settling_ = false;
+  start_time_ = std::chrono::steady_clock::now();
+  DeliverDueEvents();
+  return true;
+}
+
+void InputTraceReplayer::DeliverDueEvents() {
+  auto event_time = [this](const InputTraceEvent& event) {
+    return std::chrono::nanoseconds(static_cast<int64_t>(
+        std::chrono::nanoseconds(event.time).count() / speed_));
+  };
+  std::chrono::nanoseconds elapsed =
+      std::chrono::steady_clock::now() - start_time_;
+  while (next_event_ < events_.size() &&
+         event_time(events_[next_event_]) <= elapsed) {
+    Deliver(events_[next_event_++]);
+  }
+  if (next_event_ < events_.size()) {
+    ScheduleAt(event_time(events_[next_event_]));
+    return;
+  }
+  // The timer fires once more after the last event, to finish the replay.
+  if (!settling_) {
+    settling_ = true;
+    ScheduleAt(elapsed + kSettleTime);
+    return;
+  }
+  if (on_finished_) {
+    std::function<void()> on_finished = std::move(on_finished_);
+    on_finished_ = nullptr;
+    on_finished();
+  }
+}
+
+void InputTraceReplayer::Deliver(const InputTraceEvent& event) {
+  switch (event.message) {
+    case WM_SIZE:
+      ApplySize(window_, event.wparam, event.lparam);
+      return;
+    case WM_DPICHANGED: {
+      RECT rect = event.rect;
+      ::SendMessage(window_, WM_DPICHANGED, event.wparam,
+                    reinterpret_cast<LPARAM>(&rect));
+      return;
+    }
+    case WM_ACTIVATE:
+      ::SendMessage(window_, WM_ACTIVATE, event.wparam, 0);
+      return;
+  }
+  HWND target = event.for_view ? ::GetWindow(window_, GW_CHILD) : window_;
+  if (target) {
+    ::PostMessage(target, event.message, event.wparam, event.lparam);
+  }
+}
+
+void InputTraceReplayer::ScheduleAt(std::chrono::nanoseconds time) {
+  std::chrono::nanoseconds delay =
+      time - (std::chrono::steady_clock::now() - start_time_);
+  // Negative due times are relative, in 100ns units.
+  LARGE_INTEGER due_time;
+  due_time.QuadPart = -std::max<LONGLONG>(1, delay.count() / 100);
+  ::SetWaitableTimer(timer_, &due_time, 0, nullptr, nullptr, FALSE);
+}
@@ -0,0 +1,119 @@
+#ifndef INPUT_TRACE_H_
+#define INPUT_TRACE_H_
+
+#include <windows.h>
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "run_loop.h"
+
+// A native message recorded by InputTraceRecorder.
+struct InputTraceEvent {
+  // When the message was received, relative to the start of recording.
+  std::chrono::microseconds time;
+  // True if the message was for the Flutter view, rather than the top-level
+  // window.
+  bool for_view;
+  UINT message;
+  WPARAM wparam;
+  LPARAM lparam;
+  // For WM_DPICHANGED, the suggested window rectangle that lparam pointed to.
+  RECT rect;
+};
+
+// Records the native input reaching a window, so that a session can be
+// replayed by InputTraceReplayer, e.g., to turn a jank report into a
+// repeatable benchmark.
+//
+// Mouse and keyboard input is recorded as the run loop takes it from the
+// queue (see RunLoop::SetMessageObserver); size, DPI and activation changes
+// are recorded as the top-level window receives them (see
+// Win32Window::SetMessageObserver). Touch and pen input arrives as WM_POINTER
+// messages, which can't be synthesized, so it isn't recorded.
+//
+// Traces are text, with one event per line:
+//
+//   <microseconds> <window|view> <message> <wparam> <lparam> [<rect>]
+class InputTraceRecorder {
+ public:
+  // Records messages for |window| and its children, to be written to
+  // |output_path| by WriteOutput. Times are relative to construction.
+  InputTraceRecorder(HWND window, const std::wstring& output_path);
+
+  // Prevent copying
+  InputTraceRecorder(InputTraceRecorder const&) = delete;
+  InputTraceRecorder& operator=(InputTraceRecorder const&) = delete;
+
+  // Records |message| if it's input for the window or its children.
+  void RecordQueuedMessage(const MSG& message);
+
+  // Records a message received by the top-level window if it's a size, DPI or
+  // activation change.
+  void RecordWindowMessage(UINT message, WPARAM wparam, LPARAM lparam);
+
+  // Writes the recorded events. Returns false if the file can't be written.
+  bool WriteOutput() const;
+
+ private:
+  HWND window_;
+  std::wstring output_path_;
+  std::chrono::steady_clock::time_point start_time_;
+  std::vector<InputTraceEvent> events_;
+};
+
+// Replays a trace written by InputTraceRecorder to a window, with the same
+// timing relative to when the replay starts. Replayed input is posted to the
+// window or its Flutter view, so it takes the same path through the run loop
+// as real input, and size changes resize the window.
+//
+// The replay is only as faithful as the conditions allow: sizes are replayed
+// in physical pixels, a DPI change resizes the window but can't change the
+// monitor's DPI, and keyboard input doesn't change the keyboard state seen by
+// GetKeyState. Real input, and the mouse leaving the window, still reach the
+// app during a replay.
+class InputTraceReplayer {
+ public:
+  // Replays to |window|, scheduling events on |run_loop|.
+  InputTraceReplayer(RunLoop* run_loop, HWND window);
+  ~InputTraceReplayer();
+
+  // Prevent copying
+  InputTraceReplayer(InputTraceReplayer const&) = delete;
+  InputTraceReplayer& operator=(InputTraceReplayer const&) = delete;
+
+  // Reads the trace at |path|. Returns false, after reporting the problem on
+  // stderr, if it can't be read or parsed.
+  bool Load(const std::wstring& path);
+
+  // Starts replaying the loaded trace at |speed| times its recorded speed.
+  // |on_finished| is called on the run loop thread a second after the last
+  // event, to give the app time to finish the frames it caused. Returns false
+  // if the replay can't be scheduled, or has already been started.
+  bool Start(double speed, std::function<void()> on_finished);
+
+ private:
+  // Delivers every event that is due, and schedules the next.
+  void DeliverDueEvents();
+
+  // Delivers |event| to the window or view.
+  void Deliver(const InputTraceEvent& event);
+
+  // Arms the timer for |time| after the start of the replay.
+  void ScheduleAt(std::chrono::nanoseconds time);
+
+  RunLoop* run_loop_;
+  HWND window_;
+  HANDLE timer_ = nullptr;
+  std::vector<InputTraceEvent> events_;
+  size_t next_event_ = 0;
+  // True once every event has been delivered, while waiting for kSettleTime.
+  bool settling_ = false;
+  double speed_ = 1.0;
+  std::chrono::steady_clock::time_point start_time_;
+  std::function<void()> on_finished_;
+};
+
+#endif  // INPUT_TRACE_H_
@@ -2,32 +2,147 @@
 #include <flutter/flutter_view_controller.h>
 #include <windows.h>
 
+#include <iostream>
+#include <memory>
+
 #include "flutter_window.h"
+#include "gpu_preference.h"
+#include "input_trace.h"
+#include "project_prefetcher.h"
+#include "renderer_detection.h"
 #include "run_loop.h"
-#include "window_configuration.h"
+#include "runner_configuration.h"
+#include "runner_diagnostics.h"
+#include "runner_metrics.h"
+#include "startup_trace.h"
+#include "thread_scheduling.h"
 
 int APIENTRY wWinMain(_In_ HINSTANCE instance,
                       _In_opt_ HINSTANCE prev,
                       _In_ wchar_t* command_line,
                       _In_ int show_command) {
+  StartupTrace* startup_trace = StartupTrace::GetInstance();
+  startup_trace->EnableFromEnvironment();
+  auto startup_scope = std::make_unique<StartupTrace::Scope>("Startup");
+  RunnerMetrics* metrics = RunnerMetrics::GetInstance();
+  metrics->EnableOutputFromEnvironment();
+
   // Attach to console when present (e.g., 'flutter run') or create a
   // new console when running with a debugger.
   if (!::AttachConsole(ATTACH_PARENT_PROCESS) && ::IsDebuggerPresent()) {
     ::AllocConsole();
   }
 
+  // Window, GPU, thread scheduling and run loop settings, which can be changed
+  // per deployment with a configuration file.
+  RunnerConfiguration configuration = LoadRunnerConfiguration();
+
+  // The GPU preference must be applied before anything uses DXGI.
+  ApplyGpuPreference(configuration.gpu_preference);
+  AdapterDescription adapter;
+  if (GetDefaultAdapter(&adapter)) {
+    metrics->SetAdapter(adapter);
+  }
+  metrics->SetRenderer(GetActiveRendererName());
+
+  // Warm the file cache for the engine's startup files while the window is
+  // being set up.
+  const std::wstring data_directory = L"data";
+  ProjectPrefetcher prefetcher(data_directory);
+
   RunLoop run_loop;
+  ThreadScheduling thread_scheduling(configuration);
+
+  run_loop.SetInputCoalescingEnabled(configuration.input_coalescing);
+  if (configuration.high_resolution_timer &&
+      !run_loop.SetHighResolutionTimerEnabled(true)) {
+    std::cerr << "high_resolution_timer needs Windows 10 1803 or later, and "
+                 "is ignored"
+              << std::endl;
+  }
 
-  flutter::DartProject project(L"data");
+  flutter::DartProject project(data_directory);
   FlutterWindow window(&run_loop, project);
-  Win32Window::Point origin(kFlutterWindowOriginX, kFlutterWindowOriginY);
-  Win32Window::Size size(kFlutterWindowWidth, kFlutterWindowHeight);
-  if (!window.CreateAndShow(kFlutterWindowTitle, origin, size)) {
+  // Blocking work from plugins and runner code is run on the window's worker
+  // pool, rather than on the run loop thread.
+  window.SetWorkerThreadPriority(thread_scheduling.worker_thread_priority());
+  // Pointer input is switched on for the process, so this must come before
+  // the window is created.
+  if (configuration.pointer_history &&
+      !window.SetPointerHistoryEnabled(true)) {
+    std::cerr << "pointer_history needs Windows 8 or later, and is ignored"
+              << std::endl;
+  }
+  Win32Window::Point origin(configuration.window_origin_x,
+                            configuration.window_origin_y);
+  Win32Window::Size size(configuration.window_width,
+                         configuration.window_height);
+  if (!window.CreateAndShow(configuration.window_title, origin, size)) {
     return EXIT_FAILURE;
   }
   window.SetQuitOnClose(true);
+  if (configuration.frame_budget > 0) {
+    run_loop.SetFrameBudget(window.GetRefreshInterval(),
+                            configuration.frame_budget);
+  }
+
+  // Replaying a recorded input trace closes the window once the replay has
+  // finished, so RunnerMetrics' frame timings cover just the replay.
+  std::unique_ptr<InputTraceRecorder> input_recorder;
+  std::unique_ptr<InputTraceReplayer> input_replayer;
+  if (!configuration.input_replay_path.empty()) {
+    if (!configuration.input_record_path.empty()) {
+      std::cerr << "input_replay is set, so input_record is ignored"
+                << std::endl;
+    }
+    input_replayer =
+        std::make_unique<InputTraceReplayer>(&run_loop, window.GetHandle());
+    HWND handle = window.GetHandle();
+    if (!input_replayer->Load(configuration.input_replay_path) ||
+        !input_replayer->Start(configuration.input_replay_speed, [handle]() {
+          ::PostMessage(handle, WM_CLOSE, 0, 0);
+        })) {
+      return EXIT_FAILURE;
+    }
+  } else if (!configuration.input_record_path.empty()) {
+    input_recorder = std::make_unique<InputTraceRecorder>(
+        window.GetHandle(), configuration.input_record_path);
+    InputTraceRecorder* recorder = input_recorder.get();
+    window.SetMessageObserver(
+        [recorder](UINT message, WPARAM wparam, LPARAM lparam) {
+          recorder->RecordWindowMessage(message, wparam, lparam);
+        });
+  }
+
+  // Live counters and a trace of recent run loop activity, for diagnosing
+  // jank without a profiler (see runner_diagnostics.h).
+  std::unique_ptr<RunnerDiagnostics> diagnostics;
+  if (configuration.diagnostics) {
+    diagnostics = std::make_unique<RunnerDiagnostics>(&run_loop, metrics);
+  }
 
+  if (input_recorder || diagnostics) {
+    InputTraceRecorder* recorder = input_recorder.get();
+    RunnerDiagnostics* diagnostics_keys = diagnostics.get();
+    run_loop.SetMessageObserver(
+        [recorder, diagnostics_keys](const MSG& message) {
+          if (recorder) {
+            recorder->RecordQueuedMessage(message);
+          }
+          if (diagnostics_keys) {
+            diagnostics_keys->HandleQueuedMessage(message);
+          }
+        });
+  }
+
+  startup_scope = nullptr;
   run_loop.Run();
 
+  if (input_recorder && !input_recorder->WriteOutput()) {
+    std::cerr << "Unable to write input trace" << std::endl;
+  }
+  startup_trace->WriteOutput();
+  metrics->WriteOutput(run_loop.statistics());
+
   return EXIT_SUCCESS;
 }
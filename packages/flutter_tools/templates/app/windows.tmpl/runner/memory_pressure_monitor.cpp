@@ -0,0 +1,110 @@
+#include "memory_pressure_monitor.h"
+
+#include <psapi.h>
+
+namespace {
+
+// How long after asking the app to trim before measuring what was freed.
+// The framework releases images asynchronously, once the message has been
+// handled on the UI thread.
+constexpr DWORD kSettleTimeMs = 1000;
+
+// The minimum time between trims while memory stays low.
+constexpr DWORD kCooldownMs = 10000;
+
+// Returns the process's private (committed) bytes, or 0 if they can't be
+// read.
+uint64_t GetPrivateBytes() {
+  PROCESS_MEMORY_COUNTERS_EX counters = {};
+  if (!::GetProcessMemoryInfo(
+          ::GetCurrentProcess(),
+          reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters),
+          sizeof(counters))) {
+    return 0;
+  }
+  return counters.PrivateUsage;
+}
+
+}  // namespace
+
+MemoryPressureMonitor::MemoryPressureMonitor(RunLoop* run_loop,
+                                             LowMemoryCallback on_low_memory,
+                                             TrimmedCallback on_trimmed)
+    : run_loop_(run_loop),
+      on_low_memory_(std::move(on_low_memory)),
+      on_trimmed_(std::move(on_trimmed)) {}
+
+MemoryPressureMonitor::~MemoryPressureMonitor() {
+  if (watching_) {
+    run_loop_->RemoveWaitHandle(low_memory_notification_);
+  }
+  if (timer_) {
+    run_loop_->RemoveWaitHandle(timer_);
+    ::CloseHandle(timer_);
+  }
+  if (low_memory_notification_) {
+    ::CloseHandle(low_memory_notification_);
+  }
+}
+
+bool MemoryPressureMonitor::Start() {
+  if (low_memory_notification_) {
+    return true;
+  }
+  low_memory_notification_ =
+      ::CreateMemoryResourceNotification(LowMemoryResourceNotification);
+  timer_ = ::CreateWaitableTimer(nullptr, FALSE, nullptr);
+  if (!low_memory_notification_ || !timer_ ||
+      !run_loop_->AddWaitHandle(timer_, [this]() { OnTimer(); })) {
+    if (timer_) {
+      ::CloseHandle(timer_);
+      timer_ = nullptr;
+    }
+    if (low_memory_notification_) {
+      ::CloseHandle(low_memory_notification_);
+      low_memory_notification_ = nullptr;
+    }
+    return false;
+  }
+  watching_ = run_loop_->AddWaitHandle(low_memory_notification_,
+                                       [this]() { OnLowMemory(); });
+  return watching_;
+}
+
+void MemoryPressureMonitor::OnLowMemory() {
+  run_loop_->RemoveWaitHandle(low_memory_notification_);
+  watching_ = false;
+  private_bytes_before_trim_ = GetPrivateBytes();
+  on_low_memory_();
+  timer_state_ = TimerState::kSettling;
+  ArmTimer(kSettleTimeMs);
+}
+
+void MemoryPressureMonitor::OnTimer() {
+  switch (timer_state_) {
+    case TimerState::kSettling: {
+      uint64_t private_bytes = GetPrivateBytes();
+      if (private_bytes_before_trim_ > 0 && private_bytes > 0) {
+        on_trimmed_(static_cast<int64_t>(private_bytes_before_trim_) -
+                    static_cast<int64_t>(private_bytes));
+      }
+      timer_state_ = TimerState::kCoolingDown;
+      ArmTimer(kCooldownMs - kSettleTimeMs);
+      break;
+    }
+    case TimerState::kCoolingDown:
+      timer_state_ = TimerState::kIdle;
+      watching_ = run_loop_->AddWaitHandle(low_memory_notification_,
+                                           [this]() { OnLowMemory(); });
+      break;
+    case TimerState::kIdle:
+      break;
+  }
+}
+
+void MemoryPressureMonitor::ArmTimer(DWORD delay_ms) {
+  // Negative due times are relative, in 100ns units.
+  LARGE_INTEGER due_time;
+  due_time.QuadPart = -static_cast<LONGLONG>(delay_ms) * 10000;
+  ::SetWaitableTimer(timer_, &due_time, 0, nullptr, nullptr, FALSE);
+}
@@ -0,0 +1,72 @@
+#ifndef MEMORY_PRESSURE_MONITOR_H_
+#define MEMORY_PRESSURE_MONITOR_H_
+
+#include <windows.h>
+
+#include <cstdint>
+#include <functional>
+
+#include "run_loop.h"
+
+// Watches for the system running low on physical memory, using a
+// LowMemoryResourceNotification, and asks the app to release memory.
+//
+// When memory runs low, |on_low_memory| is called on the run loop thread.
+// After a short settle time the process's private bytes are sampled again and
+// |on_trimmed| is called with how much was freed (negative if usage grew).
+// The notification stays signaled for as long as memory is low, so it isn't
+// waited on again until a cooldown has passed; the app is asked to trim at
+// most once per cooldown rather than on every run loop pass.
+class MemoryPressureMonitor {
+ public:
+  using LowMemoryCallback = std::function<void()>;
+  using TrimmedCallback = std::function<void(int64_t freed_bytes)>;
+
+  MemoryPressureMonitor(RunLoop* run_loop,
+                        LowMemoryCallback on_low_memory,
+                        TrimmedCallback on_trimmed);
+  ~MemoryPressureMonitor();
+
+  // Prevent copying
+  MemoryPressureMonitor(MemoryPressureMonitor const&) = delete;
+  MemoryPressureMonitor& operator=(MemoryPressureMonitor const&) = delete;
+
+  // Starts watching. Returns false if the notification can't be created or
+  // the run loop has no room for more wait handles.
+  bool Start();
+
+ private:
+  // What the timer is waiting for.
+  enum class TimerState {
+    kIdle,
+    // Waiting to measure how much memory the last trim freed.
+    kSettling,
+    // Waiting to watch the notification again.
+    kCoolingDown,
+  };
+
+  // Called when the low memory notification is signaled.
+  void OnLowMemory();
+
+  // Called when timer_ fires.
+  void OnTimer();
+
+  // Arms timer_ to fire after |delay_ms|.
+  void ArmTimer(DWORD delay_ms);
+
+  RunLoop* run_loop_;
+  LowMemoryCallback on_low_memory_;
+  TrimmedCallback on_trimmed_;
+
+  HANDLE low_memory_notification_ = nullptr;
+  HANDLE timer_ = nullptr;
+  TimerState timer_state_ = TimerState::kIdle;
+
+  // Whether low_memory_notification_ is currently in the run loop's wait set.
+  bool watching_ = false;
+
+  // The private bytes sampled when the last trim was requested.
+  uint64_t private_bytes_before_trim_ = 0;
+};
+
+#endif  // MEMORY_PRESSURE_MONITOR_H_
@@ -0,0 +1,68 @@
+#ifndef MPSC_QUEUE_H_
+#define MPSC_QUEUE_H_
+
+#include <atomic>
+#include <utility>
+
+// An unbounded, lock-free, multiple-producer single-consumer queue.
+//
+// Push may be called from any thread, while TryPop must only ever be called
+// from a single consumer thread. Based on Dmitry Vyukov's non-intrusive MPSC
+// node-based queue: producers only ever contend on a single atomic exchange,
+// and the consumer never blocks producers.
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() : head_(new Node()), tail_(head_.load()) {}
+
+  ~MpscQueue() {
+    while (tail_) {
+      Node* next = tail_->next.load(std::memory_order_relaxed);
+      delete tail_;
+      tail_ = next;
+    }
+  }
+
+  // Prevent copying
+  MpscQueue(MpscQueue const&) = delete;
+  MpscQueue& operator=(MpscQueue const&) = delete;
+
+  // Adds |value| to the back of the queue.
+  void Push(T value) {
+    Node* node = new Node();
+    node->value = std::move(value);
+    Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+    // Until this store, the consumer sees the queue as ending at |previous|.
+    previous->next.store(node, std::memory_order_release);
+  }
+
+  // Removes the value at the front of the queue into |value|. Returns false if
+  // the queue is empty, or if the only pending Push hasn't completed yet.
+  bool TryPop(T* value) {
+    Node* next = tail_->next.load(std::memory_order_acquire);
+    if (!next) {
+      return false;
+    }
+    // |next| becomes the new stub node, so its value is moved out rather than
+    // the node being freed.
+    *value = std::move(next->value);
+    delete tail_;
+    tail_ = next;
+    return true;
+  }
+
+ private:
+  struct Node {
+    std::atomic<Node*> next{nullptr};
+    T value;
+  };
+
+  // The most recently pushed node. Written by producers.
+  std::atomic<Node*> head_;
+
+  // The stub node preceding the front of the queue. Only accessed by the
+  // consumer.
+  Node* tail_;
+};
+
+#endif  // MPSC_QUEUE_H_
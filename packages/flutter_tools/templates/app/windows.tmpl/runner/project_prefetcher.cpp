@@ -0,0 +1,73 @@
+#include "project_prefetcher.h"
+
+#include <windows.h>
+
+#include <memory>
+
+#include "utils.h"
+
+namespace {
+
+// The size of each read when prefetching.
+constexpr DWORD kReadChunkSize = 1 << 20;
+
+// Files read by the engine at startup, relative to the data directory. Not
+// all of them exist in every build mode (e.g., app.so is only present in AOT
+// builds, and kernel_blob.bin only in JIT builds); missing files are skipped.
+constexpr const wchar_t* kStartupFiles[] = {
+    L"icudtl.dat",
+    L"app.so",
+    L"flutter_assets\\kernel_blob.bin",
+    L"flutter_assets\\vm_snapshot_data",
+    L"flutter_assets\\isolate_snapshot_data",
+    L"flutter_assets\\AssetManifest.json",
+    L"flutter_assets\\FontManifest.json",
+};
+
+}  // namespace
+
+ProjectPrefetcher::ProjectPrefetcher(const std::wstring& data_directory) {
+  std::wstring base_directory = data_directory;
+  bool is_absolute = data_directory.size() > 1 &&
+                     (data_directory[1] == L':' || data_directory[0] == L'\\');
+  if (!is_absolute) {
+    base_directory = GetExecutableDirectory() + data_directory;
+  }
+  std::vector<std::wstring> paths;
+  for (const wchar_t* file : kStartupFiles) {
+    paths.push_back(base_directory + L"\\" + file);
+  }
+  thread_ = std::thread(&ProjectPrefetcher::Prefetch, this, std::move(paths));
+}
+
+ProjectPrefetcher::~ProjectPrefetcher() {
+  cancelled_ = true;
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void ProjectPrefetcher::Prefetch(std::vector<std::wstring> paths) {
+  for (const std::wstring& path : paths) {
+    if (cancelled_) {
+      break;
+    }
+    PrefetchFile(path);
+  }
+}
+
+void ProjectPrefetcher::PrefetchFile(const std::wstring& path) {
+  HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return;
+  }
+  auto buffer = std::make_unique<char[]>(kReadChunkSize);
+  DWORD bytes_read = 0;
+  while (!cancelled_ &&
+         ::ReadFile(file, buffer.get(), kReadChunkSize, &bytes_read, nullptr) &&
+         bytes_read > 0) {
+  }
+  ::CloseHandle(file);
+}
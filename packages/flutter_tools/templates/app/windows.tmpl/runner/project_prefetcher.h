@@ -0,0 +1,39 @@
+#ifndef PROJECT_PREFETCHER_H_
+#define PROJECT_PREFETCHER_H_
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Reads the files the engine loads at startup (ICU data, snapshots, etc.) on
+// a background thread, so that they are in the OS file cache by the time the
+// engine opens them. Starting this before window setup overlaps the disk I/O
+// with native window creation, which matters most on slow disks.
+class ProjectPrefetcher {
+ public:
+  // Starts prefetching the engine's startup files from |data_directory|,
+  // which is resolved relative to the executable if it isn't absolute, in the
+  // same way as flutter::DartProject.
+  explicit ProjectPrefetcher(const std::wstring& data_directory);
+
+  // Stops prefetching (if still in progress) and waits for the background
+  // thread to exit.
+  ~ProjectPrefetcher();
+
+  // Prevent copying
+  ProjectPrefetcher(ProjectPrefetcher const&) = delete;
+  ProjectPrefetcher& operator=(ProjectPrefetcher const&) = delete;
+
+ private:
+  // Reads each of |paths| in turn, stopping early if cancelled_ is set.
+  void Prefetch(std::vector<std::wstring> paths);
+
+  // Reads the contents of the file at |path|, discarding the data.
+  void PrefetchFile(const std::wstring& path);
+
+  std::atomic<bool> cancelled_{false};
+  std::thread thread_;
+};
+
+#endif  // PROJECT_PREFETCHER_H_
@@ -0,0 +1,58 @@
+#include "recent_trace.h"
+
+#include <cstdio>
+
+namespace {
+
+// Returns |duration| in microseconds, the Chrome trace format's time unit.
+double ToMicroseconds(std::chrono::nanoseconds duration) {
+  return static_cast<double>(duration.count()) / 1000.0;
+}
+
+}  // namespace
+
+RecentTrace::RecentTrace(size_t capacity)
+    : events_(capacity > 0 ? capacity : 1),
+      thread_id_(::GetCurrentThreadId()) {}
+
+void RecentTrace::AddEvent(const char* name,
+                           TimePoint start,
+                           TimePoint end,
+                           int64_t argument) {
+  events_[next_event_] = {name, start, end, argument};
+  if (++next_event_ == events_.size()) {
+    next_event_ = 0;
+    full_ = true;
+  }
+}
+
+bool RecentTrace::WriteOutput(const std::wstring& path) const {
+  FILE* file = nullptr;
+  if (_wfopen_s(&file, path.c_str(), L"w") != 0 || !file) {
+    return false;
+  }
+  size_t count = full_ ? events_.size() : next_event_;
+  size_t first = full_ ? next_event_ : 0;
+  // Timestamps are only meaningful relative to each other, so make them
+  // relative to the oldest event.
+  TimePoint origin = count > 0 ? events_[first].start : TimePoint();
+  DWORD process_id = ::GetCurrentProcessId();
+  fprintf(file, "{\"traceEvents\":[\n");
+  for (size_t i = 0; i < count; ++i) {
+    const Event& event = events_[(first + i) % events_.size()];
+    fprintf(file,
+            "  {\"name\":\"%s\",\"cat\":\"runner\",\"ph\":\"X\","
+            "\"ts\":%.3f,\"dur\":%.3f,\"pid\":%lu,\"tid\":%lu",
+            event.name, ToMicroseconds(event.start - origin),
+            ToMicroseconds(event.end - event.start), process_id, thread_id_);
+    if (event.argument != 0) {
+      fprintf(file, ",\"args\":{\"value\":%lld}",
+              static_cast<long long>(event.argument));
+    }
+    fprintf(file, "}%s\n", i + 1 < count ? "," : "");
+  }
+  fprintf(file, "]}\n");
+  bool success = ferror(file) == 0;
+  fclose(file);
+  return success;
+}
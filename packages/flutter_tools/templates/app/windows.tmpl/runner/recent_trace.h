@@ -0,0 +1,59 @@
+#ifndef RECENT_TRACE_H_
+#define RECENT_TRACE_H_
+
+#include <windows.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Keeps the most recent run loop events in a fixed-size ring, so that the
+// last few seconds before a hitch can be written out on demand in the Chrome
+// trace event format, for viewing in chrome://tracing or
+// https://ui.perfetto.dev.
+//
+// Events are recorded with timestamps the run loop takes anyway, and
+// recording never allocates, so it's cheap enough to leave on.
+class RecentTrace {
+ public:
+  using TimePoint = std::chrono::steady_clock::time_point;
+
+  // Keeps up to |capacity| events, recorded on the calling thread.
+  explicit RecentTrace(size_t capacity);
+
+  // Prevent copying
+  RecentTrace(RecentTrace const&) = delete;
+  RecentTrace& operator=(RecentTrace const&) = delete;
+
+  // Records an event from |start| to |end|, replacing the oldest event once
+  // the trace is full. |name| must be a string literal, or otherwise outlive
+  // the trace. A nonzero |argument| (e.g., a message ID) is shown with the
+  // event.
+  void AddEvent(const char* name,
+                TimePoint start,
+                TimePoint end,
+                int64_t argument = 0);
+
+  // Writes the recorded events, oldest first, to |path|. Returns false if the
+  // file can't be written.
+  bool WriteOutput(const std::wstring& path) const;
+
+ private:
+  struct Event {
+    const char* name;
+    TimePoint start;
+    TimePoint end;
+    int64_t argument;
+  };
+
+  std::vector<Event> events_;
+  // Where the next event is recorded, which is the oldest event once the
+  // trace is full.
+  size_t next_event_ = 0;
+  bool full_ = false;
+  DWORD thread_id_;
+};
+
+#endif  // RECENT_TRACE_H_
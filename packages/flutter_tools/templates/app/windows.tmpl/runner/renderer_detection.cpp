@@ -0,0 +1,51 @@
+#include "renderer_detection.h"
+
+#include <dxgi.h>
+#include <windows.h>
+
+#include "utils.h"
+
+namespace {
+
+// The PCI IDs of the Microsoft Basic Render Driver.
+constexpr UINT kMicrosoftVendorId = 0x1414;
+constexpr UINT kBasicRenderDriverDeviceId = 0x8c;
+
+}  // namespace
+
+bool GetDefaultAdapter(AdapterDescription* description) {
+  IDXGIFactory1* factory = nullptr;
+  if (FAILED(::CreateDXGIFactory1(__uuidof(IDXGIFactory1),
+                                  reinterpret_cast<void**>(&factory)))) {
+    return false;
+  }
+  IDXGIAdapter1* adapter = nullptr;
+  bool found = false;
+  // Direct3D 11 uses the first adapter by default.
+  if (SUCCEEDED(factory->EnumAdapters1(0, &adapter))) {
+    DXGI_ADAPTER_DESC1 adapter_description;
+    if (SUCCEEDED(adapter->GetDesc1(&adapter_description))) {
+      found = true;
+      description->name = Utf8FromUtf16(adapter_description.Description);
+      description->vendor_id = adapter_description.VendorId;
+      description->device_id = adapter_description.DeviceId;
+      description->dedicated_video_memory =
+          adapter_description.DedicatedVideoMemory;
+      description->software =
+          (adapter_description.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) ||
+          (adapter_description.VendorId == kMicrosoftVendorId &&
+           adapter_description.DeviceId == kBasicRenderDriverDeviceId);
+    }
+    adapter->Release();
+  }
+  factory->Release();
+  return found;
+}
+
+std::string GetActiveRendererName() {
+  AdapterDescription description;
+  if (!GetDefaultAdapter(&description) || description.software) {
+    return "software";
+  }
+  return "gpu";
+}
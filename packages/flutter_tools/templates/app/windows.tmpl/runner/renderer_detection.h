@@ -0,0 +1,36 @@
+#ifndef RENDERER_DETECTION_H_
+#define RENDERER_DETECTION_H_
+
+#include <cstdint>
+#include <string>
+
+// The adapter that Direct3D 11 uses by default.
+struct AdapterDescription {
+  // The driver's name for the adapter, in UTF-8.
+  std::string name;
+  unsigned int vendor_id = 0;
+  unsigned int device_id = 0;
+  uint64_t dedicated_video_memory = 0;
+  // Whether the adapter rasterizes on the CPU.
+  bool software = true;
+};
+
+// Describes the default adapter in |description|, returning false if there
+// isn't one.
+//
+// On machines with more than one GPU this is the adapter chosen by the GPU
+// preference (see gpu_preference.h).
+bool GetDefaultAdapter(AdapterDescription* description);
+
+// Returns 'software' if the engine will rasterize on the CPU, or 'gpu'
+// otherwise.
+//
+// The Windows embedding renders through ANGLE on Direct3D 11, using the
+// default adapter. On machines without a usable GPU, such as many VDI and
+// remote desktop sessions, the default adapter is the Microsoft Basic Render
+// Driver, which is backed by WARP: a multithreaded software rasterizer. The
+// embedding picks its ANGLE device itself, so the runner can report which
+// case applies but can't choose between them.
+std::string GetActiveRendererName();
+
+#endif  // RENDERER_DETECTION_H_
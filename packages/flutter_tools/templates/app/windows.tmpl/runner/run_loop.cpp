@@ -7,64 +7,446 @@
 
 #include <algorithm>
 
-RunLoop::RunLoop() {}
+// Available in the Windows 10 1803 SDK and later.
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
 
-RunLoop::~RunLoop() {}
+namespace {
+
+// The maximum number of posted tasks to run per wakeup, so that tasks that
+// post more tasks can't starve window messages.
+constexpr size_t kMaxPostedTasksPerWakeup = 1024;
+
+// The longest a burst of coalesced input can delay servicing Flutter when
+// there is no frame budget, so that input that never stops can't starve it.
+constexpr std::chrono::milliseconds kMaxInputCoalescingDuration(4);
+
+// The minimum time between servicing a throttled Flutter instance's
+// scheduled work.
+constexpr std::chrono::milliseconds kThrottledServiceInterval(250);
+
+// Returns true if |message| is mouse or pointer input.
+bool IsPointerInputMessage(UINT message) {
+  return (message >= WM_MOUSEFIRST && message <= WM_MOUSELAST) ||
+         (message >= WM_POINTERUPDATE && message <= WM_POINTERUP);
+}
+
+// Returns true if |message| is mouse, pointer or keyboard input.
+bool IsInputMessage(UINT message) {
+  return IsPointerInputMessage(message) ||
+         (message >= WM_KEYFIRST && message <= WM_KEYLAST);
+}
+
+// Returns true if mouse or pointer input is waiting in the message queue.
+bool IsPointerInputPending() {
+  MSG message;
+  return ::PeekMessage(&message, nullptr, WM_MOUSEFIRST, WM_MOUSELAST,
+                       PM_NOREMOVE | PM_NOYIELD) ||
+         ::PeekMessage(&message, nullptr, WM_POINTERUPDATE, WM_POINTERUP,
+                       PM_NOREMOVE | PM_NOYIELD);
+}
+
+// Heap comparator that keeps the instance with the earliest event time at the
+// front of the heap.
+template <typename T>
+bool LaterEventTime(const T& a, const T& b) {
+  return a.next_event_time > b.next_event_time;
+}
+
+}  // namespace
+
+RunLoop::RunLoop() {
+  wake_event_ = ::CreateEvent(nullptr, FALSE, FALSE, nullptr);
+  if (wake_event_) {
+    // Flutter messages are always processed after a wait completes, so the
+    // only additional work is running posted tasks.
+    AddWaitHandle(wake_event_, [this]() { RunPostedTasks(); });
+  }
+}
+
+RunLoop::~RunLoop() {
+  SetHighResolutionTimerEnabled(false);
+  if (wake_event_) {
+    RemoveWaitHandle(wake_event_);
+    ::CloseHandle(wake_event_);
+  }
+}
 
 void RunLoop::Run() {
   bool keep_running = true;
   TimePoint next_flutter_event_time = TimePoint::clock::now();
   while (keep_running) {
-    std::chrono::nanoseconds wait_duration =
-        std::max(std::chrono::nanoseconds(0),
-                 next_flutter_event_time - TimePoint::clock::now());
-    ::MsgWaitForMultipleObjects(
-        0, nullptr, FALSE, static_cast<DWORD>(wait_duration.count() / 1000),
-        QS_ALLINPUT);
-    bool processed_events = false;
+    DWORD timeout = PrepareWait(next_flutter_event_time);
+    TimePoint wait_start = TimePoint::clock::now();
+    DWORD result = ::MsgWaitForMultipleObjects(
+        static_cast<DWORD>(wait_handles_.size()), wait_handles_.data(), FALSE,
+        timeout, QS_ALLINPUT);
+    TimePoint wait_end = TimePoint::clock::now();
+    statistics_.wait_durations.Record(wait_end - wait_start);
+    if (trace_) {
+      trace_->AddEvent("Wait", wait_start, wait_end);
+    }
+    if (result == WAIT_OBJECT_0 + wait_handles_.size()) {
+      ++statistics_.message_wakes;
+    } else if (result == WAIT_TIMEOUT) {
+      ++statistics_.timeout_wakes;
+    }
+    if (result >= WAIT_OBJECT_0 &&
+        result < WAIT_OBJECT_0 + wait_handles_.size()) {
+      HANDLE signaled = wait_handles_[result - WAIT_OBJECT_0];
+      if (signaled == high_resolution_timer_) {
+        ++statistics_.timeout_wakes;
+      } else {
+        ++statistics_.handle_wakes;
+      }
+      // Copy the callback, since it may add or remove wait handles.
+      std::function<void()> callback = wait_callbacks_[result - WAIT_OBJECT_0];
+      callback();
+      // The timer only fires for already-scheduled work, which is found by
+      // event time; anything else may have made any instance due.
+      if (signaled != high_resolution_timer_) {
+        MarkAllFlutterInstancesDue();
+      }
+    }
+
+    // Each pass recomputes the next event time from scratch; keeping the
+    // previous value would leave a deadline in the past that never expires,
+    // turning the wait into a busy loop.
+    next_flutter_event_time = TimePoint::max();
+    // Whether any Windows message has been dispatched since Flutter
+    // instances were last serviced.
+    bool flutter_pass_pending = true;
+    TimePoint native_slice_start = TimePoint::clock::now();
     MSG message;
     // All pending Windows messages must be processed; MsgWaitForMultipleObjects
     // won't return again for items left in the queue after PeekMessage.
     while (::PeekMessage(&message, nullptr, 0, 0, PM_REMOVE)) {
-      processed_events = true;
       if (message.message == WM_QUIT) {
         keep_running = false;
         break;
       }
+      if (message_observer_) {
+        message_observer_(message);
+      }
+      if (IsInputMessage(message.message)) {
+        // Unsigned, so that tick count wraparound is handled.
+        DWORD queue_delay = ::GetTickCount() - message.time;
+        statistics_.input_queue_delays.Record(
+            std::chrono::milliseconds(queue_delay));
+      }
+      TimePoint dispatch_start = TimePoint::clock::now();
       ::TranslateMessage(&message);
       ::DispatchMessage(&message);
+      TimePoint dispatch_end = TimePoint::clock::now();
+      statistics_.native_time += dispatch_end - dispatch_start;
+      statistics_.dispatch_durations.Record(dispatch_end - dispatch_start);
+      if (trace_) {
+        trace_->AddEvent("DispatchMessage", dispatch_start, dispatch_end,
+                         message.message);
+      }
+      ++statistics_.native_messages;
+      flutter_pass_pending = true;
+      // Thread messages (such as the engine's cross-thread task wakeups) could
+      // be for any instance; window messages only affect the instance whose
+      // view they were sent to.
+      if (message.hwnd == nullptr) {
+        MarkAllFlutterInstancesDue();
+      } else {
+        MarkFlutterInstanceDue(message.hwnd);
+      }
+      // Input that is immediately followed by more input is handled by the
+      // Flutter pass after the last message of the burst, or once the burst
+      // has used the frame budget's native share (or, without a frame budget,
+      // kMaxInputCoalescingDuration).
+      std::chrono::nanoseconds coalescing_limit = kMaxInputCoalescingDuration;
+      if (frame_interval_.count() > 0) {
+        coalescing_limit = native_budget_;
+      }
+      if (input_coalescing_enabled_ &&
+          IsPointerInputMessage(message.message) && IsPointerInputPending() &&
+          dispatch_end - native_slice_start < coalescing_limit) {
+        ++statistics_.input_messages_coalesced;
+        continue;
+      }
       // Allow Flutter to process messages each time a Windows message is
-      // processed, to prevent starvation.
+      // processed, to prevent starvation. In frame budget mode, Flutter is
+      // instead serviced once native messages have used their share of the
+      // frame.
+      if (frame_interval_.count() > 0 &&
+          dispatch_end - native_slice_start < native_budget_) {
+        continue;
+      }
+      if (frame_interval_.count() > 0) {
+        ++statistics_.native_budget_exhausted;
+      }
       next_flutter_event_time =
           std::min(next_flutter_event_time, ProcessFlutterMessages());
+      flutter_pass_pending = false;
+      native_slice_start = TimePoint::clock::now();
     }
-    // If the PeekMessage loop didn't run, process Flutter messages.
-    if (!processed_events) {
+    // Service Flutter if the PeekMessage loop didn't run, or if it dispatched
+    // messages that haven't been followed by a Flutter pass yet.
+    if (flutter_pass_pending) {
       next_flutter_event_time =
           std::min(next_flutter_event_time, ProcessFlutterMessages());
     }
   }
 }
 
+void RunLoop::SetFrameBudget(std::chrono::nanoseconds frame_interval,
+                             double native_fraction) {
+  if (frame_interval.count() <= 0) {
+    frame_interval_ = std::chrono::nanoseconds(0);
+    native_budget_ = std::chrono::nanoseconds(0);
+    return;
+  }
+  native_fraction = std::min(1.0, std::max(0.0, native_fraction));
+  frame_interval_ = frame_interval;
+  native_budget_ = std::chrono::nanoseconds(
+      static_cast<int64_t>(frame_interval.count() * native_fraction));
+}
+
+void RunLoop::SetInputCoalescingEnabled(bool enabled) {
+  input_coalescing_enabled_ = enabled;
+}
+
+void RunLoop::SetMessageObserver(std::function<void(const MSG&)> observer) {
+  message_observer_ = std::move(observer);
+}
+
+void RunLoop::SetTrace(RecentTrace* trace) {
+  trace_ = trace;
+}
+
+bool RunLoop::SetHighResolutionTimerEnabled(bool enabled) {
+  if (!enabled) {
+    if (high_resolution_timer_) {
+      RemoveWaitHandle(high_resolution_timer_);
+      ::CloseHandle(high_resolution_timer_);
+      high_resolution_timer_ = nullptr;
+    }
+    return true;
+  }
+  if (high_resolution_timer_) {
+    return true;
+  }
+  // High resolution timers are only supported on Windows 10 1803 and later;
+  // on earlier versions creation fails and the millisecond wait timeout is
+  // used instead.
+  high_resolution_timer_ = ::CreateWaitableTimerExW(
+      nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+      TIMER_ALL_ACCESS);
+  if (!high_resolution_timer_) {
+    return false;
+  }
+  if (!AddWaitHandle(high_resolution_timer_, []() {})) {
+    ::CloseHandle(high_resolution_timer_);
+    high_resolution_timer_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
 void RunLoop::RegisterFlutterInstance(
     flutter::FlutterViewController* flutter_instance) {
-  flutter_instances_.insert(flutter_instance);
+  // New instances are due immediately, so their startup work runs on the
+  // next pass.
+  flutter_instances_.push_back({TimePoint::min(), flutter_instance,
+                                flutter_instance->view()->GetNativeWindow(),
+                                false});
+  std::push_heap(flutter_instances_.begin(), flutter_instances_.end(),
+                 LaterEventTime<ScheduledFlutterInstance>);
 }
 
 void RunLoop::UnregisterFlutterInstance(
     flutter::FlutterViewController* flutter_instance) {
-  flutter_instances_.erase(flutter_instance);
+  auto matches = [flutter_instance](const ScheduledFlutterInstance& entry) {
+    return entry.flutter_instance == flutter_instance;
+  };
+  flutter_instances_.erase(std::remove_if(flutter_instances_.begin(),
+                                          flutter_instances_.end(), matches),
+                           flutter_instances_.end());
+  std::make_heap(flutter_instances_.begin(), flutter_instances_.end(),
+                 LaterEventTime<ScheduledFlutterInstance>);
+  // The instance may be unregistered by a task run while servicing instances,
+  // in which case it must not be returned to the heap. Entries are cleared
+  // rather than erased since ProcessFlutterMessages is iterating over them.
+  for (auto& entry : servicing_instances_) {
+    if (matches(entry)) {
+      entry.flutter_instance = nullptr;
+    }
+  }
+}
+
+void RunLoop::SetFlutterInstanceThrottled(
+    flutter::FlutterViewController* flutter_instance,
+    bool throttled) {
+  // Only affects how the next event time is computed, so no reordering is
+  // needed.
+  for (auto& entry : flutter_instances_) {
+    if (entry.flutter_instance == flutter_instance) {
+      entry.throttled = throttled;
+    }
+  }
+  for (auto& entry : servicing_instances_) {
+    if (entry.flutter_instance == flutter_instance) {
+      entry.throttled = throttled;
+    }
+  }
+}
+
+bool RunLoop::AddWaitHandle(HANDLE handle, std::function<void()> callback) {
+  // MsgWaitForMultipleObjects reserves one slot for the message queue.
+  if (wait_handles_.size() >= MAXIMUM_WAIT_OBJECTS - 1) {
+    return false;
+  }
+  wait_handles_.push_back(handle);
+  wait_callbacks_.push_back(std::move(callback));
+  return true;
+}
+
+void RunLoop::RemoveWaitHandle(HANDLE handle) {
+  auto it = std::find(wait_handles_.begin(), wait_handles_.end(), handle);
+  if (it == wait_handles_.end()) {
+    return;
+  }
+  wait_callbacks_.erase(wait_callbacks_.begin() +
+                        (it - wait_handles_.begin()));
+  wait_handles_.erase(it);
+}
+
+void RunLoop::Wake() {
+  if (wake_event_) {
+    ::SetEvent(wake_event_);
+  }
+}
+
+void RunLoop::PostTask(std::function<void()> task) {
+  posted_tasks_.Push(std::move(task));
+  // Only one wakeup is needed for any number of tasks posted before the run
+  // loop gets to them.
+  if (!posted_task_wake_pending_.exchange(true, std::memory_order_acq_rel)) {
+    Wake();
+  }
+}
+
+void RunLoop::RunPostedTasks() {
+  // Cleared before draining, so that a task posted after the queue is found
+  // empty signals a new wakeup.
+  posted_task_wake_pending_.store(false, std::memory_order_release);
+  std::function<void()> task;
+  for (size_t i = 0; i < kMaxPostedTasksPerWakeup; ++i) {
+    if (!posted_tasks_.TryPop(&task)) {
+      return;
+    }
+    task();
+  }
+  // Yield to window messages, and come back for the rest.
+  Wake();
 }
 
 RunLoop::TimePoint RunLoop::ProcessFlutterMessages() {
-  TimePoint next_event_time = TimePoint::max();
-  for (auto flutter_controller : flutter_instances_) {
+  const TimePoint now = TimePoint::clock::now();
+  ++statistics_.flutter_passes;
+  // Pull all due instances off the heap before servicing any of them, so that
+  // an instance that is immediately due again isn't serviced twice.
+  while (!flutter_instances_.empty() &&
+         flutter_instances_.front().next_event_time <= now) {
+    std::pop_heap(flutter_instances_.begin(), flutter_instances_.end(),
+                  LaterEventTime<ScheduledFlutterInstance>);
+    servicing_instances_.push_back(flutter_instances_.back());
+    flutter_instances_.pop_back();
+  }
+
+  for (auto& entry : servicing_instances_) {
+    if (!entry.flutter_instance) {
+      continue;
+    }
     std::chrono::nanoseconds wait_duration =
-        flutter_controller->ProcessMessages();
-    if (wait_duration != std::chrono::nanoseconds::max()) {
-      next_event_time =
-          std::min(next_event_time, TimePoint::clock::now() + wait_duration);
+        entry.flutter_instance->ProcessMessages();
+    if (wait_duration == std::chrono::nanoseconds::max()) {
+      entry.next_event_time = TimePoint::max();
+      continue;
+    }
+    if (entry.throttled) {
+      wait_duration = std::max<std::chrono::nanoseconds>(
+          wait_duration, kThrottledServiceInterval);
+    }
+    entry.next_event_time = TimePoint::clock::now() + wait_duration;
+  }
+
+  for (const auto& entry : servicing_instances_) {
+    if (!entry.flutter_instance) {
+      continue;
+    }
+    flutter_instances_.push_back(entry);
+    std::push_heap(flutter_instances_.begin(), flutter_instances_.end(),
+                   LaterEventTime<ScheduledFlutterInstance>);
+  }
+  servicing_instances_.clear();
+
+  TimePoint end = TimePoint::clock::now();
+  std::chrono::nanoseconds flutter_time = end - now;
+  statistics_.flutter_time += flutter_time;
+  statistics_.flutter_pass_durations.Record(flutter_time);
+  if (trace_) {
+    trace_->AddEvent("ProcessMessages", now, end);
+  }
+  if (frame_interval_.count() > 0 &&
+      flutter_time > frame_interval_ - native_budget_) {
+    ++statistics_.flutter_budget_exceeded;
+  }
+
+  if (flutter_instances_.empty()) {
+    return TimePoint::max();
+  }
+  return flutter_instances_.front().next_event_time;
+}
+
+void RunLoop::MarkAllFlutterInstancesDue() {
+  // Every entry having the same time trivially satisfies the heap property.
+  for (auto& entry : flutter_instances_) {
+    entry.next_event_time = TimePoint::min();
+  }
+}
+
+void RunLoop::MarkFlutterInstanceDue(HWND window) {
+  for (auto& entry : flutter_instances_) {
+    if (entry.view_window == window || ::IsChild(entry.view_window, window)) {
+      entry.next_event_time = TimePoint::min();
+      std::make_heap(flutter_instances_.begin(), flutter_instances_.end(),
+                     LaterEventTime<ScheduledFlutterInstance>);
+      return;
+    }
+  }
+}
+
+DWORD RunLoop::PrepareWait(TimePoint next_event_time) {
+  // With nothing scheduled, sleep until a message arrives or a wait handle is
+  // signaled.
+  if (next_event_time == TimePoint::max()) {
+    return INFINITE;
+  }
+  const TimePoint now = TimePoint::clock::now();
+  if (next_event_time <= now) {
+    return 0;
+  }
+  std::chrono::nanoseconds wait_duration = next_event_time - now;
+  if (high_resolution_timer_) {
+    // Negative due times are relative, in 100ns units.
+    LARGE_INTEGER due_time;
+    due_time.QuadPart = -std::max<LONGLONG>(1, wait_duration.count() / 100);
+    if (::SetWaitableTimer(high_resolution_timer_, &due_time, 0, nullptr,
+                           nullptr, FALSE)) {
+      return INFINITE;
     }
   }
-  return next_event_time;
+  // Round up to whole milliseconds; rounding down wakes up before the event
+  // is due, and then spins on zero-timeout waits until it is.
+  constexpr std::chrono::nanoseconds::rep kNanosecondsPerMillisecond =
+      1000000;
+  return static_cast<DWORD>(
+      (wait_duration.count() + kNanosecondsPerMillisecond - 1) /
+      kNanosecondsPerMillisecond);
 }
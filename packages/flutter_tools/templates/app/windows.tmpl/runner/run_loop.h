@@ -2,14 +2,62 @@
 #define RUN_LOOP_H_
 
 #include <flutter/flutter_view_controller.h>
+#include <windows.h>
 
+#include <atomic>
 #include <chrono>
-#include <set>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "duration_histogram.h"
+#include "mpsc_queue.h"
+#include "recent_trace.h"
 
 // A runloop that will service events for Flutter instances as well
 // as native messages.
 class RunLoop {
  public:
+  // Counters and histograms describing how the run loop's time has been
+  // divided between waiting, native messages, and Flutter instances.
+  struct Statistics {
+    // Time spent in TranslateMessage/DispatchMessage.
+    std::chrono::nanoseconds native_time{0};
+    // Time spent servicing Flutter instances.
+    std::chrono::nanoseconds flutter_time{0};
+    // The number of Windows messages dispatched.
+    uint64_t native_messages = 0;
+    // The number of passes over the registered Flutter instances.
+    uint64_t flutter_passes = 0;
+    // In frame budget mode, the number of times native message dispatch was
+    // interrupted to service Flutter instances.
+    uint64_t native_budget_exhausted = 0;
+    // In frame budget mode, the number of Flutter passes that took longer than
+    // the Flutter share of the frame.
+    uint64_t flutter_budget_exceeded = 0;
+    // With input coalescing, the number of pointer input messages that were
+    // dispatched without a Flutter pass after them, because more input was
+    // queued.
+    uint64_t input_messages_coalesced = 0;
+    // The number of waits that ended because a Windows message arrived, a
+    // wait handle (including the one used by Wake and PostTask) was signaled,
+    // or scheduled Flutter work was due.
+    uint64_t message_wakes = 0;
+    uint64_t handle_wakes = 0;
+    uint64_t timeout_wakes = 0;
+    // The time spent blocked in each wait for messages or events.
+    DurationHistogram wait_durations;
+    // The time taken to dispatch each Windows message.
+    DurationHistogram dispatch_durations;
+    // The time taken by each pass over the Flutter instances.
+    DurationHistogram flutter_pass_durations;
+    // How long each mouse, pointer and keyboard message waited in the message
+    // queue before being dispatched, at the queue's millisecond resolution.
+    // There's no API for the depth of the queue, but this grows as it backs
+    // up.
+    DurationHistogram input_queue_delays;
+  };
+
   RunLoop();
   ~RunLoop();
 
@@ -28,13 +76,155 @@ class RunLoop {
   void UnregisterFlutterInstance(
       flutter::FlutterViewController* flutter_instance);
 
+  // Sets whether the given Flutter instance is throttled. Throttled instances
+  // have their scheduled work serviced at a reduced rate, for use when
+  // nothing they draw is visible. Messages sent to the instance's view, and
+  // wakeups from other threads, are still serviced immediately.
+  void SetFlutterInstanceThrottled(
+      flutter::FlutterViewController* flutter_instance,
+      bool throttled);
+
+  // Adds |handle| to the set of objects the run loop waits on. When |handle|
+  // is signaled, |callback| is called on the run loop thread, followed by a
+  // pass over the registered Flutter instances. The caller retains ownership
+  // of |handle|, and must remove it before closing it.
+  //
+  // At most MAXIMUM_WAIT_OBJECTS - 1 handles can be registered, including the
+  // run loop's own wake event. Returns false if the limit has been reached.
+  bool AddWaitHandle(HANDLE handle, std::function<void()> callback);
+
+  // Removes |handle| from the set of objects the run loop waits on.
+  void RemoveWaitHandle(HANDLE handle);
+
+  // Enables frame budget mode, which splits each |frame_interval| between
+  // native messages and Flutter instances. Pending Windows messages are
+  // dispatched until |native_fraction| of the interval has been used, then the
+  // Flutter instances are serviced before dispatching continues. Flutter
+  // instances are always serviced once the message queue is empty.
+  //
+  // Passing a zero |frame_interval| restores the default behavior of servicing
+  // Flutter instances after every Windows message.
+  void SetFrameBudget(std::chrono::nanoseconds frame_interval,
+                      double native_fraction);
+
+  // Enables or disables input coalescing. By default Flutter instances are
+  // serviced after every Windows message, so a high-rate mouse or pen tablet
+  // costs a Flutter pass per sample. With coalescing, mouse and pointer
+  // messages are dispatched back to back while more are queued, and
+  // Flutter is serviced once the burst has been dispatched. No input is
+  // dropped; the engine receives every sample, but handles them in one pass.
+  // A burst that doesn't end is cut off, and Flutter serviced, once it has
+  // used the frame budget's native share (see SetFrameBudget), or 4ms without
+  // a frame budget.
+  void SetInputCoalescingEnabled(bool enabled);
+
+  // Enables or disables waiting for Flutter events with a high resolution
+  // waitable timer rather than the wait timeout, which is limited to the
+  // system timer resolution (typically ~15.6ms). This gives accurate wakeups
+  // for engine tasks without raising the system-wide timer resolution.
+  //
+  // Returns false if a high resolution timer can't be created, which is the
+  // case on versions of Windows before Windows 10 1803.
+  bool SetHighResolutionTimerEnabled(bool enabled);
+
+  // Sets a function called with each Windows message the run loop takes from
+  // the queue, just before it's dispatched. Pass nullptr to remove it.
+  void SetMessageObserver(std::function<void(const MSG&)> observer);
+
+  // Sets a trace to record each wait, message dispatch and Flutter pass in.
+  // Pass nullptr to stop recording.
+  void SetTrace(RecentTrace* trace);
+
+  // Returns the counters accumulated since the run loop was created.
+  const Statistics& statistics() const { return statistics_; }
+
+  // Wakes the run loop so that registered Flutter instances are serviced
+  // immediately, rather than at their next scheduled event time.
+  //
+  // This may be called from any thread.
+  void Wake();
+
+  // Runs |task| on the run loop thread. Tasks run in the order they were
+  // posted from any given thread.
+  //
+  // This may be called from any thread. Unlike posting window messages, it
+  // doesn't lock and isn't subject to the Windows message queue limit.
+  void PostTask(std::function<void()> task);
+
  private:
   using TimePoint = std::chrono::steady_clock::time_point;
 
-  // Processes all currently pending messages for registered Flutter instances.
+  // A registered Flutter instance, and the time at which it next needs to be
+  // serviced.
+  struct ScheduledFlutterInstance {
+    TimePoint next_event_time;
+    flutter::FlutterViewController* flutter_instance;
+    // The instance's view window, used to map dispatched messages back to
+    // the instance they were for.
+    HWND view_window;
+    // Whether scheduled work is serviced at a reduced rate.
+    bool throttled;
+  };
+
+  // Processes all currently pending messages for the registered Flutter
+  // instances that are due, and returns the earliest time at which any
+  // instance next needs to be serviced.
   TimePoint ProcessFlutterMessages();
 
-  std::set<flutter::FlutterViewController*> flutter_instances_;
+  // Marks every registered Flutter instance as due, for events that can't be
+  // attributed to a specific instance (e.g., thread messages or wakeups).
+  void MarkAllFlutterInstancesDue();
+
+  // Marks the Flutter instance whose view is, or contains, |window| as due.
+  void MarkFlutterInstanceDue(HWND window);
+
+  // Runs tasks queued by PostTask.
+  void RunPostedTasks();
+
+  // Returns the MsgWaitForMultipleObjects timeout for waiting until
+  // |next_event_time|, arming the high resolution timer if it is enabled.
+  DWORD PrepareWait(TimePoint next_event_time);
+
+  // The registered Flutter instances, maintained as a min-heap on
+  // next_event_time so that only instances with due work are serviced.
+  std::vector<ScheduledFlutterInstance> flutter_instances_;
+
+  // The instances being serviced by the current ProcessFlutterMessages call,
+  // which are temporarily removed from flutter_instances_. Entries whose
+  // instance is unregistered during servicing have a null flutter_instance.
+  std::vector<ScheduledFlutterInstance> servicing_instances_;
+
+  // Auto-reset event used by Wake. Always the first entry in wait_handles_.
+  HANDLE wake_event_ = nullptr;
+
+  // Tasks queued by PostTask, and whether wake_event_ has been signaled for
+  // them since they were last run.
+  MpscQueue<std::function<void()>> posted_tasks_;
+  std::atomic<bool> posted_task_wake_pending_{false};
+
+  // The objects waited on by Run, and the callbacks to call when each is
+  // signaled. The two vectors are always the same length, since
+  // MsgWaitForMultipleObjects requires a contiguous array of handles.
+  std::vector<HANDLE> wait_handles_;
+  std::vector<std::function<void()>> wait_callbacks_;
+
+  // The high resolution timer, if enabled. Also present in wait_handles_.
+  HANDLE high_resolution_timer_ = nullptr;
+
+  // See SetInputCoalescingEnabled.
+  bool input_coalescing_enabled_ = false;
+
+  // See SetMessageObserver.
+  std::function<void(const MSG&)> message_observer_;
+
+  // See SetTrace.
+  RecentTrace* trace_ = nullptr;
+
+  // The frame budget configuration; a zero interval disables budgeting.
+  std::chrono::nanoseconds frame_interval_{0};
+  std::chrono::nanoseconds native_budget_{0};
+
+  Statistics statistics_;
 };
 
 #endif  // RUN_LOOP_H_
@@ -0,0 +1,231 @@
+#include "runner_configuration.h"
+
+#include <windows.h>
+
+#include <cerrno>
+#include <cfloat>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "utils.h"
+#include "window_configuration.h"
+
+namespace {
+
+constexpr const wchar_t kConfigurationFileVariable[] =
+    L"FLUTTER_RUNNER_CONFIG_FILE";
+
+constexpr const wchar_t kConfigurationFileName[] = L"runner.conf";
+
+// Returns |value| without leading and trailing whitespace.
+std::string Trim(const std::string& value) {
+  const char* whitespace = " \t\r";
+  size_t start = value.find_first_not_of(whitespace);
+  if (start == std::string::npos) {
+    return "";
+  }
+  size_t end = value.find_last_not_of(whitespace);
+  return value.substr(start, end - start + 1);
+}
+
+// Parses |value| as a non-negative window coordinate or size, returning false
+// if it isn't one. Sizes must also be non-zero.
+bool ParseUnsigned(const std::string& value,
+                   bool allow_zero,
+                   unsigned int* result) {
+  char* end = nullptr;
+  errno = 0;
+  unsigned long parsed = strtoul(value.c_str(), &end, 10);
+  if (value.empty() || *end != '\0' || errno != 0 ||
+      (parsed == 0 && !allow_zero) || parsed > INT_MAX || value[0] == '-') {
+    return false;
+  }
+  *result = static_cast<unsigned int>(parsed);
+  return true;
+}
+
+// Parses |value| as a positive, finite number, returning false if it isn't
+// one.
+bool ParsePositiveDouble(const std::string& value, double* result) {
+  char* end = nullptr;
+  errno = 0;
+  double parsed = strtod(value.c_str(), &end);
+  if (value.empty() || *end != '\0' || errno != 0 || !(parsed > 0) ||
+      parsed > DBL_MAX) {
+    return false;
+  }
+  *result = parsed;
+  return true;
+}
+
+// Parses |value| as 'true' or 'false', returning false if it is neither.
+bool ParseBool(const std::string& value, bool* result) {
+  if (value == "true") {
+    *result = true;
+  } else if (value == "false") {
+    *result = false;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Parses |value| as a GPU preference, returning false if it isn't one.
+bool ParseGpuPreference(const std::string& value,
+                        RunnerConfiguration::GpuPreference* result) {
+  if (value == "default") {
+    *result = RunnerConfiguration::GpuPreference::kDefault;
+  } else if (value == "power_saving") {
+    *result = RunnerConfiguration::GpuPreference::kPowerSaving;
+  } else if (value == "high_performance") {
+    *result = RunnerConfiguration::GpuPreference::kHighPerformance;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Parses |value| as a process priority, returning false if it isn't one.
+bool ParseProcessPriority(const std::string& value,
+                          RunnerConfiguration::ProcessPriority* result) {
+  if (value == "normal") {
+    *result = RunnerConfiguration::ProcessPriority::kNormal;
+  } else if (value == "above_normal") {
+    *result = RunnerConfiguration::ProcessPriority::kAboveNormal;
+  } else if (value == "high") {
+    *result = RunnerConfiguration::ProcessPriority::kHigh;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+RunnerConfiguration LoadRunnerConfiguration() {
+  RunnerConfiguration configuration;
+  configuration.window_title = kFlutterWindowTitle;
+  configuration.window_origin_x = kFlutterWindowOriginX;
+  configuration.window_origin_y = kFlutterWindowOriginY;
+  configuration.window_width = kFlutterWindowWidth;
+  configuration.window_height = kFlutterWindowHeight;
+  configuration.gpu_preference = RunnerConfiguration::GpuPreference::kDefault;
+  configuration.process_priority =
+      RunnerConfiguration::ProcessPriority::kNormal;
+  configuration.input_replay_speed = 1.0;
+  configuration.diagnostics = false;
+  configuration.pointer_history = false;
+  configuration.input_coalescing = false;
+  configuration.frame_budget = 0;
+  configuration.high_resolution_timer = false;
+
+  wchar_t path_override[MAX_PATH];
+  DWORD length = ::GetEnvironmentVariableW(kConfigurationFileVariable,
+                                           path_override, MAX_PATH);
+  bool has_override = length > 0 && length < MAX_PATH;
+  std::wstring path = has_override
+                          ? std::wstring(path_override)
+                          : GetExecutableDirectory() + kConfigurationFileName;
+  std::ifstream file(path.c_str());
+  if (!file) {
+    if (has_override) {
+      std::wcerr << L"Unable to read runner configuration " << path
+                 << std::endl;
+    }
+    return configuration;
+  }
+
+  std::string line;
+  int line_number = 0;
+  while (std::getline(file, line)) {
+    ++line_number;
+    line = Trim(line);
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    size_t separator = line.find('=');
+    if (separator == std::string::npos) {
+      std::wcerr << path << L":" << line_number << L": expected 'key=value'"
+                 << std::endl;
+      continue;
+    }
+    std::string key = Trim(line.substr(0, separator));
+    std::string value = Trim(line.substr(separator + 1));
+    bool valid = true;
+    if (key == "title") {
+      std::wstring title = Utf16FromUtf8(value);
+      valid = value.empty() || !title.empty();
+      if (valid) {
+        configuration.window_title = title;
+      }
+    } else if (key == "x") {
+      valid = ParseUnsigned(value, true, &configuration.window_origin_x);
+    } else if (key == "y") {
+      valid = ParseUnsigned(value, true, &configuration.window_origin_y);
+    } else if (key == "width") {
+      valid = ParseUnsigned(value, false, &configuration.window_width);
+    } else if (key == "height") {
+      valid = ParseUnsigned(value, false, &configuration.window_height);
+    } else if (key == "engine_argument") {
+      valid = !value.empty();
+      if (valid) {
+        configuration.engine_arguments.push_back(value);
+      }
+    } else if (key == "gpu_preference") {
+      valid = ParseGpuPreference(value, &configuration.gpu_preference);
+    } else if (key == "mmcss_task") {
+      configuration.mmcss_task = Utf16FromUtf8(value);
+      valid = value.empty() || !configuration.mmcss_task.empty();
+    } else if (key == "process_priority") {
+      valid = ParseProcessPriority(value, &configuration.process_priority);
+    } else if (key == "input_record" || key == "input_replay") {
+      std::wstring& input_path = key == "input_record"
+                                     ? configuration.input_record_path
+                                     : configuration.input_replay_path;
+      input_path = Utf16FromUtf8(value);
+      valid = value.empty() || !input_path.empty();
+    } else if (key == "input_replay_speed") {
+      valid = ParsePositiveDouble(value, &configuration.input_replay_speed);
+    } else if (key == "diagnostics") {
+      valid = ParseBool(value, &configuration.diagnostics);
+    } else if (key == "pointer_history") {
+      valid = ParseBool(value, &configuration.pointer_history);
+    } else if (key == "input_coalescing") {
+      valid = ParseBool(value, &configuration.input_coalescing);
+    } else if (key == "frame_budget") {
+      double fraction = 0;
+      valid = ParsePositiveDouble(value, &fraction) && fraction <= 1;
+      if (valid) {
+        configuration.frame_budget = fraction;
+      }
+    } else if (key == "high_resolution_timer") {
+      valid = ParseBool(value, &configuration.high_resolution_timer);
+    } else if (key == "renderer" || key == "software_render_threads" ||
+               key == "nice" || key == "realtime_priority" ||
+               key == "cpu_affinity") {
+      std::wcerr << path << L":" << line_number << L": "
+                 << Utf16FromUtf8(key)
+                 << L" is not supported by the Windows embedding, and will be "
+                    L"ignored"
+                 << std::endl;
+      continue;
+    } else {
+      std::wcerr << path << L":" << line_number << L": unknown setting '"
+                 << Utf16FromUtf8(key) << L"'" << std::endl;
+      continue;
+    }
+    if (!valid) {
+      std::wcerr << path << L":" << line_number << L": invalid value for '"
+                 << Utf16FromUtf8(key) << L"'" << std::endl;
+    }
+  }
+  if (!configuration.engine_arguments.empty()) {
+    std::wcerr << path
+               << L": engine_argument is not supported by the Windows "
+                  L"embedding yet, and will be ignored"
+               << std::endl;
+  }
+  return configuration;
+}
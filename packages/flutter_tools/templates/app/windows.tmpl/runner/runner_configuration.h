@@ -0,0 +1,112 @@
+#ifndef RUNNER_CONFIGURATION_
+#define RUNNER_CONFIGURATION_
+
+#include <string>
+#include <vector>
+
+// Settings that can be changed per deployment without rebuilding the runner.
+// The defaults come from window_configuration.h, and can be overridden by a
+// configuration file read at startup.
+//
+// The file is read from the path in the FLUTTER_RUNNER_CONFIG_FILE
+// environment variable if it is set, or from runner.conf next to the
+// executable otherwise. Each line is a UTF-8 'key=value' setting; blank lines
+// and lines starting with '#' are ignored. For example:
+//
+//   title=My App
+//   x=100
+//   y=100
+//   width=1280
+//   height=720
+//   engine_argument=--cache-sksl
+//   gpu_preference=high_performance
+//   mmcss_task=Games
+//   process_priority=above_normal
+//   input_replay=C:\traces\scroll_jank.trace
+//   input_replay_speed=2
+//   diagnostics=true
+//   pointer_history=true
+//   input_coalescing=true
+//   frame_budget=0.5
+//   high_resolution_timer=true
+//
+// gpu_preference chooses the GPU on machines with more than one, and is one of
+// 'default', 'power_saving' or 'high_performance' (see gpu_preference.h).
+// mmcss_task and process_priority are described in thread_scheduling.h.
+// input_record and input_replay name an input trace file to write or to
+// replay, and input_replay_speed is the replay speed relative to the
+// recording (see input_trace.h). diagnostics is 'true' or 'false' (the
+// default), and enables the live counters window and trace hotkeys described
+// in runner_diagnostics.h.
+//
+// pointer_history and input_coalescing are 'true' or 'false' (the default),
+// for apps that take high-rate mouse or pen input. pointer_history keeps the
+// samples Windows coalesces into each pointer update (see
+// Win32Window::SetPointerHistoryEnabled), and needs Windows 8 or later.
+// input_coalescing handles a burst of queued input in one Flutter pass (see
+// RunLoop::SetInputCoalescingEnabled).
+//
+// frame_budget enables the run loop's frame budget mode (see
+// RunLoop::SetFrameBudget), in which each refresh interval of the monitor the
+// window starts on is split between Windows messages and Flutter. Its value is
+// the fraction of the interval given to Windows messages, greater than 0 and
+// at most 1. By default, Flutter is serviced after every Windows message.
+//
+// high_resolution_timer is 'true' or 'false' (the default). When true, the
+// run loop wakes for engine tasks with a high resolution waitable timer
+// rather than at the system timer resolution (see
+// RunLoop::SetHighResolutionTimerEnabled). It needs Windows 10 1803 or later.
+//
+// engine_argument can be repeated, and each occurrence adds one argument. The
+// Windows embedding doesn't yet accept engine arguments, so they are parsed
+// for consistency with the Linux runner but reported as unsupported. The same
+// applies to the Linux runner's renderer and software_render_threads
+// settings, since the embedding chooses its rendering device itself (see
+// renderer_detection.h), and to its nice, realtime_priority and cpu_affinity
+// settings.
+struct RunnerConfiguration {
+  // Which GPU to prefer on machines with more than one.
+  enum class GpuPreference {
+    // Leave the choice to Windows and the user's graphics settings.
+    kDefault,
+    // Prefer the integrated GPU.
+    kPowerSaving,
+    // Prefer the discrete GPU.
+    kHighPerformance,
+  };
+
+  // The process's priority class.
+  enum class ProcessPriority {
+    kNormal,
+    kAboveNormal,
+    kHigh,
+  };
+
+  std::wstring window_title;
+  unsigned int window_origin_x;
+  unsigned int window_origin_y;
+  unsigned int window_width;
+  unsigned int window_height;
+  std::vector<std::string> engine_arguments;
+  GpuPreference gpu_preference;
+  // Empty to not register with MMCSS.
+  std::wstring mmcss_task;
+  ProcessPriority process_priority;
+  // Empty to not record or replay input.
+  std::wstring input_record_path;
+  std::wstring input_replay_path;
+  double input_replay_speed;
+  bool diagnostics;
+  bool pointer_history;
+  bool input_coalescing;
+  // Zero to not use frame budget mode.
+  double frame_budget;
+  bool high_resolution_timer;
+};
+
+// Returns the configuration for this run, reading the configuration file
+// described above. A missing configuration file isn't an error. Invalid lines
+// are reported on stderr and otherwise ignored.
+RunnerConfiguration LoadRunnerConfiguration();
+
+#endif  // RUNNER_CONFIGURATION_
@@ -0,0 +1,208 @@
+#include "runner_diagnostics.h"
+
+#include <cstdarg>
+#include <cwchar>
+#include <iostream>
+
+namespace {
+
+// About ten seconds of a busy run loop (input at 1kHz, and a Flutter pass
+// per message), in 1MB.
+constexpr size_t kTraceCapacity = 32 * 1024;
+
+constexpr std::chrono::milliseconds kRefreshInterval(500);
+
+constexpr UINT kToggleWindowKey = VK_F9;
+constexpr UINT kWriteTraceKey = VK_F8;
+
+// Returns |duration| in milliseconds.
+double ToMilliseconds(std::chrono::nanoseconds duration) {
+  return static_cast<double>(duration.count()) / 1e6;
+}
+
+// Returns the user and kernel time used by this process.
+std::chrono::nanoseconds GetProcessCpuTime() {
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!::GetProcessTimes(::GetCurrentProcess(), &creation_time, &exit_time,
+                         &kernel_time, &user_time)) {
+    return std::chrono::nanoseconds(0);
+  }
+  auto to_ticks = [](const FILETIME& time) {
+    return (static_cast<int64_t>(time.dwHighDateTime) << 32) |
+           time.dwLowDateTime;
+  };
+  // FILETIME durations are in 100ns units.
+  return std::chrono::nanoseconds(
+      (to_ticks(kernel_time) + to_ticks(user_time)) * 100);
+}
+
+// Appends a line formatted from |format| to |text|.
+void AppendLine(std::wstring* text, const wchar_t* format, ...) {
+  wchar_t line[256];
+  va_list arguments;
+  va_start(arguments, format);
+  int length = vswprintf(line, sizeof(line) / sizeof(line[0]), format,
+                         arguments);
+  va_end(arguments);
+  if (length > 0) {
+    text->append(line, length);
+  }
+  text->append(L"\n");
+}
+
+}  // namespace
+
+RunnerDiagnostics::RunnerDiagnostics(RunLoop* run_loop, RunnerMetrics* metrics)
+    : run_loop_(run_loop), metrics_(metrics), trace_(kTraceCapacity) {
+  run_loop_->SetTrace(&trace_);
+  previous_sample_ = TakeSample();
+}
+
+RunnerDiagnostics::~RunnerDiagnostics() {
+  run_loop_->SetTrace(nullptr);
+}
+
+void RunnerDiagnostics::HandleQueuedMessage(const MSG& message) {
+  // Bit 30 is set for auto-repeat, so holding a key acts once.
+  if (message.message != WM_KEYDOWN || (message.lParam & (1 << 30)) != 0 ||
+      ::GetKeyState(VK_CONTROL) >= 0 || ::GetKeyState(VK_SHIFT) >= 0) {
+    return;
+  }
+  if (message.wParam == kToggleWindowKey) {
+    ToggleWindow();
+  } else if (message.wParam == kWriteTraceKey) {
+    WriteTrace();
+  }
+}
+
+void RunnerDiagnostics::ToggleWindow() {
+  if (window_ && window_->GetHandle()) {
+    window_ = nullptr;
+    return;
+  }
+  previous_sample_ = TakeSample();
+  window_ = std::make_unique<DiagnosticsWindow>(
+      [this]() { return UpdateText(); }, kRefreshInterval);
+  if (!window_->CreateAndShow(L"Runner diagnostics", Win32Window::Point(10, 10),
+                              Win32Window::Size(420, 330))) {
+    window_ = nullptr;
+  }
+}
+
+std::wstring RunnerDiagnostics::WriteTrace() {
+  wchar_t directory[MAX_PATH + 1];
+  DWORD length = ::GetTempPathW(MAX_PATH + 1, directory);
+  if (length == 0 || length > MAX_PATH) {
+    std::cerr << "Unable to find the temporary directory" << std::endl;
+    return L"";
+  }
+  std::wstring path = std::wstring(directory, length) +
+                      L"flutter_runner_trace_" +
+                      std::to_wstring(::GetCurrentProcessId()) + L"_" +
+                      std::to_wstring(++traces_written_) + L".json";
+  if (!trace_.WriteOutput(path)) {
+    std::wcerr << L"Unable to write trace " << path << std::endl;
+    return L"";
+  }
+  std::wcerr << L"Wrote trace " << path << std::endl;
+  last_trace_path_ = path;
+  return path;
+}
+
+RunnerDiagnostics::Sample RunnerDiagnostics::TakeSample() const {
+  Sample sample;
+  sample.time = std::chrono::steady_clock::now();
+  sample.run_loop = run_loop_->statistics();
+  sample.build_durations = metrics_->build_durations();
+  sample.raster_durations = metrics_->raster_durations();
+  sample.composition = metrics_->GetCompositionCountersSinceStart();
+  sample.cpu_time = GetProcessCpuTime();
+  return sample;
+}
+
+std::wstring RunnerDiagnostics::UpdateText() {
+  Sample sample = TakeSample();
+  const Sample& previous = previous_sample_;
+  double seconds = std::chrono::duration<double>(sample.time - previous.time)
+                       .count();
+  if (seconds <= 0) {
+    seconds = 1;
+  }
+  // Per-second rate of a counter.
+  auto rate = [seconds](uint64_t now, uint64_t before) {
+    return static_cast<double>(now - before) / seconds;
+  };
+  // Milliseconds per second of a duration.
+  auto share = [seconds](std::chrono::nanoseconds now,
+                         std::chrono::nanoseconds before) {
+    return ToMilliseconds(now - before) / seconds;
+  };
+  const RunLoop::Statistics& run_loop = sample.run_loop;
+  const RunLoop::Statistics& previous_run_loop = previous.run_loop;
+  DurationHistogram waits =
+      run_loop.wait_durations.Since(previous_run_loop.wait_durations);
+  DurationHistogram dispatches =
+      run_loop.dispatch_durations.Since(previous_run_loop.dispatch_durations);
+  DurationHistogram flutter_passes = run_loop.flutter_pass_durations.Since(
+      previous_run_loop.flutter_pass_durations);
+  DurationHistogram input_queue_delays = run_loop.input_queue_delays.Since(
+      previous_run_loop.input_queue_delays);
+  DurationHistogram builds =
+      sample.build_durations.Since(previous.build_durations);
+  DurationHistogram rasters =
+      sample.raster_durations.Since(previous.raster_durations);
+  double cpu_milliseconds = ToMilliseconds(sample.cpu_time - previous.cpu_time);
+
+  std::wstring text;
+  AppendLine(&text, L"Run loop, per second");
+  AppendLine(&text, L"  wakeups    %7.0f  messages %.0f, handles %.0f,",
+             static_cast<double>(waits.count()) / seconds,
+             rate(run_loop.message_wakes, previous_run_loop.message_wakes),
+             rate(run_loop.handle_wakes, previous_run_loop.handle_wakes));
+  AppendLine(&text, L"                      timeouts %.0f",
+             rate(run_loop.timeout_wakes, previous_run_loop.timeout_wakes));
+  AppendLine(&text, L"  messages   %7.0f  %.1f per wakeup",
+             static_cast<double>(dispatches.count()) / seconds,
+             waits.count() > 0 ? static_cast<double>(dispatches.count()) /
+                                     static_cast<double>(waits.count())
+                               : 0.0);
+  AppendLine(&text, L"  dispatch   %7.1f ms  p90 %lld us",
+             share(run_loop.native_time, previous_run_loop.native_time),
+             static_cast<long long>(dispatches.Percentile(90).count()));
+  AppendLine(&text, L"  Flutter    %7.1f ms  p90 %lld us, %.0f passes",
+             share(run_loop.flutter_time, previous_run_loop.flutter_time),
+             static_cast<long long>(flutter_passes.Percentile(90).count()),
+             static_cast<double>(flutter_passes.count()) / seconds);
+  AppendLine(&text, L"  waiting    %7.1f ms",
+             ToMilliseconds(waits.total()) / seconds);
+  AppendLine(&text, L"  input queue delay p90 %lld ms",
+             static_cast<long long>(input_queue_delays.Percentile(90).count() /
+                                    1000));
+  AppendLine(&text, L"");
+  AppendLine(&text, L"Frames, per second");
+  AppendLine(&text, L"  frames     %7.1f  build p90 %lld us",
+             static_cast<double>(builds.count()) / seconds,
+             static_cast<long long>(builds.Percentile(90).count()));
+  AppendLine(&text, L"                      raster p90 %lld us",
+             static_cast<long long>(rasters.Percentile(90).count()));
+  AppendLine(&text, L"  CPU        %7.1f ms  %.1f ms per frame",
+             cpu_milliseconds / seconds,
+             builds.count() > 0
+                 ? cpu_milliseconds / static_cast<double>(builds.count())
+                 : 0.0);
+  AppendLine(
+      &text, L"  DWM late %.1f, dropped %.1f, missed %.1f",
+      rate(sample.composition.frames_late, previous.composition.frames_late),
+      rate(sample.composition.frames_dropped,
+           previous.composition.frames_dropped),
+      rate(sample.composition.frames_missed,
+           previous.composition.frames_missed));
+  AppendLine(&text, L"");
+  AppendLine(&text, L"Ctrl+Shift+F8 writes a trace of the last few seconds.");
+  if (!last_trace_path_.empty()) {
+    text += L"Last trace: " + last_trace_path_ + L"\n";
+  }
+
+  previous_sample_ = sample;
+  return text;
+}
@@ -0,0 +1,83 @@
+#ifndef RUNNER_DIAGNOSTICS_H_
+#define RUNNER_DIAGNOSTICS_H_
+
+#include <windows.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "diagnostics_window.h"
+#include "duration_histogram.h"
+#include "recent_trace.h"
+#include "run_loop.h"
+#include "runner_metrics.h"
+
+// Live diagnostics for finding the cause of jank on machines without a
+// profiler, enabled with the 'diagnostics' runner setting:
+//
+// - Ctrl+Shift+F9 shows or hides a window of live counters: run loop wakeups
+//   by cause, time in DispatchMessage and in Flutter's ProcessMessages, input
+//   queueing delay, frame build and raster times, process CPU time, and DWM's
+//   late and dropped frames.
+// - Ctrl+Shift+F8 writes the run loop's last few seconds (every wait,
+//   message dispatch and Flutter pass) to a trace in the temporary directory,
+//   and reports its path on stderr and in the window.
+//
+// The keys are still delivered to the app. Frame times are the ones the app
+// reports to RunnerMetrics, so they are only shown for apps that report them.
+// The embedding doesn't expose its swap chain, so GPU time can't be measured
+// directly; the raster time includes submitting work to the GPU, and DWM's
+// counters show frames that reached the screen late.
+class RunnerDiagnostics {
+ public:
+  // Shows counters from |run_loop| and |metrics|, and records |run_loop| in
+  // the recent trace while this object exists.
+  RunnerDiagnostics(RunLoop* run_loop, RunnerMetrics* metrics);
+  ~RunnerDiagnostics();
+
+  // Prevent copying
+  RunnerDiagnostics(RunnerDiagnostics const&) = delete;
+  RunnerDiagnostics& operator=(RunnerDiagnostics const&) = delete;
+
+  // Handles |message| if it's one of the keys above. Call with each message
+  // the run loop takes from the queue (see RunLoop::SetMessageObserver).
+  void HandleQueuedMessage(const MSG& message);
+
+  // Shows the counters window if it isn't shown, and closes it otherwise.
+  void ToggleWindow();
+
+  // Writes the recent trace to a new file in the temporary directory,
+  // returning its path, or an empty string if it can't be written.
+  std::wstring WriteTrace();
+
+ private:
+  // The counters at one point in time. Rates are computed from the
+  // difference between two samples.
+  struct Sample {
+    std::chrono::steady_clock::time_point time;
+    RunLoop::Statistics run_loop;
+    DurationHistogram build_durations;
+    DurationHistogram raster_durations;
+    RunnerMetrics::CompositionCounters composition;
+    // User and kernel time used by the process.
+    std::chrono::nanoseconds cpu_time{0};
+  };
+
+  // Returns the current counters.
+  Sample TakeSample() const;
+
+  // Returns the window text for the time since the last call, starting a new
+  // interval.
+  std::wstring UpdateText();
+
+  RunLoop* run_loop_;
+  RunnerMetrics* metrics_;
+  RecentTrace trace_;
+  std::unique_ptr<DiagnosticsWindow> window_;
+  Sample previous_sample_;
+  std::wstring last_trace_path_;
+  int traces_written_ = 0;
+};
+
+#endif  // RUNNER_DIAGNOSTICS_H_
@@ -0,0 +1,354 @@
+#include "runner_metrics.h"
+
+#include <flutter/standard_method_codec.h>
+#include <windows.h>
+// Must come after windows.h.
+#include <dwmapi.h>
+
+#include <cstdio>
+
+#include "startup_trace.h"
+
+namespace {
+
+constexpr char kChannelName[] = "flutter_runner/metrics";
+
+constexpr const wchar_t kMetricsFileVariable[] = L"FLUTTER_RUNNER_METRICS_FILE";
+
+int64_t ToMicroseconds(std::chrono::nanoseconds duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+      .count();
+}
+
+flutter::EncodableValue EncodeHistogram(const DurationHistogram& histogram) {
+  flutter::EncodableList buckets;
+  for (uint64_t count : histogram.buckets()) {
+    buckets.push_back(flutter::EncodableValue(static_cast<int64_t>(count)));
+  }
+  return flutter::EncodableValue(flutter::EncodableMap{
+      {flutter::EncodableValue("count"),
+       flutter::EncodableValue(static_cast<int64_t>(histogram.count()))},
+      {flutter::EncodableValue("totalMicros"),
+       flutter::EncodableValue(ToMicroseconds(histogram.total()))},
+      {flutter::EncodableValue("longestMicros"),
+       flutter::EncodableValue(ToMicroseconds(histogram.longest()))},
+      {flutter::EncodableValue("p50Micros"),
+       flutter::EncodableValue(
+           static_cast<int64_t>(histogram.Percentile(50).count()))},
+      {flutter::EncodableValue("p90Micros"),
+       flutter::EncodableValue(
+           static_cast<int64_t>(histogram.Percentile(90).count()))},
+      {flutter::EncodableValue("p99Micros"),
+       flutter::EncodableValue(
+           static_cast<int64_t>(histogram.Percentile(99).count()))},
+      {flutter::EncodableValue("buckets"), flutter::EncodableValue(buckets)},
+  });
+}
+
+void WriteHistogram(FILE* file,
+                    const char* name,
+                    const DurationHistogram& histogram) {
+  fprintf(file,
+          "\"%s\":{\"count\":%llu,\"totalMicros\":%lld,"
+          "\"longestMicros\":%lld,\"p50Micros\":%lld,\"p90Micros\":%lld,"
+          "\"p99Micros\":%lld,\"buckets\":[",
+          name, static_cast<unsigned long long>(histogram.count()),
+          static_cast<long long>(ToMicroseconds(histogram.total())),
+          static_cast<long long>(ToMicroseconds(histogram.longest())),
+          static_cast<long long>(histogram.Percentile(50).count()),
+          static_cast<long long>(histogram.Percentile(90).count()),
+          static_cast<long long>(histogram.Percentile(99).count()));
+  for (size_t i = 0; i < histogram.buckets().size(); ++i) {
+    fprintf(file, "%s%llu", i > 0 ? "," : "",
+            static_cast<unsigned long long>(histogram.buckets()[i]));
+  }
+  fprintf(file, "]}");
+}
+
+// Writes |value| to |file| as a quoted JSON string.
+void WriteJsonString(FILE* file, const std::string& value) {
+  fputc('"', file);
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      fprintf(file, "\\%c", c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      fprintf(file, "\\u%04x", c);
+    } else {
+      fputc(c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+// Reads DWM's composition timing counters into |info|, returning false if
+// they aren't available (e.g., in a remote session without composition).
+bool GetCompositionTimingInfo(DWM_TIMING_INFO* info) {
+  *info = {};
+  info->cbSize = sizeof(*info);
+  // Since Windows 8.1, timing information is only available for the whole
+  // desktop.
+  return SUCCEEDED(::DwmGetCompositionTimingInfo(nullptr, info));
+}
+
+}  // namespace
+
+// static
+RunnerMetrics* RunnerMetrics::GetInstance() {
+  static RunnerMetrics* instance = new RunnerMetrics();
+  return instance;
+}
+
+RunnerMetrics::RunnerMetrics()
+    : start_time_(std::chrono::steady_clock::now()) {
+  DWM_TIMING_INFO info;
+  if (GetCompositionTimingInfo(&info)) {
+    has_composition_counters_ = true;
+    start_composition_counters_.frames = info.cFrame;
+    start_composition_counters_.frames_late = info.cFramesLate;
+    start_composition_counters_.frames_dropped = info.cFramesDropped;
+    start_composition_counters_.frames_missed = info.cFramesMissed;
+  }
+}
+
+RunnerMetrics::CompositionCounters
+RunnerMetrics::GetCompositionCountersSinceStart() const {
+  CompositionCounters counters;
+  DWM_TIMING_INFO info;
+  if (!has_composition_counters_ || !GetCompositionTimingInfo(&info)) {
+    return counters;
+  }
+  counters.frames = info.cFrame - start_composition_counters_.frames;
+  counters.frames_late =
+      info.cFramesLate - start_composition_counters_.frames_late;
+  counters.frames_dropped =
+      info.cFramesDropped - start_composition_counters_.frames_dropped;
+  counters.frames_missed =
+      info.cFramesMissed - start_composition_counters_.frames_missed;
+  return counters;
+}
+
+void RunnerMetrics::EnableOutputFromEnvironment() {
+  wchar_t path[MAX_PATH];
+  DWORD length =
+      ::GetEnvironmentVariableW(kMetricsFileVariable, path, MAX_PATH);
+  if (length > 0 && length < MAX_PATH) {
+    output_path_ = path;
+  }
+}
+
+std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>>
+RunnerMetrics::CreateChannel(flutter::BinaryMessenger* messenger,
+                             const RunLoop* run_loop) {
+  auto channel =
+      std::make_unique<flutter::MethodChannel<flutter::EncodableValue>>(
+          messenger, kChannelName,
+          &flutter::StandardMethodCodec::GetInstance());
+  channel->SetMethodCallHandler(
+      [this, run_loop](const auto& call, auto result) {
+        HandleMethodCall(call, std::move(result), run_loop);
+      });
+  return channel;
+}
+
+void RunnerMetrics::RecordFirstFrame() {
+  if (first_frame_time_.count() >= 0) {
+    return;
+  }
+  first_frame_time_ = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start_time_);
+  StartupTrace::GetInstance()->AddInstantEvent("FirstFrame");
+}
+
+void RunnerMetrics::RecordFrameTiming(
+    std::chrono::microseconds build_duration,
+    std::chrono::microseconds raster_duration) {
+  build_durations_.Record(build_duration);
+  raster_durations_.Record(raster_duration);
+}
+
+void RunnerMetrics::SetRenderer(const std::string& renderer) {
+  renderer_ = renderer;
+}
+
+void RunnerMetrics::SetAdapter(const AdapterDescription& adapter) {
+  adapter_ = adapter;
+  has_adapter_ = true;
+}
+
+void RunnerMetrics::RecordMemoryTrim(int64_t freed_bytes) {
+  ++memory_trims_;
+  memory_trim_freed_bytes_ += freed_bytes;
+}
+
+flutter::EncodableValue RunnerMetrics::ToEncodableValue(
+    const RunLoop::Statistics& run_loop_statistics) const {
+  flutter::EncodableValue first_frame_time;
+  if (first_frame_time_.count() >= 0) {
+    first_frame_time = flutter::EncodableValue(
+        static_cast<int64_t>(first_frame_time_.count()));
+  }
+  flutter::EncodableMap run_loop{
+      {flutter::EncodableValue("wait"),
+       EncodeHistogram(run_loop_statistics.wait_durations)},
+      {flutter::EncodableValue("dispatch"),
+       EncodeHistogram(run_loop_statistics.dispatch_durations)},
+      {flutter::EncodableValue("flutterPass"),
+       EncodeHistogram(run_loop_statistics.flutter_pass_durations)},
+      {flutter::EncodableValue("inputQueueDelay"),
+       EncodeHistogram(run_loop_statistics.input_queue_delays)},
+      {flutter::EncodableValue("messageWakes"),
+       flutter::EncodableValue(
+           static_cast<int64_t>(run_loop_statistics.message_wakes))},
+      {flutter::EncodableValue("handleWakes"),
+       flutter::EncodableValue(
+           static_cast<int64_t>(run_loop_statistics.handle_wakes))},
+      {flutter::EncodableValue("timeoutWakes"),
+       flutter::EncodableValue(
+           static_cast<int64_t>(run_loop_statistics.timeout_wakes))},
+  };
+  CompositionCounters composition_counters =
+      GetCompositionCountersSinceStart();
+  flutter::EncodableMap composition{
+      {flutter::EncodableValue("frames"),
+       flutter::EncodableValue(
+           static_cast<int64_t>(composition_counters.frames))},
+      {flutter::EncodableValue("framesLate"),
+       flutter::EncodableValue(
+           static_cast<int64_t>(composition_counters.frames_late))},
+      {flutter::EncodableValue("framesDropped"),
+       flutter::EncodableValue(
+           static_cast<int64_t>(composition_counters.frames_dropped))},
+      {flutter::EncodableValue("framesMissed"),
+       flutter::EncodableValue(
+           static_cast<int64_t>(composition_counters.frames_missed))},
+  };
+  flutter::EncodableValue adapter;
+  if (has_adapter_) {
+    adapter = flutter::EncodableValue(flutter::EncodableMap{
+        {flutter::EncodableValue("name"),
+         flutter::EncodableValue(adapter_.name)},
+        {flutter::EncodableValue("vendorId"),
+         flutter::EncodableValue(static_cast<int64_t>(adapter_.vendor_id))},
+        {flutter::EncodableValue("deviceId"),
+         flutter::EncodableValue(static_cast<int64_t>(adapter_.device_id))},
+        {flutter::EncodableValue("dedicatedVideoMemoryBytes"),
+         flutter::EncodableValue(
+             static_cast<int64_t>(adapter_.dedicated_video_memory))},
+    });
+  }
+  return flutter::EncodableValue(flutter::EncodableMap{
+      {flutter::EncodableValue("renderer"), flutter::EncodableValue(renderer_)},
+      {flutter::EncodableValue("adapter"), adapter},
+      {flutter::EncodableValue("firstFrameMicros"), first_frame_time},
+      {flutter::EncodableValue("build"), EncodeHistogram(build_durations_)},
+      {flutter::EncodableValue("raster"), EncodeHistogram(raster_durations_)},
+      {flutter::EncodableValue("runLoop"), flutter::EncodableValue(run_loop)},
+      {flutter::EncodableValue("composition"),
+       flutter::EncodableValue(composition)},
+      {flutter::EncodableValue("memoryTrims"),
+       flutter::EncodableValue(memory_trims_)},
+      {flutter::EncodableValue("memoryTrimFreedBytes"),
+       flutter::EncodableValue(memory_trim_freed_bytes_)},
+  });
+}
+
+bool RunnerMetrics::WriteOutput(
+    const RunLoop::Statistics& run_loop_statistics) const {
+  if (output_path_.empty()) {
+    return false;
+  }
+  FILE* file = nullptr;
+  if (_wfopen_s(&file, output_path_.c_str(), L"w") != 0 || !file) {
+    return false;
+  }
+  // The renderer name is one of a fixed set, so it doesn't need escaping.
+  fprintf(file, "{\"renderer\":\"%s\",", renderer_.c_str());
+  if (has_adapter_) {
+    fprintf(file, "\"adapter\":{\"name\":");
+    WriteJsonString(file, adapter_.name);
+    fprintf(file,
+            ",\"vendorId\":%u,\"deviceId\":%u,"
+            "\"dedicatedVideoMemoryBytes\":%llu},",
+            adapter_.vendor_id, adapter_.device_id,
+            static_cast<unsigned long long>(adapter_.dedicated_video_memory));
+  } else {
+    fprintf(file, "\"adapter\":null,");
+  }
+  if (first_frame_time_.count() >= 0) {
+    fprintf(file, "\"firstFrameMicros\":%lld,",
+            static_cast<long long>(first_frame_time_.count()));
+  } else {
+    fprintf(file, "\"firstFrameMicros\":null,");
+  }
+  WriteHistogram(file, "build", build_durations_);
+  fprintf(file, ",");
+  WriteHistogram(file, "raster", raster_durations_);
+  fprintf(file, ",\"runLoop\":{");
+  WriteHistogram(file, "wait", run_loop_statistics.wait_durations);
+  fprintf(file, ",");
+  WriteHistogram(file, "dispatch", run_loop_statistics.dispatch_durations);
+  fprintf(file, ",");
+  WriteHistogram(file, "flutterPass",
+                 run_loop_statistics.flutter_pass_durations);
+  fprintf(file, ",");
+  WriteHistogram(file, "inputQueueDelay",
+                 run_loop_statistics.input_queue_delays);
+  fprintf(file,
+          ",\"messageWakes\":%llu,\"handleWakes\":%llu,"
+          "\"timeoutWakes\":%llu",
+          static_cast<unsigned long long>(run_loop_statistics.message_wakes),
+          static_cast<unsigned long long>(run_loop_statistics.handle_wakes),
+          static_cast<unsigned long long>(run_loop_statistics.timeout_wakes));
+  CompositionCounters composition_counters =
+      GetCompositionCountersSinceStart();
+  fprintf(file,
+          "},\"composition\":{\"frames\":%llu,\"framesLate\":%llu,"
+          "\"framesDropped\":%llu,\"framesMissed\":%llu",
+          static_cast<unsigned long long>(composition_counters.frames),
+          static_cast<unsigned long long>(composition_counters.frames_late),
+          static_cast<unsigned long long>(composition_counters.frames_dropped),
+          static_cast<unsigned long long>(composition_counters.frames_missed));
+  fprintf(file, "},\"memoryTrims\":%lld,\"memoryTrimFreedBytes\":%lld}\n",
+          static_cast<long long>(memory_trims_),
+          static_cast<long long>(memory_trim_freed_bytes_));
+  bool success = ferror(file) == 0;
+  fclose(file);
+  return success;
+}
+
+void RunnerMetrics::HandleMethodCall(
+    const flutter::MethodCall<flutter::EncodableValue>& method_call,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result,
+    const RunLoop* run_loop) {
+  const std::string& method = method_call.method_name();
+  if (method == "reportFirstFrame") {
+    RecordFirstFrame();
+    result->Success();
+  } else if (method == "reportFrameTimings") {
+    // A flat list of [build, raster] microsecond pairs.
+    const flutter::EncodableValue* arguments = method_call.arguments();
+    if (!arguments || !arguments->IsList() ||
+        arguments->ListValue().size() % 2 != 0) {
+      result->Error("bad_arguments",
+                    "Expected a list of build and raster duration pairs");
+      return;
+    }
+    const flutter::EncodableList& timings = arguments->ListValue();
+    for (const flutter::EncodableValue& timing : timings) {
+      if (!timing.IsInt() && !timing.IsLong()) {
+        result->Error("bad_arguments", "Expected integer durations");
+        return;
+      }
+    }
+    for (size_t i = 0; i + 1 < timings.size(); i += 2) {
+      RecordFrameTiming(std::chrono::microseconds(timings[i].LongValue()),
+                        std::chrono::microseconds(timings[i + 1].LongValue()));
+    }
+    result->Success();
+  } else if (method == "getMetrics") {
+    flutter::EncodableValue metrics = ToEncodableValue(run_loop->statistics());
+    result->Success(&metrics);
+  } else {
+    result->NotImplemented();
+  }
+}
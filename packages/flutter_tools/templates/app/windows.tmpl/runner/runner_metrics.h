@@ -0,0 +1,133 @@
+#ifndef RUNNER_METRICS_H_
+#define RUNNER_METRICS_H_
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+#include <flutter/method_channel.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "duration_histogram.h"
+#include "renderer_detection.h"
+#include "run_loop.h"
+
+// Collects first frame and frame timing metrics, which can be queried along
+// with the run loop's statistics over a method channel, and written to a file
+// on exit.
+//
+// The engine doesn't report frame timings to the embedder, so they are
+// reported by the app over the channel created by CreateChannel:
+//
+//   const channel = MethodChannel('flutter_runner/metrics');
+//   WidgetsBinding.instance.waitUntilFirstFrameRasterized
+//       .then((_) => channel.invokeMethod<void>('reportFirstFrame'));
+//   SchedulerBinding.instance.addTimingsCallback((timings) {
+//     channel.invokeMethod<void>('reportFrameTimings', <int>[
+//       for (final timing in timings) ...<int>[
+//         timing.buildDuration.inMicroseconds,
+//         timing.rasterDuration.inMicroseconds,
+//       ],
+//     ]);
+//   });
+//
+// and 'getMetrics' returns a map of everything collected so far.
+//
+// The metrics also include DWM's composition counters since the runner
+// started, which show frames the compositor dropped, missed or displayed late.
+// These are system-wide; the embedding doesn't expose its swap chain, so
+// presents can't be attributed to the app.
+class RunnerMetrics {
+ public:
+  // DWM composition counters.
+  struct CompositionCounters {
+    uint64_t frames = 0;
+    uint64_t frames_late = 0;
+    uint64_t frames_dropped = 0;
+    uint64_t frames_missed = 0;
+  };
+
+  // Returns the singleton metrics instance. The first frame time is measured
+  // from the first call, so it should be made at the start of main.
+  static RunnerMetrics* GetInstance();
+
+  // Sets the file written by WriteOutput to the path in the
+  // FLUTTER_RUNNER_METRICS_FILE environment variable, if it is set.
+  void EnableOutputFromEnvironment();
+
+  // Creates the metrics channel on |messenger|, reporting the statistics of
+  // |run_loop| along with frame metrics. Calls are handled for as long as the
+  // returned channel exists, which must not outlive |messenger|.
+  std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>>
+  CreateChannel(flutter::BinaryMessenger* messenger, const RunLoop* run_loop);
+
+  // Records that the first frame has been rasterized. Only the first call has
+  // any effect.
+  void RecordFirstFrame();
+
+  // Records the build (UI thread) and raster durations of a frame.
+  void RecordFrameTiming(std::chrono::microseconds build_duration,
+                         std::chrono::microseconds raster_duration);
+
+  // Sets the name of the renderer in use, which is reported with the frame
+  // metrics so that results from different renderers can be told apart.
+  void SetRenderer(const std::string& renderer);
+
+  // Sets the adapter the engine renders with, which is reported as "adapter"
+  // so that results from hybrid-graphics machines show which GPU was used.
+  void SetAdapter(const AdapterDescription& adapter);
+
+  // Records that the app was asked to release memory for low system memory,
+  // and |freed_bytes| of private memory were freed as a result.
+  void RecordMemoryTrim(int64_t freed_bytes);
+
+  // Returns the composition counters accumulated since the runner started,
+  // or all zeros if composition timing isn't available.
+  CompositionCounters GetCompositionCountersSinceStart() const;
+
+  // The frame timings recorded so far.
+  const DurationHistogram& build_durations() const { return build_durations_; }
+  const DurationHistogram& raster_durations() const {
+    return raster_durations_;
+  }
+
+  // Returns all metrics, including |run_loop_statistics|, as a map.
+  flutter::EncodableValue ToEncodableValue(
+      const RunLoop::Statistics& run_loop_statistics) const;
+
+  // Writes all metrics, including |run_loop_statistics|, as JSON to the
+  // path set by EnableOutputFromEnvironment. Returns false if no path is set
+  // or the file can't be written.
+  bool WriteOutput(const RunLoop::Statistics& run_loop_statistics) const;
+
+ private:
+  RunnerMetrics();
+
+  // Handles a call on a channel created by CreateChannel.
+  void HandleMethodCall(
+      const flutter::MethodCall<flutter::EncodableValue>& method_call,
+      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result,
+      const RunLoop* run_loop);
+
+  std::chrono::steady_clock::time_point start_time_;
+  CompositionCounters start_composition_counters_;
+  bool has_composition_counters_ = false;
+  std::wstring output_path_;
+  std::string renderer_;
+  AdapterDescription adapter_;
+  bool has_adapter_ = false;
+
+  // The time from start_time_ to the first frame, or a negative value if it
+  // hasn't been reported.
+  std::chrono::microseconds first_frame_time_{-1};
+
+  DurationHistogram build_durations_;
+  DurationHistogram raster_durations_;
+
+  // The number of memory trims, and the total bytes they freed.
+  int64_t memory_trims_ = 0;
+  int64_t memory_trim_freed_bytes_ = 0;
+};
+
+#endif  // RUNNER_METRICS_H_
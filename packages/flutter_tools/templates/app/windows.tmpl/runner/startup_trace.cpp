@@ -0,0 +1,109 @@
+#include "startup_trace.h"
+
+#include <cstdio>
+
+namespace {
+
+constexpr const wchar_t kStartupTraceFileVariable[] =
+    L"FLUTTER_STARTUP_TRACE_FILE";
+
+}  // namespace
+
+StartupTrace::Scope::Scope(const char* name) : name_(name) {
+  ::QueryPerformanceCounter(&start_);
+}
+
+StartupTrace::Scope::~Scope() {
+  StartupTrace::GetInstance()->AddCompletePhase(name_, start_);
+}
+
+// static
+StartupTrace* StartupTrace::GetInstance() {
+  static StartupTrace* instance = new StartupTrace();
+  return instance;
+}
+
+StartupTrace::StartupTrace() {
+  ::QueryPerformanceFrequency(&frequency_);
+}
+
+void StartupTrace::Enable(const std::wstring& output_path) {
+  enabled_ = true;
+  output_path_ = output_path;
+  // Startup has few enough events that they should never need reallocation.
+  events_.reserve(64);
+}
+
+void StartupTrace::EnableFromEnvironment() {
+  wchar_t path[MAX_PATH];
+  DWORD length =
+      ::GetEnvironmentVariableW(kStartupTraceFileVariable, path, MAX_PATH);
+  if (length > 0 && length < MAX_PATH) {
+    Enable(path);
+  }
+}
+
+void StartupTrace::AddCompletePhase(const char* name, LARGE_INTEGER start) {
+  if (!enabled_) {
+    return;
+  }
+  LARGE_INTEGER now;
+  ::QueryPerformanceCounter(&now);
+  events_.push_back({name, 'X', start.QuadPart, now.QuadPart - start.QuadPart,
+                     ::GetCurrentThreadId()});
+}
+
+void StartupTrace::AddInstantEvent(const char* name) {
+  if (!enabled_) {
+    return;
+  }
+  LARGE_INTEGER now;
+  ::QueryPerformanceCounter(&now);
+  events_.push_back({name, 'i', now.QuadPart, 0, ::GetCurrentThreadId()});
+}
+
+bool StartupTrace::WriteOutput() const {
+  if (!enabled_) {
+    return false;
+  }
+  FILE* file = nullptr;
+  if (_wfopen_s(&file, output_path_.c_str(), L"w") != 0 || !file) {
+    return false;
+  }
+  // Timestamps are only meaningful relative to each other, so make them
+  // relative to the earliest event.
+  LONGLONG origin = 0;
+  for (size_t i = 0; i < events_.size(); ++i) {
+    if (i == 0 || events_[i].start_ticks < origin) {
+      origin = events_[i].start_ticks;
+    }
+  }
+  DWORD process_id = ::GetCurrentProcessId();
+  fprintf(file, "{\"traceEvents\":[\n");
+  for (size_t i = 0; i < events_.size(); ++i) {
+    const Event& event = events_[i];
+    fprintf(file,
+            "  {\"name\":\"%s\",\"cat\":\"startup\",\"ph\":\"%c\","
+            "\"ts\":%.3f,\"pid\":%lu,\"tid\":%lu",
+            event.name, event.phase,
+            TicksToMicroseconds(event.start_ticks - origin), process_id,
+            event.thread_id);
+    if (event.phase == 'X') {
+      fprintf(file, ",\"dur\":%.3f",
+              TicksToMicroseconds(event.duration_ticks));
+    } else {
+      // Process-scoped, so instant events are drawn across all threads.
+      fprintf(file, ",\"s\":\"p\"");
+    }
+    fprintf(file, "}%s\n", i + 1 < events_.size() ? "," : "");
+  }
+  fprintf(file, "]}\n");
+  bool success = ferror(file) == 0;
+  fclose(file);
+  return success;
+}
+
+double StartupTrace::TicksToMicroseconds(LONGLONG ticks) const {
+  return static_cast<double>(ticks) * 1000000.0 /
+         static_cast<double>(frequency_.QuadPart);
+}
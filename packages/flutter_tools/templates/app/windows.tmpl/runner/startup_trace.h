@@ -0,0 +1,80 @@
+#ifndef STARTUP_TRACE_H_
+#define STARTUP_TRACE_H_
+
+#include <windows.h>
+
+#include <string>
+#include <vector>
+
+// Records high-resolution timestamps for the phases of application startup,
+// which can be written out in the Chrome trace event format for viewing in
+// chrome://tracing or https://ui.perfetto.dev.
+//
+// Recording is a no-op until Enable is called, so that phases can be marked
+// unconditionally.
+class StartupTrace {
+ public:
+  // Records the duration of a phase from construction to destruction.
+  class Scope {
+   public:
+    explicit Scope(const char* name);
+    ~Scope();
+
+    // Prevent copying
+    Scope(Scope const&) = delete;
+    Scope& operator=(Scope const&) = delete;
+
+   private:
+    const char* name_;
+    LARGE_INTEGER start_;
+  };
+
+  // Returns the singleton trace instance.
+  static StartupTrace* GetInstance();
+
+  // Starts recording events, which will be written to |output_path| by
+  // WriteOutput.
+  void Enable(const std::wstring& output_path);
+
+  // Calls Enable with the path in the FLUTTER_STARTUP_TRACE_FILE environment
+  // variable, if it is set.
+  void EnableFromEnvironment();
+
+  bool enabled() const { return enabled_; }
+
+  // Records a phase that started at |start| and ended now. |name| must be a
+  // string literal, or otherwise outlive the trace.
+  void AddCompletePhase(const char* name, LARGE_INTEGER start);
+
+  // Records a point in time, such as the first frame. |name| must be a string
+  // literal, or otherwise outlive the trace.
+  void AddInstantEvent(const char* name);
+
+  // Writes all recorded events to the output path passed to Enable. Returns
+  // false if tracing isn't enabled or the file can't be written.
+  bool WriteOutput() const;
+
+ private:
+  struct Event {
+    const char* name;
+    // The Chrome trace event phase: 'X' for complete events, 'i' for instant
+    // events.
+    char phase;
+    LONGLONG start_ticks;
+    LONGLONG duration_ticks;
+    DWORD thread_id;
+  };
+
+  StartupTrace();
+
+  // Converts performance counter ticks relative to trace start to
+  // microseconds, the Chrome trace format's time unit.
+  double TicksToMicroseconds(LONGLONG ticks) const;
+
+  bool enabled_ = false;
+  std::wstring output_path_;
+  LARGE_INTEGER frequency_;
+  std::vector<Event> events_;
+};
+
+#endif  // STARTUP_TRACE_H_
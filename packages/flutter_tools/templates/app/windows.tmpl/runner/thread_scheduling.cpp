@@ -0,0 +1,41 @@
+#include "thread_scheduling.h"
+
+// Must come after windows.h.
+#include <avrt.h>
+
+#include <iostream>
+
+ThreadScheduling::ThreadScheduling(const RunnerConfiguration& configuration) {
+  if (configuration.process_priority !=
+      RunnerConfiguration::ProcessPriority::kNormal) {
+    DWORD priority_class = configuration.process_priority ==
+                                   RunnerConfiguration::ProcessPriority::kHigh
+                               ? HIGH_PRIORITY_CLASS
+                               : ABOVE_NORMAL_PRIORITY_CLASS;
+    if (::SetPriorityClass(::GetCurrentProcess(), priority_class)) {
+      worker_thread_priority_ = THREAD_PRIORITY_BELOW_NORMAL;
+    } else {
+      std::wcerr << L"Unable to set the process priority: error "
+                 << ::GetLastError() << std::endl;
+    }
+  }
+
+  if (!configuration.mmcss_task.empty()) {
+    DWORD task_index = 0;
+    mmcss_handle_ = ::AvSetMmThreadCharacteristicsW(
+        configuration.mmcss_task.c_str(), &task_index);
+    if (mmcss_handle_) {
+      worker_thread_priority_ = THREAD_PRIORITY_BELOW_NORMAL;
+    } else {
+      std::wcerr << L"Unable to register with MMCSS as '"
+                 << configuration.mmcss_task << L"': error "
+                 << ::GetLastError() << std::endl;
+    }
+  }
+}
+
+ThreadScheduling::~ThreadScheduling() {
+  if (mmcss_handle_) {
+    ::AvRevertMmThreadCharacteristics(mmcss_handle_);
+  }
+}
@@ -0,0 +1,47 @@
+#ifndef THREAD_SCHEDULING_H_
+#define THREAD_SCHEDULING_H_
+
+#include <windows.h>
+
+#include "runner_configuration.h"
+
+// Applies the runner configuration's thread scheduling settings for as long
+// as it exists. They are opt-in, and nothing changes unless mmcss_task or
+// process_priority is set.
+//
+// mmcss_task registers the run loop (platform) thread with the Multimedia
+// Class Scheduler Service as the given task, such as "Games" or "Playback"
+// (the tasks are listed under HKLM\SOFTWARE\Microsoft\Windows NT\
+// CurrentVersion\Multimedia\SystemProfile\Tasks). MMCSS raises the thread into
+// the task's priority range while leaving a share of each period to the rest
+// of the system.
+//
+// The engine's UI and raster threads are created inside the embedding, so
+// they can't be registered. process_priority ('normal', 'above_normal' or
+// 'high') raises the base priority of every thread in the process instead,
+// which includes them.
+//
+// When either is set, worker_thread_priority() is below normal, so that
+// blocking work on the worker pool yields to the engine's threads.
+class ThreadScheduling {
+ public:
+  // Applies |configuration|'s settings to the process and to the calling
+  // thread, which must be the run loop thread.
+  explicit ThreadScheduling(const RunnerConfiguration& configuration);
+
+  // Removes the MMCSS registration. The process priority is left as is.
+  ~ThreadScheduling();
+
+  // Prevent copying
+  ThreadScheduling(ThreadScheduling const&) = delete;
+  ThreadScheduling& operator=(ThreadScheduling const&) = delete;
+
+  // The priority, in SetThreadPriority terms, for worker threads.
+  int worker_thread_priority() const { return worker_thread_priority_; }
+
+ private:
+  HANDLE mmcss_handle_ = nullptr;
+  int worker_thread_priority_ = THREAD_PRIORITY_NORMAL;
+};
+
+#endif  // THREAD_SCHEDULING_H_
@@ -0,0 +1,51 @@
+#include "utils.h"
+
+#include <windows.h>
+
+std::wstring GetExecutableDirectory() {
+  wchar_t buffer[MAX_PATH];
+  DWORD length = ::GetModuleFileNameW(nullptr, buffer, MAX_PATH);
+  if (length == 0 || length == MAX_PATH) {
+    return std::wstring();
+  }
+  std::wstring path(buffer, length);
+  size_t last_separator_position = path.find_last_of(L'\\');
+  if (last_separator_position == std::wstring::npos) {
+    return std::wstring();
+  }
+  return path.substr(0, last_separator_position + 1);
+}
+
+std::wstring Utf16FromUtf8(const std::string& utf8_string) {
+  if (utf8_string.empty()) {
+    return std::wstring();
+  }
+  int length = ::MultiByteToWideChar(
+      CP_UTF8, MB_ERR_INVALID_CHARS, utf8_string.data(),
+      static_cast<int>(utf8_string.size()), nullptr, 0);
+  if (length <= 0) {
+    return std::wstring();
+  }
+  std::wstring utf16_string(length, L'\0');
+  ::MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, utf8_string.data(),
+                        static_cast<int>(utf8_string.size()),
+                        &utf16_string[0], length);
+  return utf16_string;
+}
+
+std::string Utf8FromUtf16(const std::wstring& utf16_string) {
+  if (utf16_string.empty()) {
+    return std::string();
+  }
+  int length = ::WideCharToMultiByte(
+      CP_UTF8, WC_ERR_INVALID_CHARS, utf16_string.data(),
+      static_cast<int>(utf16_string.size()), nullptr, 0, nullptr, nullptr);
+  if (length <= 0) {
+    return std::string();
+  }
+  std::string utf8_string(length, '\0');
+  ::WideCharToMultiByte(CP_UTF8, WC_ERR_INVALID_CHARS, utf16_string.data(),
+                        static_cast<int>(utf16_string.size()),
+                        &utf8_string[0], length, nullptr, nullptr);
+  return utf8_string;
+}
@@ -0,0 +1,16 @@
+#ifndef UTILS_H_
+#define UTILS_H_
+
+#include <string>
+
+// Returns the directory containing the executable, with a trailing separator,
+// or an empty string on failure.
+std::wstring GetExecutableDirectory();
+
+// Converts |utf8_string| to UTF-16, returning an empty string on failure.
+std::wstring Utf16FromUtf8(const std::string& utf8_string);
+
+// Converts |utf16_string| to UTF-8, returning an empty string on failure.
+std::string Utf8FromUtf16(const std::wstring& utf16_string);
+
+#endif  // UTILS_H_
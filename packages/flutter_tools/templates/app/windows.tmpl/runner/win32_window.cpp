@@ -1,8 +1,14 @@
 #include "win32_window.h"
 
+#include <commctrl.h>
+#include <dwmapi.h>
 #include <flutter_windows.h>
 
+#include <cmath>
+#include <vector>
+
 #include "resource.h"
+#include "startup_trace.h"
 
 namespace {
 
@@ -13,28 +19,121 @@ static int g_active_window_count = 0;
 
 using EnableNonClientDpiScaling = BOOL __stdcall(HWND hwnd);
 
+// The timer used to apply coalesced resizes during a live resize.
+constexpr UINT_PTR kResizeTimerId = 1;
+
+// The refresh rate assumed when the monitor's rate can't be determined.
+constexpr DWORD kDefaultRefreshRate = 60;
+
+// The subclass ID for the child content; see Win32Window::ChildContentProc.
+constexpr UINT_PTR kChildContentSubclassId = 1;
+
+// The maximum number of coalesced pointer samples replayed per update. At
+// 1000 Hz this is more than a frame's worth even at 30 fps.
+constexpr UINT32 kMaxPointerHistory = 64;
+
 // Scale helper to convert logical scaler values to physical using passed in
 // scale factor
 int Scale(int source, double scale_factor) {
   return static_cast<int>(source * scale_factor);
 }
 
-// Dynamically loads the |EnableNonClientDpiScaling| from the User32 module.
-// This API is only needed for PerMonitor V1 awareness mode.
+// Returns the |EnableNonClientDpiScaling| function from the User32 module, or
+// nullptr if it isn't available. This API is only needed for PerMonitor V1
+// awareness mode.
+//
+// The lookup is done once, since it's needed for every window. User32 is
+// always loaded in GUI processes, so this doesn't take a module reference.
+EnableNonClientDpiScaling* GetEnableNonClientDpiScaling() {
+  static EnableNonClientDpiScaling* enable_non_client_dpi_scaling =
+      []() -> EnableNonClientDpiScaling* {
+    HMODULE user32_module = GetModuleHandleA("User32.dll");
+    if (!user32_module) {
+      return nullptr;
+    }
+    return reinterpret_cast<EnableNonClientDpiScaling*>(
+        GetProcAddress(user32_module, "EnableNonClientDpiScaling"));
+  }();
+  return enable_non_client_dpi_scaling;
+}
+
+using EnableMouseInPointerProc = BOOL __stdcall(BOOL enable);
+using GetPointerTypeProc = BOOL __stdcall(UINT32 pointer_id,
+                                          POINTER_INPUT_TYPE* pointer_type);
+using GetPointerInfoHistoryProc = BOOL __stdcall(UINT32 pointer_id,
+                                                 UINT32* entries_count,
+                                                 POINTER_INFO* pointer_info);
+
+// The pointer input functions used for pointer history, which only exist on
+// Windows 8 and later.
+struct PointerFunctions {
+  EnableMouseInPointerProc* enable_mouse_in_pointer = nullptr;
+  GetPointerTypeProc* get_pointer_type = nullptr;
+  GetPointerInfoHistoryProc* get_pointer_info_history = nullptr;
+};
+
+// Returns the pointer input functions from the User32 module. They are looked
+// up rather than imported, so that the runner still loads on Windows 7. If
+// any is missing, they are all nullptr.
+const PointerFunctions& GetPointerFunctions() {
+  static const PointerFunctions pointer_functions = []() {
+    PointerFunctions functions;
+    HMODULE user32_module = GetModuleHandleA("User32.dll");
+    if (!user32_module) {
+      return functions;
+    }
+    functions.enable_mouse_in_pointer =
+        reinterpret_cast<EnableMouseInPointerProc*>(
+            GetProcAddress(user32_module, "EnableMouseInPointer"));
+    functions.get_pointer_type = reinterpret_cast<GetPointerTypeProc*>(
+        GetProcAddress(user32_module, "GetPointerType"));
+    functions.get_pointer_info_history =
+        reinterpret_cast<GetPointerInfoHistoryProc*>(
+            GetProcAddress(user32_module, "GetPointerInfoHistory"));
+    if (!functions.enable_mouse_in_pointer || !functions.get_pointer_type ||
+        !functions.get_pointer_info_history) {
+      return PointerFunctions();
+    }
+    return functions;
+  }();
+  return pointer_functions;
+}
+
+// Enables non-client DPI scaling for |hwnd|, if available.
 void EnableFullDpiSupportIfAvailable(HWND hwnd) {
-  HMODULE user32_module = LoadLibraryA("User32.dll");
-  if (!user32_module) {
-    return;
-  }
-  auto enable_non_client_dpi_scaling =
-      reinterpret_cast<EnableNonClientDpiScaling*>(
-          GetProcAddress(user32_module, "EnableNonClientDpiScaling"));
+  EnableNonClientDpiScaling* enable_non_client_dpi_scaling =
+      GetEnableNonClientDpiScaling();
   if (enable_non_client_dpi_scaling != nullptr) {
     enable_non_client_dpi_scaling(hwnd);
-    FreeLibrary(user32_module);
   }
 }
 
+// Returns the refresh rate of the monitor |hwnd| is on, in Hz.
+DWORD GetRefreshRate(HWND hwnd) {
+  DWORD refresh_rate = kDefaultRefreshRate;
+  MONITORINFOEX monitor_info{};
+  monitor_info.cbSize = sizeof(monitor_info);
+  if (GetMonitorInfo(MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST),
+                     &monitor_info)) {
+    DEVMODE device_mode{};
+    device_mode.dmSize = sizeof(device_mode);
+    // Values of 0 and 1 mean the hardware's default rate.
+    if (EnumDisplaySettings(monitor_info.szDevice, ENUM_CURRENT_SETTINGS,
+                            &device_mode) &&
+        device_mode.dmDisplayFrequency > 1) {
+      refresh_rate = device_mode.dmDisplayFrequency;
+    }
+  }
+  return refresh_rate;
+}
+
+// Returns the refresh interval of the monitor |hwnd| is on, in whole
+// milliseconds.
+UINT GetRefreshIntervalMilliseconds(HWND hwnd) {
+  UINT interval = 1000 / GetRefreshRate(hwnd);
+  return interval < USER_TIMER_MINIMUM ? USER_TIMER_MINIMUM : interval;
+}
+
 }  // namespace
 
 // Manages the Win32Window's window class registration.
@@ -70,6 +169,7 @@ WindowClassRegistrar* WindowClassRegistrar::instance_ = nullptr;
 
 const wchar_t* WindowClassRegistrar::GetWindowClass() {
   if (!class_registered_) {
+    StartupTrace::Scope scope("RegisterWindowClass");
     WNDCLASS window_class{};
     window_class.hCursor = LoadCursor(nullptr, IDC_ARROW);
     window_class.lpszClassName = kWindowClassName;
@@ -116,15 +216,30 @@ bool Win32Window::CreateAndShow(const std::wstring& title,
   UINT dpi = FlutterDesktopGetDpiForMonitor(monitor);
   double scale_factor = dpi / 96.0;
 
-  HWND window = CreateWindow(
-      window_class, title.c_str(), WS_OVERLAPPEDWINDOW | WS_VISIBLE,
-      Scale(origin.x, scale_factor), Scale(origin.y, scale_factor),
-      Scale(size.width, scale_factor), Scale(size.height, scale_factor),
-      nullptr, nullptr, GetModuleHandle(nullptr), this);
+  HWND window;
+  {
+    StartupTrace::Scope scope("CreateWindow");
+    // The window is created hidden, so that the OS doesn't paint the empty
+    // window, and so that content added by OnCreate is sized once at the
+    // final window size rather than going through intermediate resizes.
+    window = CreateWindow(
+        window_class, title.c_str(), WS_OVERLAPPEDWINDOW,
+        Scale(origin.x, scale_factor), Scale(origin.y, scale_factor),
+        Scale(size.width, scale_factor), Scale(size.height, scale_factor),
+        nullptr, nullptr, GetModuleHandle(nullptr), this);
+  }
+  if (!window) {
+    return false;
+  }
+  dpi_ = FlutterDesktopGetDpiForHWND(window);
 
   OnCreate();
 
-  return window != nullptr;
+  if (!show_deferred_) {
+    Show();
+  }
+
+  return true;
 }
 
 // static
@@ -141,6 +256,9 @@ LRESULT CALLBACK Win32Window::WndProc(HWND const window,
     EnableFullDpiSupportIfAvailable(window);
     that->window_handle_ = window;
   } else if (Win32Window* that = GetThisFromHandle(window)) {
+    if (that->message_observer_) {
+      that->message_observer_(message, wparam, lparam);
+    }
     return that->MessageHandler(window, message, wparam, lparam);
   }
 
@@ -172,22 +290,81 @@ Win32Window::MessageHandler(HWND hwnd,
       auto newRectSize = reinterpret_cast<RECT*>(lparam);
       LONG newWidth = newRectSize->right - newRectSize->left;
       LONG newHeight = newRectSize->bottom - newRectSize->top;
-
+      UINT new_dpi = HIWORD(wparam);
+
+      // When the window keeps its logical size, as it does when dragged
+      // between monitors with different scales, only the scale has changed.
+      // The physical size still changes with it, but the content's layout
+      // doesn't, and it redraws at the new scale anyway, so the resulting
+      // WM_SIZE doesn't force a synchronous repaint at the old scale.
+      RECT current_rect;
+      GetWindowRect(hwnd, &current_rect);
+      double old_scale = dpi_ / 96.0;
+      double new_scale = new_dpi / 96.0;
+      bool scale_only =
+          std::abs((current_rect.right - current_rect.left) / old_scale -
+                   newWidth / new_scale) < 1.0 &&
+          std::abs((current_rect.bottom - current_rect.top) / old_scale -
+                   newHeight / new_scale) < 1.0;
+      dpi_ = new_dpi;
+
+      handling_dpi_change_ = scale_only;
       SetWindowPos(hwnd, nullptr, newRectSize->left, newRectSize->top, newWidth,
                    newHeight, SWP_NOZORDER | SWP_NOACTIVATE);
+      handling_dpi_change_ = false;
 
       return 0;
     }
     case WM_SIZE:
-      RECT rect;
-      GetClientRect(hwnd, &rect);
-      if (child_content_ != nullptr) {
-        // Size and position the child window.
-        MoveWindow(child_content_, rect.left, rect.top, rect.right - rect.left,
-                   rect.bottom - rect.top, TRUE);
+      minimized_ = wparam == SIZE_MINIMIZED;
+      UpdateOcclusionState();
+      if (minimized_) {
+        // Leave the content at its last size, rather than laying it out at a
+        // zero size that is never seen.
+        return 0;
       }
+      if (resize_coalescing_enabled_ && in_size_move_) {
+        // Applied by the resize timer, at most once per display refresh.
+        resize_pending_ = true;
+        return 0;
+      }
+      ResizeChildContent(!resize_coalescing_enabled_ && !handling_dpi_change_);
       return 0;
 
+    case WM_ENTERSIZEMOVE:
+      in_size_move_ = true;
+      if (resize_coalescing_enabled_) {
+        SetTimer(hwnd, kResizeTimerId, GetRefreshIntervalMilliseconds(hwnd),
+                 nullptr);
+      }
+      break;
+
+    case WM_EXITSIZEMOVE:
+      in_size_move_ = false;
+      KillTimer(hwnd, kResizeTimerId);
+      if (resize_pending_) {
+        resize_pending_ = false;
+        ResizeChildContent(false);
+      }
+      break;
+
+    case WM_TIMER:
+      if (wparam == kResizeTimerId) {
+        if (resize_pending_) {
+          resize_pending_ = false;
+          ResizeChildContent(false);
+        }
+        return 0;
+      }
+      break;
+
+    // Cloaking (e.g., when switching virtual desktops) doesn't have its own
+    // message, so re-check it when the window's state might have changed.
+    case WM_WINDOWPOSCHANGED:
+    case WM_ACTIVATEAPP:
+      UpdateOcclusionState();
+      break;
+
     case WM_ACTIVATE:
       if (child_content_ != nullptr) {
         SetFocus(child_content_);
@@ -222,6 +399,9 @@ Win32Window* Win32Window::GetThisFromHandle(HWND const window) noexcept {
 
 void Win32Window::SetChildContent(HWND content) {
   child_content_ = content;
+  if (pointer_history_enabled_) {
+    SetWindowSubclass(content, ChildContentProc, kChildContentSubclassId, 0);
+  }
   SetParent(content, window_handle_);
   RECT frame;
   GetClientRect(window_handle_, &frame);
@@ -236,10 +416,139 @@ HWND Win32Window::GetHandle() {
   return window_handle_;
 }
 
+void Win32Window::Show() {
+  if (window_handle_ && !IsWindowVisible(window_handle_)) {
+    ShowWindow(window_handle_, SW_SHOWNORMAL);
+  }
+}
+
+std::chrono::nanoseconds Win32Window::GetRefreshInterval() {
+  return std::chrono::nanoseconds(std::chrono::seconds(1)) /
+         GetRefreshRate(window_handle_);
+}
+
+void Win32Window::SetShowDeferred(bool show_deferred) {
+  show_deferred_ = show_deferred;
+}
+
+void Win32Window::SetResizeCoalescingEnabled(bool enabled) {
+  resize_coalescing_enabled_ = enabled;
+}
+
+bool Win32Window::SetPointerHistoryEnabled(bool enabled) {
+  if (!enabled) {
+    pointer_history_enabled_ = false;
+    return true;
+  }
+  const PointerFunctions& pointer_functions = GetPointerFunctions();
+  if (!pointer_functions.enable_mouse_in_pointer) {
+    return false;
+  }
+  // Mouse input is promoted to WM_POINTER for the whole thread. Pointer
+  // messages the embedding doesn't handle are turned back into mouse
+  // messages by DefWindowProc, so the embedding keeps receiving them.
+  pointer_functions.enable_mouse_in_pointer(TRUE);
+  pointer_history_enabled_ = true;
+  return true;
+}
+
+// static
+LRESULT CALLBACK
+Win32Window::ChildContentProc(HWND window,
+                              UINT message,
+                              WPARAM wparam,
+                              LPARAM lparam,
+                              UINT_PTR subclass_id,
+                              DWORD_PTR reference_data) noexcept {
+  switch (message) {
+    case WM_POINTERUPDATE:
+      ReplayPointerHistory(window, wparam);
+      break;
+    case WM_NCDESTROY:
+      RemoveWindowSubclass(window, ChildContentProc, subclass_id);
+      break;
+  }
+  return DefSubclassProc(window, message, wparam, lparam);
+}
+
+// static
+void Win32Window::ReplayPointerHistory(HWND content, WPARAM wparam) {
+  const PointerFunctions& pointer_functions = GetPointerFunctions();
+  UINT32 pointer_id = GET_POINTERID_WPARAM(wparam);
+  POINTER_INPUT_TYPE pointer_type;
+  // Touch isn't handled by the embedding, and is left as it is.
+  if (!pointer_functions.get_pointer_type(pointer_id, &pointer_type) ||
+      (pointer_type != PT_MOUSE && pointer_type != PT_PEN)) {
+    return;
+  }
+  // History is returned newest first, and the newest entry is the current
+  // update, which DefWindowProc turns into a mouse move as usual.
+  UINT32 count = kMaxPointerHistory;
+  std::vector<POINTER_INFO> history(count);
+  if (!pointer_functions.get_pointer_info_history(pointer_id, &count,
+                                                  history.data()) ||
+      count < 2) {
+    return;
+  }
+  count = count > kMaxPointerHistory ? kMaxPointerHistory : count;
+  for (UINT32 i = count - 1; i > 0; --i) {
+    const POINTER_INFO& sample = history[i];
+    if (!(sample.pointerFlags & POINTER_FLAG_UPDATE)) {
+      continue;
+    }
+    POINT point = sample.ptPixelLocation;
+    ScreenToClient(content, &point);
+    WPARAM keys = 0;
+    if (sample.pointerFlags & POINTER_FLAG_FIRSTBUTTON) {
+      keys |= MK_LBUTTON;
+    }
+    if (sample.pointerFlags & POINTER_FLAG_SECONDBUTTON) {
+      keys |= MK_RBUTTON;
+    }
+    if (sample.pointerFlags & POINTER_FLAG_THIRDBUTTON) {
+      keys |= MK_MBUTTON;
+    }
+    SendMessage(content, WM_MOUSEMOVE, keys, MAKELPARAM(point.x, point.y));
+  }
+}
+
+void Win32Window::ResizeChildContent(bool repaint) {
+  if (child_content_ == nullptr) {
+    return;
+  }
+  RECT rect;
+  GetClientRect(window_handle_, &rect);
+  // Size and position the child window.
+  MoveWindow(child_content_, rect.left, rect.top, rect.right - rect.left,
+             rect.bottom - rect.top, repaint);
+}
+
 void Win32Window::SetQuitOnClose(bool quit_on_close) {
   quit_on_close_ = quit_on_close;
 }
 
+void Win32Window::SetMessageObserver(
+    std::function<void(UINT message, WPARAM wparam, LPARAM lparam)> observer) {
+  message_observer_ = std::move(observer);
+}
+
+bool Win32Window::IsOccluded() {
+  return occluded_;
+}
+
+void Win32Window::UpdateOcclusionState() {
+  BOOL cloaked = FALSE;
+  if (FAILED(DwmGetWindowAttribute(window_handle_, DWMWA_CLOAKED, &cloaked,
+                                   sizeof(cloaked)))) {
+    cloaked = FALSE;
+  }
+  bool occluded = minimized_ || cloaked;
+  if (occluded != occluded_) {
+    occluded_ = occluded;
+    OnOcclusionChanged(occluded);
+  }
+}
+
 void Win32Window::OnCreate() {
   // No-op; provided for subclasses.
 }
@@ -247,3 +556,7 @@ void Win32Window::OnCreate() {
 void Win32Window::OnDestroy() {
   // No-op; provided for subclasses.
 }
+
+void Win32Window::OnOcclusionChanged(bool occluded) {
+  // No-op; provided for subclasses.
+}
@@ -4,6 +4,7 @@
 #include <Windows.h>
 #include <Windowsx.h>
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
@@ -35,6 +36,9 @@ class Win32Window {
   // consistent size to will treat the width height passed in to this function
   // as logical pixels and scale to appropriate for the default monitor. Returns
   // true if the window was created successfully.
+  //
+  // The window is shown after OnCreate returns, unless SetShowDeferred has
+  // been called, in which case it is shown by a later call to Show.
   bool CreateAndShow(const std::wstring& title,
                      const Point& origin,
                      const Size& size);
@@ -49,9 +53,49 @@ class Win32Window {
   // window properties. Returns nullptr if the window has been destroyed.
   HWND GetHandle();
 
+  // Shows the window, if it isn't already visible.
+  void Show();
+
+  // Returns the refresh interval of the monitor the window is on, or of a
+  // 60Hz display if it can't be determined.
+  std::chrono::nanoseconds GetRefreshInterval();
+
+  // If true, CreateAndShow leaves the window hidden, and the caller or
+  // subclass is responsible for calling Show (e.g., once the window's content
+  // is ready to be displayed). Must be set before calling CreateAndShow.
+  void SetShowDeferred(bool show_deferred);
+
+  // If true, size changes during a live resize (between WM_ENTERSIZEMOVE and
+  // WM_EXITSIZEMOVE) are batched and applied to the child content at most
+  // once per display refresh, and without forcing a synchronous repaint.
+  void SetResizeCoalescingEnabled(bool enabled);
+
+  // If true, mouse and pen input is received as WM_POINTER messages, and the
+  // samples Windows coalesces into each WM_POINTERUPDATE (which would
+  // otherwise be lost, as coalesced WM_MOUSEMOVEs are) are replayed to the
+  // child content in order before the update itself. This preserves the full
+  // resolution of high-rate mice and pen tablets, e.g., for inking.
+  //
+  // Pointer input is switched on for the whole process, and can't be
+  // switched off again, so this must be called before CreateAndShow. Returns
+  // false if pointer input isn't available (before Windows 8), in which case
+  // input keeps arriving as mouse messages.
+  bool SetPointerHistoryEnabled(bool enabled);
+
+  // Returns true if the window is minimized or cloaked, so none of its content
+  // is visible.
+  bool IsOccluded();
+
   // If true, closing this window will quit the application.
   void SetQuitOnClose(bool quit_on_close);
 
+  // Sets a function called with each message sent or posted to this window
+  // (but not to the child content), before it's handled. Pass nullptr to
+  // remove it.
+  void SetMessageObserver(
+      std::function<void(UINT message, WPARAM wparam, LPARAM lparam)>
+          observer);
+
  protected:
   // Processes and route salient window messages for mouse handling,
   // size change and DPI. Delegates handling of these to member overloads that
@@ -68,6 +112,11 @@ class Win32Window {
   // Called when Destroy is called.
   virtual void OnDestroy();
 
+  // Called when the window becomes occluded (minimized or cloaked), or stops
+  // being occluded. Subclasses can use this to stop producing content that
+  // can't be seen.
+  virtual void OnOcclusionChanged(bool occluded);
+
  private:
   friend class WindowClassRegistrar;
 
@@ -81,11 +130,56 @@ class Win32Window {
                                   WPARAM const wparam,
                                   LPARAM const lparam) noexcept;
 
+  // Recomputes whether the window is occluded, calling OnOcclusionChanged if
+  // that has changed.
+  void UpdateOcclusionState();
+
+  // Subclass procedure for the child content, which replays coalesced
+  // pointer samples; see SetPointerHistoryEnabled.
+  static LRESULT CALLBACK ChildContentProc(HWND window,
+                                           UINT message,
+                                           WPARAM wparam,
+                                           LPARAM lparam,
+                                           UINT_PTR subclass_id,
+                                           DWORD_PTR reference_data) noexcept;
+
+  // Sends the samples coalesced into the WM_POINTERUPDATE described by
+  // |wparam| to |content| as mouse moves, oldest first.
+  static void ReplayPointerHistory(HWND content, WPARAM wparam);
+
+  // Sizes the child content to fill the client area, synchronously
+  // repainting it if |repaint| is true.
+  void ResizeChildContent(bool repaint);
+
   // Retrieves a class instance pointer for |window|
   static Win32Window* GetThisFromHandle(HWND const window) noexcept;
 
   bool quit_on_close_ = false;
 
+  bool show_deferred_ = false;
+
+  // Resize coalescing state; see SetResizeCoalescingEnabled.
+  bool resize_coalescing_enabled_ = false;
+  bool in_size_move_ = false;
+  bool resize_pending_ = false;
+
+  // See SetPointerHistoryEnabled.
+  bool pointer_history_enabled_ = false;
+
+  // Occlusion state; see IsOccluded.
+  bool minimized_ = false;
+  bool occluded_ = false;
+
+  // The window's current DPI, updated by WM_DPICHANGED.
+  UINT dpi_ = 96;
+
+  // True while applying the window rect suggested by a WM_DPICHANGED that
+  // only changes the scale.
+  bool handling_dpi_change_ = false;
+
+  // See SetMessageObserver.
+  std::function<void(UINT, WPARAM, LPARAM)> message_observer_;
+
   // window handle for top level window.
   HWND window_handle_ = nullptr;
 
@@ -0,0 +1,161 @@
+#include "worker_pool.h"
+
+#include <atomic>
+#include <shared_mutex>
+
+namespace {
+
+// The pool used by FlutterRunnerPostWorkerTask, which can be called from any
+// thread. It holds g_plugin_worker_pool_mutex shared while it uses the pool,
+// and the pool is only changed with the mutex held exclusively, so a pool
+// isn't destroyed while another thread is posting to it.
+std::atomic<WorkerPool*> g_plugin_worker_pool{nullptr};
+std::shared_timed_mutex g_plugin_worker_pool_mutex;
+
+// Wraps |callback|, a C callback from FlutterRunnerPostWorkerTask, or returns
+// nullptr if it is null.
+std::function<void()> BindUserData(void (*callback)(void* user_data),
+                                   void* user_data) {
+  if (!callback) {
+    return nullptr;
+  }
+  return [callback, user_data]() { callback(user_data); };
+}
+
+}  // namespace
+
+WorkerPool::WorkerPool(RunLoop* run_loop, size_t thread_count)
+    : run_loop_(run_loop), max_thread_count_(thread_count) {}
+
+WorkerPool::~WorkerPool() {
+  {
+    // Waits for plugin threads that are posting to this pool.
+    std::unique_lock<std::shared_timed_mutex> lock(g_plugin_worker_pool_mutex);
+    WorkerPool* pool = this;
+    g_plugin_worker_pool.compare_exchange_strong(pool, nullptr);
+  }
+  std::deque<Task> cancelled_tasks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutting_down_ = true;
+    cancelled_tasks.swap(pending_tasks_);
+  }
+  work_available_.notify_all();
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+  // Replies that haven't run yet, including those of work that finished
+  // during shutdown, won't run now.
+  for (Task& task : completed_tasks_) {
+    cancelled_tasks.push_back(std::move(task));
+  }
+  completed_tasks_.clear();
+  for (const Task& task : cancelled_tasks) {
+    if (task.cancel) {
+      task.cancel();
+    }
+  }
+}
+
+void WorkerPool::PostTask(std::function<void()> work,
+                          std::function<void()> reply,
+                          std::function<void()> cancel) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!shutting_down_) {
+      pending_tasks_.push_back(
+          {std::move(work), std::move(reply), std::move(cancel)});
+      if (idle_thread_count_ == 0 && threads_.size() < max_thread_count_) {
+        threads_.emplace_back(&WorkerPool::WorkerMain, this);
+      }
+      cancel = nullptr;
+    }
+  }
+  if (cancel) {
+    cancel();
+    return;
+  }
+  work_available_.notify_one();
+}
+
+void WorkerPool::SetWorkerThreadPriority(int priority) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  thread_priority_ = priority;
+}
+
+// static
+void WorkerPool::SetPluginWorkerPool(WorkerPool* pool) {
+  std::unique_lock<std::shared_timed_mutex> lock(g_plugin_worker_pool_mutex);
+  g_plugin_worker_pool = pool;
+}
+
+void WorkerPool::WorkerMain() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (thread_priority_ != THREAD_PRIORITY_NORMAL) {
+    ::SetThreadPriority(::GetCurrentThread(), thread_priority_);
+  }
+  while (true) {
+    ++idle_thread_count_;
+    work_available_.wait(lock, [this]() {
+      return shutting_down_ || !pending_tasks_.empty();
+    });
+    --idle_thread_count_;
+    if (shutting_down_) {
+      return;
+    }
+    Task task = std::move(pending_tasks_.front());
+    pending_tasks_.pop_front();
+
+    lock.unlock();
+    task.work();
+    lock.lock();
+    // The reply (or, at shutdown, cancel) is run from completed_tasks_, so
+    // that it isn't lost if the run loop stops before running it.
+    if (!task.reply) {
+      continue;
+    }
+    completed_tasks_.push_back(std::move(task));
+    if (!shutting_down_) {
+      std::weak_ptr<int> alive = alive_;
+      run_loop_->PostTask([this, alive]() {
+        if (!alive.expired()) {
+          RunCompletedReply();
+        }
+      });
+    }
+  }
+}
+
+void WorkerPool::RunCompletedReply() {
+  Task task;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (completed_tasks_.empty()) {
+      return;
+    }
+    task = std::move(completed_tasks_.front());
+    completed_tasks_.pop_front();
+  }
+  if (task.reply) {
+    task.reply();
+  }
+}
+
+void FlutterRunnerPostWorkerTask(void (*work)(void* user_data),
+                                 void (*reply)(void* user_data),
+                                 void (*cancel)(void* user_data),
+                                 void* user_data) {
+  std::shared_lock<std::shared_timed_mutex> lock(g_plugin_worker_pool_mutex);
+  WorkerPool* pool = g_plugin_worker_pool;
+  if (!pool) {
+    // The pool hasn't been set up yet or is being shut down, so the reply
+    // can't be run on the run loop thread.
+    lock.unlock();
+    if (cancel) {
+      cancel(user_data);
+    }
+    return;
+  }
+  pool->PostTask(BindUserData(work, user_data), BindUserData(reply, user_data),
+                 BindUserData(cancel, user_data));
+}
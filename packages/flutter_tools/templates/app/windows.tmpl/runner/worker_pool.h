@@ -0,0 +1,108 @@
+#ifndef WORKER_POOL_H_
+#define WORKER_POOL_H_
+
+#include <windows.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "run_loop.h"
+
+// A pool of background threads for blocking work (file I/O, registry access,
+// etc.), so that it doesn't stall window messages and engine tasks on the run
+// loop thread. Replies are run back on the run loop thread.
+class WorkerPool {
+ public:
+  // Creates a pool of up to |thread_count| threads, which delivers replies on
+  // |run_loop|. Threads are started as work is posted.
+  WorkerPool(RunLoop* run_loop, size_t thread_count);
+
+  // Waits for any work that is in progress to finish. Tasks whose reply
+  // hasn't run, including those whose work hasn't started (which is
+  // discarded), have their |cancel| callback (see PostTask) called instead.
+  // Any state the callbacks use must outlive the pool.
+  ~WorkerPool();
+
+  // Prevent copying
+  WorkerPool(WorkerPool const&) = delete;
+  WorkerPool& operator=(WorkerPool const&) = delete;
+
+  // Runs |work| on a worker thread and then, if provided, |reply| on the run
+  // loop thread. If the pool is destroyed before |reply| runs, |cancel|, if
+  // provided, is called instead of it, on the thread destroying the pool (or,
+  // if the pool is already being destroyed, on the calling thread). |work|
+  // will then have run only if it had already started. So exactly one of
+  // |reply| and |cancel| is called. Without a |reply|, |cancel| is only
+  // called if |work| doesn't run.
+  //
+  // This may be called from any thread.
+  void PostTask(std::function<void()> work,
+                std::function<void()> reply = nullptr,
+                std::function<void()> cancel = nullptr);
+
+  // Sets the SetThreadPriority priority of threads started after this call.
+  // Threads start at THREAD_PRIORITY_NORMAL by default.
+  void SetWorkerThreadPriority(int priority);
+
+  // Sets the pool used by FlutterRunnerPostWorkerTask, or nullptr to make
+  // FlutterRunnerPostWorkerTask cancel every task. Waits for any calls
+  // to FlutterRunnerPostWorkerTask in progress. A pool that is in use is
+  // cleared when it is destroyed, in the same way.
+  static void SetPluginWorkerPool(WorkerPool* pool);
+
+ private:
+  struct Task {
+    std::function<void()> work;
+    std::function<void()> reply;
+    std::function<void()> cancel;
+  };
+
+  // The main function for each worker thread.
+  void WorkerMain();
+
+  // Runs the reply of the oldest task in completed_tasks_, on the run loop
+  // thread.
+  void RunCompletedReply();
+
+  RunLoop* run_loop_;
+  size_t max_thread_count_;
+  std::vector<std::thread> threads_;
+
+  // Guards all members below.
+  std::mutex mutex_;
+  std::condition_variable work_available_;
+  std::deque<Task> pending_tasks_;
+  // Tasks whose work has finished, waiting for their reply to run.
+  std::deque<Task> completed_tasks_;
+  size_t idle_thread_count_ = 0;
+  int thread_priority_ = THREAD_PRIORITY_NORMAL;
+  bool shutting_down_ = false;
+
+  // Lets tasks posted to the run loop detect that the pool has been
+  // destroyed.
+  std::shared_ptr<int> alive_ = std::make_shared<int>(0);
+};
+
+// Entry point for plugins, which are built separately from the runner and so
+// can't use WorkerPool directly. Plugins can look it up with:
+//   GetProcAddress(GetModuleHandle(nullptr), "FlutterRunnerPostWorkerTask")
+//
+// Runs |work| on the runner's worker pool, then |reply| (if not null) on the
+// run loop thread, passing |user_data| to both. If the runner is shutting
+// down, or hasn't set up its pool yet, before |reply| can run, |cancel| (if
+// not null) is called with |user_data| instead of |reply|, so that it can be
+// released; |work| may not have run. Exactly one of |reply| and |cancel| is
+// called, or, with a null |reply|, one of |work| and |cancel|. This may be
+// called from any thread.
+extern "C" __declspec(dllexport) void FlutterRunnerPostWorkerTask(
+    void (*work)(void* user_data),
+    void (*reply)(void* user_data),
+    void (*cancel)(void* user_data),
+    void* user_data);
+
+#endif  // WORKER_POOL_H_
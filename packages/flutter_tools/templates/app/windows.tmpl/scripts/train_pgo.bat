@@ -0,0 +1,31 @@
+@echo off
+
+:: Trains a runner built with FlutterPgoMode set to Instrument by launching it
+:: several times and closing it once startup has settled. Each run that exits
+:: normally writes a .pgc file next to the profile database, which the
+:: Optimize build merges.
+::
+:: Usage: train_pgo.bat <path to runner exe> [runs] [seconds per run]
+set EXE_PATH=%~1
+set RUNS=%~2
+set RUN_SECONDS=%~3
+if "%EXE_PATH%"=="" (
+  echo Usage: %~nx0 ^<path to runner exe^> [runs] [seconds per run]
+  exit /b 1
+)
+if "%RUNS%"=="" set RUNS=5
+if "%RUN_SECONDS%"=="" set RUN_SECONDS=10
+
+:: Instrumented binaries need the PGO runtime, which ships with the compiler.
+if defined VCToolsInstallDir set PATH=%VCToolsInstallDir%bin\Hostx64\x64;%PATH%
+
+for /l %%i in (1,1,%RUNS%) do (
+  echo PGO training run %%i of %RUNS%
+  start "" "%EXE_PATH%"
+  call timeout /t %RUN_SECONDS% /nobreak >nul
+  rem Close the window rather than killing the process, so that the profile
+  rem counts are written on exit.
+  call taskkill /im "%~nx1" >nul
+  call timeout /t 2 /nobreak >nul
+)
+exit /b 0
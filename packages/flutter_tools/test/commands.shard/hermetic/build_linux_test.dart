@@ -164,6 +164,43 @@ void main() {
     FeatureFlags: () => TestFeatureFlags(isLinuxEnabled: true),
   });
 
+  testUsingContext('Linux build does not rewrite an unchanged generated config', () async {
+    final BuildCommand command = BuildCommand();
+    processManager = FakeProcessManager.list(<FakeCommand>[
+      const FakeCommand(command: <String>[
+        'make',
+        '-C',
+        '/linux',
+        'BUILD=release',
+      ]),
+      const FakeCommand(command: <String>[
+        'make',
+        '-C',
+        '/linux',
+        'BUILD=release',
+      ]),
+    ]);
+
+    setUpMockProjectFilesForBuild();
+
+    await createTestCommandRunner(command).run(
+      const <String>['build', 'linux']
+    );
+    final File configFile = fileSystem.file('linux/flutter/ephemeral/generated_config.mk');
+    final DateTime lastModified = DateTime(2000);
+    configFile.setLastModifiedSync(lastModified);
+    await createTestCommandRunner(BuildCommand()).run(
+      const <String>['build', 'linux']
+    );
+
+    expect(configFile.lastModifiedSync(), lastModified);
+  }, overrides: <Type, Generator>{
+    FileSystem: () => fileSystem,
+    ProcessManager: () => processManager,
+    Platform: () => linuxPlatform,
+    FeatureFlags: () => TestFeatureFlags(isLinuxEnabled: true),
+  });
+
   testUsingContext('Handles argument error from missing make', () async {
     final BuildCommand command = BuildCommand();
     setUpMockProjectFilesForBuild();
@@ -216,5 +216,55 @@ void main() {
         throwsToolExit(message: 'Invalid "android" plugin specification.'),
       );
     });
+
+    test('iOS channels are parsed for lazy registration', () {
+      const String pluginYamlRaw =
+          'platforms:\n'
+          ' ios:\n'
+          '  pluginClass: ISamplePlugin\n'
+          '  channels:\n'
+          '   - plugins.flutter.io/sample\n'
+          '   - plugins.flutter.io/sample_events\n';
+
+      final YamlMap pluginYaml = loadYaml(pluginYamlRaw) as YamlMap;
+      final Plugin plugin =
+          Plugin.fromYaml(_kTestPluginName, _kTestPluginPath, pluginYaml, const <String>[]);
+      final IOSPlugin iosPlugin = plugin.platforms[IOSPlugin.kConfigKey] as IOSPlugin;
+
+      expect(iosPlugin.channels, <String>[
+        'plugins.flutter.io/sample',
+        'plugins.flutter.io/sample_events',
+      ]);
+      expect(iosPlugin.toMap()['lazy'], isTrue);
+    });
+
+    test('iOS plugins without channels are registered eagerly', () {
+      const String pluginYamlRaw =
+          'platforms:\n'
+          ' ios:\n'
+          '  pluginClass: ISamplePlugin\n';
+
+      final YamlMap pluginYaml = loadYaml(pluginYamlRaw) as YamlMap;
+      final Plugin plugin =
+          Plugin.fromYaml(_kTestPluginName, _kTestPluginPath, pluginYaml, const <String>[]);
+      final IOSPlugin iosPlugin = plugin.platforms[IOSPlugin.kConfigKey] as IOSPlugin;
+
+      expect(iosPlugin.channels, isEmpty);
+      expect(iosPlugin.toMap()['lazy'], isFalse);
+    });
+
+    test('error on non-string iOS channels', () {
+      const String pluginYamlRaw =
+          'platforms:\n'
+          ' ios:\n'
+          '  pluginClass: ISamplePlugin\n'
+          '  channels: plugins.flutter.io/sample\n';
+
+      final YamlMap pluginYaml = loadYaml(pluginYamlRaw) as YamlMap;
+      expect(
+            () => Plugin.fromYaml(_kTestPluginName, _kTestPluginPath, pluginYaml, const <String>[]),
+        throwsToolExit(message: 'Invalid "ios" plugin specification.'),
+      );
+    });
   });
 }
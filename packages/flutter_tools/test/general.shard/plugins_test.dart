@@ -908,6 +908,38 @@ flutter:
         FeatureFlags: () => featureFlags,
       });
 
+      testUsingContext('Injecting creates generated iOS registrant that registers plugins with channels lazily', () async {
+        when(iosProject.existsSync()).thenReturn(true);
+        when(flutterProject.isModule).thenReturn(true);
+        dummyPackageDirectory.parent.childFile('pubspec.yaml')
+          ..createSync(recursive: true)
+          ..writeAsStringSync('''
+flutter:
+  plugin:
+    platforms:
+      ios:
+        pluginClass: FLESomePlugin
+        channels:
+          - plugins.flutter.io/some_plugin
+    ''');
+
+        await injectPlugins(flutterProject, checkProjects: true);
+
+        final File registrantFile = iosProject.pluginRegistrantHost
+          .childDirectory('Classes')
+          .childFile('GeneratedPluginRegistrant.m');
+
+        expect(registrantFile.existsSync(), isTrue);
+        final String registrant = registrantFile.readAsStringSync();
+        expect(registrant, contains('[FLESomePlugin registerWithRegistrar:[registry registrarForPlugin:@"FLESomePlugin"]];'));
+        expect(registrant, contains('[FLTLazyPluginRegistration registerPlugin:[FLESomePlugin class]'));
+        expect(registrant, contains('onChannels:@[@"plugins.flutter.io/some_plugin", ]];'));
+      }, overrides: <Type, Generator>{
+        FileSystem: () => fs,
+        ProcessManager: () => FakeProcessManager.any(),
+        FeatureFlags: () => featureFlags,
+      });
+
       testUsingContext('Injecting creates generated Linux registrant', () async {
         when(linuxProject.existsSync()).thenReturn(true);
         when(featureFlags.isLinuxEnabled).thenReturn(true);
@@ -1048,6 +1080,7 @@ flutter:
         expect(properties.existsSync(), isTrue);
         expect(properties.readAsStringSync(), contains('apackage_plugin.lib'));
         expect(properties.readAsStringSync(), contains('>$includePath;'));
+        expect(properties.readAsStringSync(), contains('<DelayLoadDLLs>apackage_plugin.dll;'));
       }, overrides: <Type, Generator>{
         FileSystem: () => fs,
         ProcessManager: () => FakeProcessManager.any(),
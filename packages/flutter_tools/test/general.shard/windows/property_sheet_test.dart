@@ -45,5 +45,15 @@ void main() {
       final String propsContent = sheet.toString();
       expect(propsContent, contains('<AdditionalDependencies>foo.lib;bar.lib;%(AdditionalDependencies)</AdditionalDependencies>'));
     });
+
+    test('Delay load libraries generate the correct elements', () async {
+      const PropertySheet sheet = PropertySheet(
+        libraryDependencies: <String>['foo.lib'],
+        delayLoadLibraries: <String>['foo.dll'],
+      );
+      final String propsContent = sheet.toString();
+      expect(propsContent, contains('<AdditionalDependencies>foo.lib;delayimp.lib;%(AdditionalDependencies)</AdditionalDependencies>'));
+      expect(propsContent, contains('<DelayLoadDLLs>foo.dll;%(DelayLoadDLLs)</DelayLoadDLLs>'));
+    });
   });
 }